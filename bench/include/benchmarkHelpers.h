@@ -0,0 +1,11 @@
+#pragma once
+#include "structures.h"
+
+// number of train instances (train_0.json ... train_9.json)
+constexpr int NUMBER_OF_BENCHMARK_INSTANCES = 10;
+
+// Returns the train instance with the given index, every instance is only loaded once per process
+auto getBenchmarkInstance(int instanceIndex) -> ProblemInstance &;
+
+// Creates an evaluated random population for the given instance
+auto createBenchmarkPopulation(const ProblemInstance &problemInstance, int populationSize) -> Population;
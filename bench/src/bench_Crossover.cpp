@@ -0,0 +1,25 @@
+#include <benchmark/benchmark.h>
+#include "benchmarkHelpers.h"
+#include "crossover.h"
+
+namespace {
+template <CrossoverFunction crossoverFunction>
+void BM_crossover(benchmark::State &state)
+{
+    const ProblemInstance &instance = getBenchmarkInstance(state.range(0));
+    Population population = createBenchmarkPopulation(instance, 64);
+    std::size_t index = 0;
+    for (auto _ : state)
+    {
+        const Genome &parent1 = population[index].genome;
+        const Genome &parent2 = population[(index + 1) % population.size()].genome;
+        std::pair<Genome, std::optional<Genome>> children = crossoverFunction(parent1, parent2);
+        benchmark::DoNotOptimize(children);
+        index = (index + 1) % population.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_crossover, order1Crossover)->ArgName("instance")->DenseRange(0, NUMBER_OF_BENCHMARK_INSTANCES - 1);
+BENCHMARK_TEMPLATE(BM_crossover, partiallyMappedCrossover)->ArgName("instance")->DenseRange(0, NUMBER_OF_BENCHMARK_INSTANCES - 1);
+BENCHMARK_TEMPLATE(BM_crossover, edgeRecombination)->ArgName("instance")->DenseRange(0, NUMBER_OF_BENCHMARK_INSTANCES - 1);
+} // namespace
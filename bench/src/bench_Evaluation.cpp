@@ -0,0 +1,117 @@
+#include <benchmark/benchmark.h>
+#include "benchmarkHelpers.h"
+#include "fitnessCache.h"
+#include "SGA.h"
+#include "utils.h"
+
+namespace {
+void BM_evaluateIndividual(benchmark::State &state)
+{
+    const ProblemInstance &instance = getBenchmarkInstance(state.range(0));
+    Population population = createBenchmarkPopulation(instance, 64);
+    std::size_t index = 0;
+    for (auto _ : state)
+    {
+        evaluateIndividual(&population[index], instance);
+        benchmark::DoNotOptimize(population[index].fitness);
+        index = (index + 1) % population.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_evaluateIndividual)->ArgName("instance")->DenseRange(0, NUMBER_OF_BENCHMARK_INSTANCES - 1);
+
+// evaluateIndividual on genomes that are all in the fitness cache, compare with BM_evaluateIndividual to see what a hit
+// saves: the genome is hashed on every lookup
+void BM_evaluateIndividualCached(benchmark::State &state)
+{
+    const ProblemInstance &instance = getBenchmarkInstance(state.range(0));
+    Population population = createBenchmarkPopulation(instance, 64);
+    FitnessCache &cache = FitnessCache::getInstance();
+    cache.configure(true, 1024, instance.instanceName);
+    evaluatePopulation(population, instance);
+    std::size_t index = 0;
+    for (auto _ : state)
+    {
+        evaluateIndividual(&population[index], instance);
+        benchmark::DoNotOptimize(population[index].fitness);
+        index = (index + 1) % population.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["hitRate"] = cache.hitRate();
+    cache.configure(false, 1024, instance.instanceName);
+}
+BENCHMARK(BM_evaluateIndividualCached)->ArgName("instance")->DenseRange(0, NUMBER_OF_BENCHMARK_INSTANCES - 1);
+
+void BM_evaluatePopulation(benchmark::State &state)
+{
+    const ProblemInstance &instance = getBenchmarkInstance(state.range(0));
+    Population population = createBenchmarkPopulation(instance, state.range(1));
+    for (auto _ : state)
+    {
+        evaluatePopulation(population, instance);
+        benchmark::DoNotOptimize(population.front().fitness);
+    }
+    state.SetItemsProcessed(state.iterations() * population.size());
+    state.SetLabel(isAvx2EvaluationAvailable() ? "avx2" : "scalar");
+}
+BENCHMARK(BM_evaluatePopulation)->ArgNames({"instance", "populationSize"})->ArgsProduct({{0, 1}, {100, 1000}});
+
+// evaluatePopulation with the fitness cache when the given percentage of the population are copies of cached genomes,
+// the rest is new, as in a converged run where selection and elitism copy individuals
+void BM_evaluatePopulationCached(benchmark::State &state)
+{
+    const ProblemInstance &instance = getBenchmarkInstance(state.range(0));
+    const Population cached = createBenchmarkPopulation(instance, 1000);
+    const Population fresh = createBenchmarkPopulation(instance, 1000);
+    FitnessCache &cache = FitnessCache::getInstance();
+    // declared outside the loop so that the copies of the last iteration are freed while the timing is paused
+    Population seen;
+    Population population;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        cache.configure(true, 1 << 16, instance.instanceName);
+        seen = cached;
+        evaluatePopulation(seen, instance);
+        population.clear();
+        for (std::size_t index = 0; index < cached.size(); index++)
+        {
+            population.push_back(static_cast<int>(index % 100) < state.range(1) ? cached[index] : fresh[index]);
+        }
+        state.ResumeTiming();
+        evaluatePopulation(population, instance);
+        benchmark::DoNotOptimize(population.front().fitness);
+    }
+    state.SetItemsProcessed(state.iterations() * cached.size());
+    cache.configure(false, 1 << 16, instance.instanceName);
+}
+BENCHMARK(BM_evaluatePopulationCached)->ArgNames({"instance", "cachedPercentage"})->ArgsProduct({{0, 1}, {0, 50, 90}});
+
+void BM_isSolutionValid(benchmark::State &state)
+{
+    const ProblemInstance &instance = getBenchmarkInstance(state.range(0));
+    Population population = createBenchmarkPopulation(instance, 64);
+    std::size_t index = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(isSolutionValid(population[index].genome, instance));
+        index = (index + 1) % population.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_isSolutionValid)->ArgName("instance")->DenseRange(0, NUMBER_OF_BENCHMARK_INSTANCES - 1);
+
+void BM_getTotalTravelTime(benchmark::State &state)
+{
+    const ProblemInstance &instance = getBenchmarkInstance(state.range(0));
+    Population population = createBenchmarkPopulation(instance, 64);
+    std::size_t index = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(getTotalTravelTime(population[index].genome, instance));
+        index = (index + 1) % population.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_getTotalTravelTime)->ArgName("instance")->DenseRange(0, NUMBER_OF_BENCHMARK_INSTANCES - 1);
+} // namespace
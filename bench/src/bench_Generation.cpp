@@ -0,0 +1,99 @@
+#include <benchmark/benchmark.h>
+#include "benchmarkHelpers.h"
+#include "SGA.h"
+#include "parentSelection.h"
+#include "crossover.h"
+#include "mutation.h"
+#include "survivorSelection.h"
+#include "construction.h"
+#include "evaluation.h"
+#include <algorithm>
+#include <numeric>
+
+namespace {
+// One full generation (selection, crossover, mutation, survivor selection) with the configuration used in main.cpp
+void BM_generation(benchmark::State &state)
+{
+    ProblemInstance &instance = getBenchmarkInstance(state.range(0));
+    const int populationSize = state.range(1);
+
+    FunctionParameters emptyParams;
+    FunctionParameters tournamentSelectionParams = {{"tournamentSize", 5}, {"tournamentProbability", 0.8}};
+    FunctionParameters insertionHeuristicParams = {{"problem_instance", instance}};
+    FunctionParameters elitismWithFillParams = {{"elitism_percentage", 0.1}, {"fillFunction", "rouletteWheel"}};
+    MuationConfiguration mutation = {{reassignOnePatient, emptyParams, 0.01},
+                                     {insertWithinJourney, emptyParams, 0.01},
+                                     {swapBetweenJourneys, emptyParams, 0.01},
+                                     {swapWithinJourney, emptyParams, 0.01},
+                                     {insertionHeuristic, insertionHeuristicParams, 0.85}};
+    Config config = Config(populationSize, 1, false,
+                           {tournamentSelection, tournamentSelectionParams},
+                           {{partiallyMappedCrossover, 0.2}, {edgeRecombination, 0.2}},
+                           mutation,
+                           {elitismWithFill, elitismWithFillParams});
+
+    Population population = createBenchmarkPopulation(instance, populationSize);
+    for (auto _ : state)
+    {
+        population = evolveGeneration(population, config, instance);
+        benchmark::DoNotOptimize(population);
+    }
+    state.SetItemsProcessed(state.iterations() * populationSize);
+}
+BENCHMARK(BM_generation)
+    ->ArgNames({"instance", "populationSize"})
+    ->ArgsProduct({benchmark::CreateDenseRange(0, NUMBER_OF_BENCHMARK_INSTANCES - 1, 1), {100, 500, 1000}})
+    ->Unit(benchmark::kMillisecond);
+
+// Feasible initialization of a whole population on one or more threads
+void BM_initializeFeasiblePopulation(benchmark::State &state)
+{
+    ProblemInstance &instance = getBenchmarkInstance(state.range(0));
+    const int populationSize = state.range(1);
+    FunctionParameters emptyParams;
+    Config config = Config(populationSize, 0, false, {nullptr, emptyParams}, {}, {}, {nullptr, emptyParams});
+    config.numberOfThreads = state.range(2);
+    int validIndividuals = 0;
+    for (auto _ : state)
+    {
+        Population population = initializeFeasiblePopulation(instance, config);
+        validIndividuals = std::count_if(population.begin(), population.end(), [](const Individual &individual)
+                                         { return individual.valid; });
+        benchmark::DoNotOptimize(population);
+    }
+    state.SetItemsProcessed(state.iterations() * populationSize);
+    state.counters["valid"] = validIndividuals;
+}
+BENCHMARK(BM_initializeFeasiblePopulation)
+    ->ArgNames({"instance", "populationSize", "threads"})
+    ->ArgsProduct({benchmark::CreateDenseRange(0, NUMBER_OF_BENCHMARK_INSTANCES - 1, 1), {100, 1000}, {1, 4}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// 20 individuals built by one seeding heuristic (0 = end time, 1 = savings, 2 = Solomon I1, 3 = sweep)
+void BM_seedingHeuristic(benchmark::State &state)
+{
+    ProblemInstance &instance = getBenchmarkInstance(state.range(0));
+    const auto heuristic = static_cast<SeedingHeuristic>(state.range(1));
+    std::vector<std::uint64_t> seeds(20);
+    std::iota(seeds.begin(), seeds.end(), 1);
+    const std::vector<SeedingHeuristic> heuristics(seeds.size(), heuristic);
+    Population population;
+    for (auto _ : state)
+    {
+        population = constructPopulation(instance, seeds, heuristics, 1, 10);
+        benchmark::DoNotOptimize(population);
+    }
+    evaluatePopulation(population, instance);
+    state.SetItemsProcessed(state.iterations() * seeds.size());
+    state.counters["valid"] = std::count_if(population.begin(), population.end(), [](const Individual &individual)
+                                            { return individual.valid; });
+    state.counters["bestTravelTime"] = std::min_element(population.begin(), population.end(), [](const Individual &a, const Individual &b)
+                                                        { return a.travelTime < b.travelTime; })
+                                           ->travelTime;
+}
+BENCHMARK(BM_seedingHeuristic)
+    ->ArgNames({"instance", "heuristic"})
+    ->ArgsProduct({benchmark::CreateDenseRange(0, NUMBER_OF_BENCHMARK_INSTANCES - 1, 1), {0, 1, 2, 3}})
+    ->Unit(benchmark::kMillisecond);
+} // namespace
@@ -0,0 +1,48 @@
+#include <benchmark/benchmark.h>
+#include "benchmarkHelpers.h"
+#include "mutation.h"
+
+namespace {
+// Applies the mutation repeatedly to the same genome. The operators keep the genome a permutation of
+// all patients, so the genome performs a random walk instead of being copied back before every call.
+template <MutationFunction mutationFunction>
+void BM_mutation(benchmark::State &state)
+{
+    ProblemInstance &instance = getBenchmarkInstance(state.range(0));
+    FunctionParameters parameters = {{"problem_instance", instance}};
+    Genome genome = createBenchmarkPopulation(instance, 1)[0].genome;
+    for (auto _ : state)
+    {
+        genome = mutationFunction(genome, parameters);
+        benchmark::DoNotOptimize(genome);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_mutation, reassignOnePatient)->ArgName("instance")->DenseRange(0, NUMBER_OF_BENCHMARK_INSTANCES - 1);
+BENCHMARK_TEMPLATE(BM_mutation, swapWithinJourney)->ArgName("instance")->DenseRange(0, NUMBER_OF_BENCHMARK_INSTANCES - 1);
+BENCHMARK_TEMPLATE(BM_mutation, swapBetweenJourneys)->ArgName("instance")->DenseRange(0, NUMBER_OF_BENCHMARK_INSTANCES - 1);
+BENCHMARK_TEMPLATE(BM_mutation, insertWithinJourney)->ArgName("instance")->DenseRange(0, NUMBER_OF_BENCHMARK_INSTANCES - 1);
+BENCHMARK_TEMPLATE(BM_mutation, twoOpt)->ArgName("instance")->DenseRange(0, NUMBER_OF_BENCHMARK_INSTANCES - 1);
+BENCHMARK_TEMPLATE(BM_mutation, inverseJourney)->ArgName("instance")->DenseRange(0, NUMBER_OF_BENCHMARK_INSTANCES - 1);
+BENCHMARK_TEMPLATE(BM_mutation, splitJourney)->ArgName("instance")->DenseRange(0, NUMBER_OF_BENCHMARK_INSTANCES - 1);
+BENCHMARK_TEMPLATE(BM_mutation, insertionHeuristic)->ArgName("instance")->DenseRange(0, NUMBER_OF_BENCHMARK_INSTANCES - 1);
+BENCHMARK_TEMPLATE(BM_mutation, ruinAndRecreate)->ArgName("instance")->DenseRange(0, NUMBER_OF_BENCHMARK_INSTANCES - 1);
+
+// Local search would only rescan a local optimum after the first call, so it starts from the same random genome every time
+template <MutationFunction localSearchFunction>
+void BM_localSearch(benchmark::State &state)
+{
+    ProblemInstance &instance = getBenchmarkInstance(state.range(0));
+    FunctionParameters parameters = {{"problem_instance", instance}};
+    const Genome start = createBenchmarkPopulation(instance, 1)[0].genome;
+    for (auto _ : state)
+    {
+        Genome genome = start;
+        genome = localSearchFunction(genome, parameters);
+        benchmark::DoNotOptimize(genome);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_localSearch, interRouteLocalSearch)->ArgName("instance")->DenseRange(0, NUMBER_OF_BENCHMARK_INSTANCES - 1)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_localSearch, orOpt)->ArgName("instance")->DenseRange(0, NUMBER_OF_BENCHMARK_INSTANCES - 1)->Unit(benchmark::kMillisecond);
+} // namespace
@@ -0,0 +1,41 @@
+#include <benchmark/benchmark.h>
+#include "benchmarkHelpers.h"
+#include "parentSelection.h"
+#include "survivorSelection.h"
+
+namespace {
+template <ParentSelectionFunction selectionFunction>
+void BM_parentSelection(benchmark::State &state)
+{
+    const int populationSize = state.range(0);
+    Population population = createBenchmarkPopulation(getBenchmarkInstance(0), populationSize);
+    FunctionParameters parameters = {{"tournamentSize", 5}, {"tournamentProbability", 0.8}};
+    for (auto _ : state)
+    {
+        Population parents = selectionFunction(population, parameters, populationSize);
+        benchmark::DoNotOptimize(parents);
+    }
+    state.SetItemsProcessed(state.iterations() * populationSize);
+}
+BENCHMARK_TEMPLATE(BM_parentSelection, tournamentSelection)->ArgName("populationSize")->RangeMultiplier(2)->Range(100, 1600);
+BENCHMARK_TEMPLATE(BM_parentSelection, rouletteWheelSelection)->ArgName("populationSize")->RangeMultiplier(2)->Range(100, 1600);
+
+template <SurvivorSelectionFunction selectionFunction>
+void BM_survivorSelection(benchmark::State &state)
+{
+    const int populationSize = state.range(0);
+    Population parents = createBenchmarkPopulation(getBenchmarkInstance(0), populationSize);
+    Population children = createBenchmarkPopulation(getBenchmarkInstance(0), populationSize);
+    FunctionParameters parameters = {{"elitism_percentage", 0.1}, {"fillFunction", "rouletteWheel"}};
+    for (auto _ : state)
+    {
+        Population survivors = selectionFunction(parents, children, parameters, populationSize);
+        benchmark::DoNotOptimize(survivors);
+    }
+    state.SetItemsProcessed(state.iterations() * populationSize);
+}
+BENCHMARK_TEMPLATE(BM_survivorSelection, fullReplacement)->ArgName("populationSize")->RangeMultiplier(2)->Range(100, 1600);
+BENCHMARK_TEMPLATE(BM_survivorSelection, rouletteWheelReplacement)->ArgName("populationSize")->RangeMultiplier(2)->Range(100, 1600);
+BENCHMARK_TEMPLATE(BM_survivorSelection, elitismWithFill)->ArgName("populationSize")->RangeMultiplier(2)->Range(100, 1600);
+BENCHMARK_TEMPLATE(BM_survivorSelection, biasedFitnessReplacement)->ArgName("populationSize")->RangeMultiplier(2)->Range(100, 1600)->Unit(benchmark::kMillisecond);
+} // namespace
@@ -0,0 +1,29 @@
+#include "benchmarkHelpers.h"
+#include <map>
+#include <memory>
+#include <string>
+#include "SGA.h"
+#include "utils.h"
+
+auto getBenchmarkInstance(int instanceIndex) -> ProblemInstance &
+{
+    static std::map<int, std::unique_ptr<ProblemInstance>> instances;
+    auto iterator = instances.find(instanceIndex);
+    if (iterator == instances.end())
+    {
+        auto instance = std::make_unique<ProblemInstance>(loadInstance("train_" + std::to_string(instanceIndex) + ".json"));
+        iterator = instances.emplace(instanceIndex, std::move(instance)).first;
+    }
+    return *iterator->second;
+}
+
+auto createBenchmarkPopulation(const ProblemInstance &problemInstance, int populationSize) -> Population
+{
+    FunctionParameters emptyParams;
+    Config config = Config(populationSize, 0, false,
+                           {nullptr, emptyParams},
+                           {},
+                           {},
+                           {nullptr, emptyParams});
+    return initializeRandomPopulation(problemInstance, config);
+}
@@ -0,0 +1,23 @@
+#include <benchmark/benchmark.h>
+#include <spdlog/spdlog.h>
+#include "RandomGenerator.h"
+#include "utils.h"
+
+auto main(int argc, char **argv) -> int
+{
+    initLogger();
+    // measure the operators and not the trace logging of non production builds
+    mainLogger().set_level(spdlog::level::info);
+    statisticsLogger().set_level(spdlog::level::info);
+    RandomGenerator::getInstance().setSeed(4711);
+
+    ::benchmark::Initialize(&argc, argv);
+    if (::benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+    ::benchmark::RunSpecifiedBenchmarks();
+    ::benchmark::Shutdown();
+    shutdownLogger();
+    return 0;
+}
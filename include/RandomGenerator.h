@@ -1,5 +1,7 @@
 #pragma once
+#include <memory>
 #include <random>
+#include <string>
 #include <vector>
 #include <algorithm>
 
@@ -8,8 +10,10 @@ class RandomGenerator
 private:
     std::mt19937_64 generator; // Mersenne Twister 64-bit engine
     bool isSeeded{false};
-    // Static instance variable
-    static RandomGenerator* instance;
+    // Every thread has its own instance, so runs on different threads neither share nor race on the engine
+    static thread_local RandomGenerator* instance;
+    // the generator created by getInstance for this thread
+    static thread_local std::unique_ptr<RandomGenerator> ownedInstance;
 
 protected:
     RandomGenerator();
@@ -24,6 +28,11 @@ public:
     virtual auto generateRandomDouble(double min, double max) -> double;
 
     virtual void shuffle(std::vector<int> &elements); 
+
+    // the full engine state as text, restoring it with setState continues the exact same sequence of numbers
+    auto getState() const -> std::string;
+
+    void setState(const std::string &state);
     
     #ifdef TESTING_MODE
     static void setInstance(RandomGenerator *instance);
@@ -1,11 +1,15 @@
 #pragma once
 #include "structures.h"
+#include "evaluation.h"
+#include "operatorSelection.h"
 
 
-auto evaluateIndividual(Individual *individual, const ProblemInstance &problemInstance) -> void;
 auto initializeRandomPopulation(const ProblemInstance &problemInstance, const Config &config) -> Population;
 auto initializeFeasiblePopulation(const ProblemInstance &problemInstance, const Config &config) -> Population;
 auto getTotalTravelTime(const Genome &genome, const ProblemInstance &problemInstance) -> double;
-auto applyCrossover(Population &parents, CrossoverConfiguration &crossover, ProblemInstance &problemInstance) -> Population;
-auto applyMutation(Population &population, MuationConfiguration &mutation, ProblemInstance &problemInstance) -> Population;
+// With a selection the operators are drawn from its probabilities and credited with the fitness their children gained
+auto applyCrossover(Population &parents, CrossoverConfiguration &crossover, ProblemInstance &problemInstance, AdaptiveOperatorSelection *selection = nullptr) -> Population;
+auto applyMutation(Population &population, MuationConfiguration &mutation, ProblemInstance &problemInstance, AdaptiveOperatorSelection *selection = nullptr) -> Population;
+// Without selections every operator is applied at its fixed rate, given selections end their generation after the mutations
+auto evolveGeneration(const Population &pop, Config &config, ProblemInstance &problemInstance, AdaptiveOperatorSelection *crossoverSelection = nullptr, AdaptiveOperatorSelection *mutationSelection = nullptr) -> Population;
 auto SGA(ProblemInstance problemInstance, Config config) -> Individual;
@@ -0,0 +1,74 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "spscQueue.h"
+#include "steadyState.h"
+#include "structures.h"
+
+// Steady-state evolution without generation barriers: worker threads breed and evaluate children of parent pairs while
+// the thread that owns the population (the integrator) only selects parents and inserts the children. Every worker has
+// its own lock-free task and result queue, so slow operators on one worker never hold up the others. The order in which
+// children arrive depends on the scheduling, so runs are not reproducible from the seed. With crowding a child competes
+// with the copy of its parent the task carried and is dropped if the parent's slot was replaced in the meantime.
+class AsynchronousEvolution
+{
+private:
+    struct Task
+    {
+        Individual parent1;
+        Individual parent2;
+        // population indices of the parents and the versions of their slots when the task was created
+        std::size_t index1 = 0;
+        std::size_t index2 = 0;
+        std::uint64_t version1 = 0;
+        std::uint64_t version2 = 0;
+    };
+
+    struct Result
+    {
+        // the task with its parents, the parents of the offspring are 0 and 1 for the parents of the task
+        Task task;
+        Offspring offspring;
+    };
+
+    struct Worker
+    {
+        SpscQueue<Task> tasks;
+        SpscQueue<Result> results;
+        // tasks handed to the worker whose results were not integrated yet, only used by the integrator
+        int inFlight = 0;
+        std::thread thread;
+        // an exception of an operator stops the worker and is rethrown by the integrator
+        std::exception_ptr error;
+        std::atomic<bool> failed{false};
+
+        explicit Worker(std::size_t queueCapacity) : tasks(queueCapacity), results(queueCapacity) {}
+    };
+
+    Config &config;
+    const ProblemInstance &problemInstance;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<bool> stopping{false};
+    // raised whenever crowding replaces the individual of a slot, only used by the integrator
+    std::vector<std::uint64_t> slotVersions;
+
+    void runWorker(Worker &worker, unsigned int seed);
+    // inserts the children of a result into the population with the steady-state replacement
+    void integrate(Population &population, Result &result);
+
+public:
+    // Starts numberOfWorkers workers, their random generators are seeded from the RandomGenerator of the calling thread
+    AsynchronousEvolution(Config &config, const ProblemInstance &problemInstance, int numberOfWorkers);
+    // Stops the workers, children that were not integrated are discarded
+    ~AsynchronousEvolution();
+    AsynchronousEvolution(const AsynchronousEvolution &) = delete;
+    auto operator=(const AsynchronousEvolution &) -> AsynchronousEvolution & = delete;
+
+    // Function to integrate the children of populationSize / 2 parent pairs into the population with the steady-state
+    // replacement. Must always be called from the thread that created the object.
+    void evolveGeneration(Population &population);
+};
@@ -0,0 +1,122 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// Fixed size key value cache for 64 bit hash keys that can be shared between threads.
+// The keys are spread over independently locked shards, every shard evicts its oldest entry once it is full.
+template <typename Value, std::size_t NumberOfShards = 16>
+class BoundedCache
+{
+private:
+    struct Shard
+    {
+        std::mutex mutex;
+        std::unordered_map<std::uint64_t, Value> entries;
+        // keys in insertion order, used as a ring buffer for the eviction
+        std::vector<std::uint64_t> insertionOrder;
+        std::size_t nextEviction = 0;
+    };
+
+    std::array<Shard, NumberOfShards> shards;
+    std::size_t shardCapacity = 1;
+    std::atomic<std::uint64_t> hitCount{0};
+    std::atomic<std::uint64_t> missCount{0};
+
+    auto shardFor(std::uint64_t key) -> Shard & { return shards[(key >> 48) % NumberOfShards]; }
+
+public:
+    explicit BoundedCache(std::size_t capacity = 65536) { setCapacity(capacity); }
+
+    // change the number of entries the cache can hold, this clears the cache
+    void setCapacity(std::size_t capacity)
+    {
+        shardCapacity = std::max<std::size_t>(1, capacity / NumberOfShards);
+        clear();
+    }
+
+    auto capacity() const -> std::size_t { return shardCapacity * NumberOfShards; }
+
+    // copies the value stored for key into value, returns false if the key is not cached
+    auto find(std::uint64_t key, Value &value) -> bool
+    {
+        return findMatching(key, value, [](const Value &) { return true; });
+    }
+
+    // like find, but an entry for which matches returns false (e.g. one whose check hash differs) counts as a miss
+    template <typename Predicate>
+    auto findMatching(std::uint64_t key, Value &value, Predicate matches) -> bool
+    {
+        Shard &shard = shardFor(key);
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto entry = shard.entries.find(key);
+            if (entry != shard.entries.end() && matches(entry->second))
+            {
+                value = entry->second;
+                hitCount.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        missCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    void insert(std::uint64_t key, const Value &value)
+    {
+        Shard &shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto [entry, inserted] = shard.entries.try_emplace(key, value);
+        if (!inserted)
+        {
+            entry->second = value;
+            return;
+        }
+        if (shard.insertionOrder.size() < shardCapacity)
+        {
+            shard.insertionOrder.push_back(key);
+            return;
+        }
+        shard.entries.erase(shard.insertionOrder[shard.nextEviction]);
+        shard.insertionOrder[shard.nextEviction] = key;
+        shard.nextEviction = (shard.nextEviction + 1) % shardCapacity;
+    }
+
+    // remove all entries and reset the counters
+    void clear()
+    {
+        for (Shard &shard : shards)
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.entries.clear();
+            shard.insertionOrder.clear();
+            shard.insertionOrder.reserve(shardCapacity);
+            shard.nextEviction = 0;
+        }
+        hitCount = 0;
+        missCount = 0;
+    }
+
+    auto size() -> std::size_t
+    {
+        std::size_t entries = 0;
+        for (Shard &shard : shards)
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            entries += shard.entries.size();
+        }
+        return entries;
+    }
+
+    auto hits() const -> std::uint64_t { return hitCount.load(std::memory_order_relaxed); }
+    auto misses() const -> std::uint64_t { return missCount.load(std::memory_order_relaxed); }
+    auto hitRate() const -> double
+    {
+        const std::uint64_t lookups = hits() + misses();
+        return lookups == 0 ? 0.0 : static_cast<double>(hits()) / lookups;
+    }
+};
@@ -0,0 +1,29 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "structures.h"
+#include "statistics.h"
+
+// Everything needed to continue a run exactly where it stopped
+struct Checkpoint
+{
+    std::string instanceName;
+    // the next generation to run
+    int generation = 0;
+    // state of the RandomGenerator, see RandomGenerator::getState
+    std::string randomState;
+    Population population;
+    // statistics of every generation run so far
+    std::vector<GenerationStatistics> statistics;
+    // qualities of the adaptive operator selection, empty if the run does not adapt the operators
+    std::vector<double> crossoverQualities;
+    std::vector<double> mutationQualities;
+};
+
+// Function to write a checkpoint in a binary format. The file is written next to the path first and then renamed, so
+// an interrupted write never destroys the previous checkpoint. Throws std::runtime_error if the file can not be written.
+auto writeCheckpoint(const Checkpoint &checkpoint, const std::string &path) -> void;
+
+// Function to read a checkpoint written by writeCheckpoint. Throws std::runtime_error if the file can not be read, is
+// truncated, holds a count its size can not back or was written by a build with a different format.
+auto readCheckpoint(const std::string &path) -> Checkpoint;
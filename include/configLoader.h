@@ -0,0 +1,89 @@
+#pragma once
+#include <deque>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "nlohmann/json.hpp"
+#include "structures.h"
+
+enum class ParameterType
+{
+    Int,
+    Double,
+    String,
+    Bool
+};
+
+// Type and allowed values of a configuration value
+struct ParameterRule
+{
+    ParameterType type = ParameterType::Int;
+    // numbers must lie in [minimum, maximum], or in (minimum, maximum] if the minimum is excluded
+    double minimum = -std::numeric_limits<double>::infinity();
+    double maximum = std::numeric_limits<double>::infinity();
+    bool minimumExcluded = false;
+    // strings must be one of these values, any string is allowed if it is empty
+    std::vector<std::string> allowedValues = {};
+};
+
+// An operator that can be named in the configuration file
+template <typename Function>
+struct RegisteredOperator
+{
+    Function function = nullptr;
+    // parameters the operator reads and the values they may take
+    std::map<std::string, ParameterRule> parameters = {};
+    // parameters that have no default in the operator
+    std::vector<std::string> required = {};
+    // the operator reads the instance from the parameter "problem_instance", the loader adds it
+    bool needsProblemInstance = false;
+};
+
+// Functions to get the operators by the name used in the configuration file
+auto parentSelectionRegistry() -> const std::map<std::string, RegisteredOperator<ParentSelectionFunction>> &;
+auto crossoverRegistry() -> const std::map<std::string, RegisteredOperator<CrossoverFunction>> &;
+auto mutationRegistry() -> const std::map<std::string, RegisteredOperator<MutationFunction>> &;
+auto survivorSelectionRegistry() -> const std::map<std::string, RegisteredOperator<SurvivorSelectionFunction>> &;
+
+// Everything needed to start a run. Config refers to the function parameters stored here, so a RunConfiguration can be
+// moved but not copied.
+struct RunConfiguration
+{
+    std::string instanceFile;
+    unsigned int seed = 0;
+    std::unique_ptr<ProblemInstance> problemInstance;
+    std::deque<FunctionParameters> functionParameters;
+    std::unique_ptr<Config> config;
+};
+
+using InstanceLoader = std::function<ProblemInstance(const std::string &instanceFile, int numberOfNeighbours)>;
+
+// Function to read a json configuration file, throws std::runtime_error if it can not be opened or parsed
+auto readConfigurationFile(const std::string &path) -> nlohmann::json;
+
+// Function to validate a json configuration and build the run from it. Unknown keys, unknown operator names, unknown
+// parameters, parameters of the wrong type, values out of range or not among the allowed values and missing required
+// parameters are rejected with std::invalid_argument.
+auto loadRunConfiguration(const nlohmann::json &configuration, const InstanceLoader &instanceLoader) -> RunConfiguration;
+
+// Function to validate and build a run, the instance is read with loadInstance
+auto loadRunConfiguration(const nlohmann::json &configuration) -> RunConfiguration;
+
+struct CommandLineOptions
+{
+    std::string configurationPath = "./../config.json";
+    // keys of the configuration set on the command line, they replace the values of the file
+    nlohmann::json overrides = nlohmann::json::object();
+    // tuning settings to race configurations with instead of running one, see tuner.h
+    std::string tuningPath;
+};
+
+// Function to parse --config <path>, --instance <file>, --seed <n>, --threads <n>, --population <n>,
+// --generations <n>, --checkpoint-interval <n>, --resume and --tune <path>. Throws std::invalid_argument on anything else.
+auto parseCommandLine(const std::vector<std::string> &arguments) -> CommandLineOptions;
+
+// Usage text of the command line options
+auto commandLineUsage() -> std::string;
@@ -0,0 +1,58 @@
+#pragma once
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "structures.h"
+
+// Constructive heuristics used to seed the initial population
+enum class SeedingHeuristic
+{
+    // greedy appending in order of the end of the time windows, see constructGenome
+    EndTime,
+    Savings,
+    SolomonI1,
+    Sweep
+};
+
+// Patients grouped by the end of their time window, groups in ascending order of the end time
+using EndTimeGroups = std::vector<std::vector<int>>;
+
+// Function to group the patients of an instance by the end of their time window
+auto groupPatientsByEndTime(const ProblemInstance &problemInstance) -> EndTimeGroups;
+
+// Function to build one genome: the groups are visited in order, the patients of a group in random order, and every
+// patient is appended to the journey where it causes the smallest detour while keeping the journey feasible. Each append
+// is checked in O(1) from the last patient, departure time and load of the journey. Up to maxAttempts orders are tried,
+// if none places every patient the unplaced patients of the best attempt are repaired with regret insertion.
+auto constructGenome(const ProblemInstance &problemInstance, const EndTimeGroups &groups, std::mt19937_64 &engine, int maxAttempts) -> Genome;
+
+// Function to build one genome with the Clarke-Wright savings heuristic: every patient starts in its own journey and
+// journeys are joined end to start in order of decreasing savings d(i, 0) + d(0, j) - lambda * d(i, j) as long as the
+// joined journey stays feasible. lambda and a small noise on the savings are drawn from the engine. If more journeys
+// than nurses are left the patients of the shortest ones are repaired with regret insertion.
+auto savingsGenome(const ProblemInstance &problemInstance, std::mt19937_64 &engine) -> Genome;
+
+// Function to build one genome with Solomon's I1 insertion heuristic: journeys are built one after the other, each is
+// opened with the unrouted patient farthest from the depot or with the earliest end time and then grows by the
+// patient with the largest lambda * d(0, u) - c1, where c1 weighs the detour against the delay of the successor.
+// The weights and the seed criterion are drawn from the engine. Patients left when the nurses run out are repaired
+// with regret insertion.
+auto solomonI1Genome(const ProblemInstance &problemInstance, std::mt19937_64 &engine) -> Genome;
+
+// Function to build one genome with the sweep heuristic: patients are visited by polar angle around the depot from a
+// random start angle in a random direction and inserted at the cheapest feasible place of the current journey. A new
+// journey is opened when the capacity is exhausted, patients that miss their time window in the current journey are
+// repaired with regret insertion at the end.
+auto sweepGenome(const ProblemInstance &problemInstance, std::mt19937_64 &engine) -> Genome;
+
+// Function to decide which heuristic builds each individual of a population, the shares are rounded down and the
+// rest of the population uses SeedingHeuristic::EndTime. Throws std::invalid_argument if a share is negative or
+// the shares sum to more than 1.
+auto assignSeedingHeuristics(int populationSize, const SeedingProportions &proportions) -> std::vector<SeedingHeuristic>;
+
+// Function to build one genome per seed on up to numberOfThreads threads. Every genome uses its own engine seeded with
+// its seed, so the result does not depend on the number of threads.
+auto constructPopulation(const ProblemInstance &problemInstance, const std::vector<std::uint64_t> &seeds, int numberOfThreads, int maxAttempts) -> Population;
+
+// Function to build one genome per seed like above, genome i is built by heuristics[i]
+auto constructPopulation(const ProblemInstance &problemInstance, const std::vector<std::uint64_t> &seeds, const std::vector<SeedingHeuristic> &heuristics, int numberOfThreads, int maxAttempts) -> Population;
@@ -0,0 +1,35 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "structures.h"
+
+// Successor and predecessor of every patient of a genome, the depot is location 0 and ids that are not visited hold -1
+struct GenomeAdjacency
+{
+    std::vector<int> successor;
+    std::vector<int> predecessor;
+    int numberOfPatients = 0;
+};
+
+// Function to build the successor and predecessor arrays of a genome in O(n), numberOfLocations must exceed every id
+auto buildAdjacency(const Genome &genome, int numberOfLocations) -> GenomeAdjacency;
+
+// Function to compute the broken pairs distance in O(n): the share of patients of a whose successor in a is neither
+// their successor nor their predecessor in b, plus the journeys of a that start at a patient that lies inside a
+// journey of b. The direction of an edge and the nurse driving it are ignored. 0 means both genomes describe the same
+// set of journeys.
+auto brokenPairsDistance(const GenomeAdjacency &a, const GenomeAdjacency &b) -> double;
+
+// Function to compute the broken pairs distance of two genomes, builds both adjacencies first
+auto brokenPairsDistance(const Genome &a, const Genome &b) -> double;
+
+// Function to hash a genome independently of the order of its journeys, genomes that only differ in which nurse drives
+// which journey hash equally
+auto canonicalGenomeHash(const Genome &genome) -> std::uint64_t;
+
+// Function to remove every individual whose genome equals, up to the order of its journeys, the genome of an earlier
+// individual. The order of the remaining individuals is kept. Returns the removed individuals.
+auto removeDuplicates(Population &population) -> Population;
+
+// Function to compute the mean broken pairs distance of all individuals to the individual at the given index
+auto averageDistanceTo(const Population &population, std::size_t index) -> double;
@@ -0,0 +1,40 @@
+#pragma once
+#include "structures.h"
+
+// Everything evaluateIndividual needs to know about one journey, computed in a single walk over it
+struct JourneyEvaluation
+{
+    // driving time including the way back to the depot
+    double travelTime = 0.0;
+    // time the nurse is back at the depot
+    double returnTime = 0.0;
+    // care time missed at the last patient of the journey that was treated too late, 0 if none
+    double missingCareTime = 0.0;
+    // capacity overshoot at the last patient where the capacity was exceeded, 0 if none
+    double capacityExcess = 0.0;
+    int demand = 0;
+    // time windows, capacity and return time are satisfied
+    bool valid = true;
+};
+
+// Function to evaluate one journey
+auto evaluateJourney(const Journey &nurseJourney, const ProblemInstance &problemInstance) -> JourneyEvaluation;
+
+// Function to weigh the violations of one journey with the penalty factors of the fitness
+auto journeyPenalty(const JourneyEvaluation &evaluation, const ProblemInstance &problemInstance) -> double;
+
+// Function to fill fitness, penalties, travel time, per journey feasibility and validity of an individual in one pass
+auto evaluateIndividual(Individual *individual, const ProblemInstance &problemInstance) -> void;
+
+// Function to evaluate many journeys at once. Uses an AVX2 gather kernel that walks four journeys in lockstep
+// when the CPU supports it and falls back to evaluateJourney otherwise. Both paths give identical results.
+auto evaluateJourneys(const std::vector<const Journey *> &journeys, const ProblemInstance &problemInstance, std::vector<JourneyEvaluation> &evaluations) -> void;
+
+// Function to evaluate the individuals at the given indices of a population with one batch of journeys
+auto evaluateIndividuals(Population &population, const std::vector<std::size_t> &indices, const ProblemInstance &problemInstance) -> void;
+
+// Function to evaluate every individual of a population with one batch of journeys
+auto evaluatePopulation(Population &population, const ProblemInstance &problemInstance) -> void;
+
+// Function to check if evaluateJourneys runs the AVX2 kernel on this CPU
+auto isAvx2EvaluationAvailable() -> bool;
@@ -0,0 +1,90 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "cache.h"
+#include "structures.h"
+#include "evaluation.h"
+#include "genomeHash.h"
+
+// Everything evaluateIndividual writes into an individual
+struct CachedEvaluation
+{
+    double fitness = 0.0;
+    double missingCareTimePenality = 0.0;
+    double capacityPenality = 0.0;
+    double toLateToDepotPenality = 0.0;
+    double travelTime = 0.0;
+    std::vector<bool> journeyValid;
+    bool valid = false;
+    // check hash of the genome, see HashWithCheck
+    std::uint64_t check = 0;
+};
+
+struct CachedJourneyEvaluation
+{
+    JourneyEvaluation evaluation;
+    std::uint64_t check = 0;
+};
+
+// Process wide cache from genome hash to evaluation result, consulted by the evaluation functions when enabled
+class FitnessCache
+{
+private:
+    BoundedCache<CachedEvaluation> cache;
+    std::atomic<bool> enabled{false};
+    // mixed into every key so that entries of another instance are never returned
+    std::uint64_t instanceSalt = 0;
+    FitnessCache() = default;
+
+public:
+    static auto getInstance() -> FitnessCache &;
+
+    // enable or disable the cache for the given instance, this clears the cache and its counters
+    void configure(bool enabled, std::size_t capacity, const std::string &instanceName);
+    auto isEnabled() const -> bool { return enabled.load(std::memory_order_relaxed); }
+
+    // Function to compute the cache key and check of a genome
+    auto keyOf(const Genome &genome) const -> HashWithCheck;
+
+    // copies the cached evaluation of key into the individual, returns false on a miss or if the check differs
+    auto restore(const HashWithCheck &key, Individual *individual) -> bool;
+    // stores the evaluation of an already evaluated individual
+    void store(const HashWithCheck &key, const Individual &individual);
+
+    auto hits() const -> std::uint64_t { return cache.hits(); }
+    auto misses() const -> std::uint64_t { return cache.misses(); }
+    auto hitRate() const -> double { return cache.hitRate(); }
+    auto size() -> std::size_t { return cache.size(); }
+};
+
+// Process wide cache from journey content hash to journey evaluation, shared by all individuals and generations.
+// A journey evaluates the same no matter which nurse drives it, so the key only depends on the visited patients.
+class JourneyCache
+{
+private:
+    BoundedCache<CachedJourneyEvaluation> cache;
+    std::atomic<bool> enabled{false};
+    std::uint64_t instanceSalt = 0;
+    JourneyCache() = default;
+
+public:
+    static auto getInstance() -> JourneyCache &;
+
+    // enable or disable the cache for the given instance, this clears the cache and its counters
+    void configure(bool enabled, std::size_t capacity, const std::string &instanceName);
+    auto isEnabled() const -> bool { return enabled.load(std::memory_order_relaxed); }
+
+    // Function to compute the cache key and check of a journey
+    auto keyOf(const Journey &journey) const -> HashWithCheck;
+
+    // copies the cached evaluation of key into evaluation, returns false on a miss or if the check differs
+    auto find(const HashWithCheck &key, JourneyEvaluation &evaluation) -> bool;
+    void store(const HashWithCheck &key, const JourneyEvaluation &evaluation);
+
+    auto hits() const -> std::uint64_t { return cache.hits(); }
+    auto misses() const -> std::uint64_t { return cache.misses(); }
+    auto hitRate() const -> double { return cache.hitRate(); }
+    auto size() -> std::size_t { return cache.size(); }
+};
@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include "structures.h"
+
+// Zobrist style genome hashing. Every edge a nurse drives (depot -> patient, patient -> patient, patient -> depot)
+// maps to a pseudo random 64 bit key and a genome hashes to the sum of its edge keys. Because the hash is a sum
+// it could be updated from the edges an operator changes, but the genome is edited in place in too many places to
+// carry it safely on an individual, so the caches hash the whole genome on every lookup. A hit then costs about a
+// third of an evaluation and a miss adds about half of one, see BM_evaluateIndividualCached and
+// BM_evaluatePopulationCached.
+// A sum is used instead of the classic xor so that repeated edges in broken genomes do not cancel out.
+
+// Key and check of a cache entry. The key is the Zobrist sum, the check an independent polynomial hash of the patient
+// sequence. The caches compare the check on every hit, so a wrong entry is only returned if both 64 bit hashes collide.
+struct HashWithCheck
+{
+    std::uint64_t key = 0;
+    std::uint64_t check = 0;
+};
+
+// Function to scramble a 64 bit value (splitmix64 finalizer)
+auto mixHash(std::uint64_t value) -> std::uint64_t;
+
+// Function to get the key of the edge from -> to driven by the given nurse, the depot is location 0
+auto edgeKey(int nurse, int from, int to) -> std::uint64_t;
+
+// Function to hash one journey of the given nurse, an empty journey hashes to 0
+auto hashJourney(const Journey &journey, int nurse) -> std::uint64_t;
+
+// Function to hash a whole genome
+auto hashGenome(const Genome &genome) -> std::uint64_t;
+
+// Functions to compute key and check in one pass, a journey is hashed as if nurse 0 drove it
+auto hashJourneyWithCheck(const Journey &journey) -> HashWithCheck;
+auto hashGenomeWithCheck(const Genome &genome) -> HashWithCheck;
+
+// Function to derive a salt from an instance name so that hashes of different instances do not collide
+auto hashInstanceName(const std::string &instanceName) -> std::uint64_t;
@@ -0,0 +1,75 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "structures.h"
+
+// Forward and backward time information of one journey, used to check moves against the time windows without
+// walking the whole journey again
+struct RouteSchedule
+{
+    // time the nurse finishes caring for the patient at each position
+    std::vector<double> departureTimes;
+    // latest time the nurse may arrive at each position so that the rest of the journey stays within all time windows
+    std::vector<double> latestArrivalTimes;
+    // summed demand up to and including each position
+    std::vector<int> cumulativeDemand;
+    // all time windows and the depot return time are met
+    bool timeFeasible = true;
+    // first position whose time window is missed, the journey length if there is none
+    int firstViolation = 0;
+    int load = 0;
+};
+
+// Function to compute the schedule of a journey
+auto buildRouteSchedule(const Journey &journey, const ProblemInstance &problemInstance, RouteSchedule &schedule) -> void;
+
+// Function to check in O(1) if the journey is feasible (time windows, return time and capacity) after inserting the
+// patient in front of position
+auto isInsertionFeasible(const Journey &journey, const RouteSchedule &schedule, int position, int patientId, const ProblemInstance &problemInstance) -> bool;
+
+enum class ImprovementStrategy
+{
+    // apply the first improving move found while scanning
+    FirstImprovement,
+    // scan the whole neighbourhood and apply the best move
+    BestImprovement
+};
+
+// Function to parse "first" or "best", anything else is rejected with std::invalid_argument
+auto parseImprovementStrategy(const std::string &strategy) -> ImprovementStrategy;
+
+// Function to run 2-opt on one journey until no improving reversal is left. Gains are computed in O(1) from the
+// four changed edges and segments are reversed in place. Nodes whose reversals did not improve are skipped (don't look
+// bits) until one of their edges changes. If the instance has neighbour lists only reversals that connect a node to one
+// of its neighbours are tried. If the journey meets its time windows a reversal is only applied if it keeps
+// them, otherwise only the travel time is considered. Returns true if the journey was changed.
+auto twoOptJourney(Journey &journey, const ProblemInstance &problemInstance, ImprovementStrategy strategy = ImprovementStrategy::FirstImprovement) -> bool;
+
+// Neighbourhoods used by interRouteSearch
+struct InterRouteNeighbourhoods
+{
+    // move one patient into another journey
+    bool relocate = true;
+    // swap two patients of different journeys
+    bool exchange = true;
+    // swap the tails of two journeys
+    bool twoOptStar = true;
+    // swap two segments of up to maxSegmentLength patients between journeys
+    bool crossExchange = true;
+    int maxSegmentLength = 3;
+    // only try moves that connect a patient to one of its neighbours, needs the neighbour lists of the instance
+    bool useNeighbourLists = true;
+};
+
+// Function to improve the travel time of a genome with moves between journeys until no improving move is left.
+// Every move is rated in O(1) from the changed edges, the cumulative demand and the schedules of the two journeys.
+// A move is only applied if it shortens the travel time and does not lower the number of feasible journeys among
+// the two journeys it touches. If one of them is infeasible the move also has to keep their summed penalty, weighted
+// like in the fitness, from rising. Returns true if the genome was changed.
+auto interRouteSearch(Genome &genome, const ProblemInstance &problemInstance, const InterRouteNeighbourhoods &neighbourhoods = InterRouteNeighbourhoods()) -> bool;
+
+// Function to run Or-opt: segments of 1 to maxSegmentLength consecutive patients are moved to their best place within
+// their own or another journey until no improving move is left. Gains are computed from the changed edges and
+// feasibility from the journey schedules, moves within a journey walk the patients between the old and the new place.
+// The same acceptance rule as for interRouteSearch applies. Returns true if the genome was changed.
+auto orOptSearch(Genome &genome, const ProblemInstance &problemInstance, int maxSegmentLength = 3, bool useNeighbourLists = true) -> bool;
@@ -0,0 +1,52 @@
+#pragma once
+#include <cstddef>
+#include <spdlog/logger.h>
+
+struct LoggingConfig
+{
+    // hand log records to a background thread instead of writing them on the calling thread
+    bool async = true;
+    // number of records the background thread can buffer
+    std::size_t queueSize = 8192;
+    // if the buffer is full the caller blocks until there is room. Opting in makes the main logger overwrite the
+    // oldest record instead, the statistics logger always blocks because python/visualizer.py needs every generation.
+    bool dropMainRecordsWhenQueueFull = false;
+    // flush all loggers every n seconds, 0 disables the periodic flush
+    int flushIntervalSeconds = 1;
+    // flush immediately once a record of at least this level is logged
+    spdlog::level::level_enum flushLevel = spdlog::level::warn;
+};
+
+// Function to create and register the main and statistics logger
+auto initLogger(const LoggingConfig &loggingConfig = LoggingConfig()) -> void;
+
+// Function to flush all pending records and stop the background logging thread
+auto shutdownLogger() -> void;
+
+// Functions to access the registered loggers. The handles are resolved once in initLogger,
+// so hot code does not pay for a lookup in spdlog's mutex protected registry on every call.
+auto mainLogger() -> spdlog::logger &;
+auto statisticsLogger() -> spdlog::logger &;
+
+// Logging macros that only evaluate their arguments if the level is enabled at runtime.
+// Trace logging can never be enabled in production builds, so it is compiled out there. The logger is still named
+// so that a handle fetched only for trace records does not become an unused variable.
+#define LOG_AT_LEVEL(logger, level, ...)          \
+    do                                            \
+    {                                             \
+        if ((logger).should_log(level))           \
+        {                                         \
+            (logger).log(level, __VA_ARGS__);     \
+        }                                         \
+    } while (false)
+
+#if defined(PRODUCTION)
+#define LOG_TRACE(logger, ...) \
+    do                         \
+    {                          \
+        (void)(logger);        \
+    } while (false)
+#else
+#define LOG_TRACE(logger, ...) LOG_AT_LEVEL(logger, spdlog::level::trace, __VA_ARGS__)
+#endif
+#define LOG_DEBUG(logger, ...) LOG_AT_LEVEL(logger, spdlog::level::debug, __VA_ARGS__)
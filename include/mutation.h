@@ -7,7 +7,18 @@ auto reassignOnePatient(Genome& genome, const FunctionParameters& parameters) ->
 auto swapWithinJourney(Genome& genome, const FunctionParameters& parameters) -> Genome;
 auto swapBetweenJourneys(Genome& genome, const FunctionParameters& parameters) -> Genome;
 auto insertWithinJourney(Genome& genome, const FunctionParameters& parameters) -> Genome;
+// Moves a random patient right in front of or behind one of its nearest neighbours, needs the neighbour lists of the instance
+auto moveToNeighbour(Genome& genome, const FunctionParameters& parameters) -> Genome;
 auto twoOpt(Genome& genome, const FunctionParameters& parameters) -> Genome;
+// Improves the genome with relocate, exchange, 2-opt* and CROSS exchange moves between journeys.
+// Neighbourhoods can be switched off with the bool parameters relocate, exchange, two_opt_star and cross_exchange.
+auto interRouteLocalSearch(Genome& genome, const FunctionParameters& parameters) -> Genome;
+// Moves segments of up to max_segment_length (default 3) patients to their best place in any journey
+auto orOpt(Genome& genome, const FunctionParameters& parameters) -> Genome;
+// Large neighbourhood move: removes removal_fraction (default 0.15) of the patients with removal_strategy ("random",
+// "related", "worst", "route" or "mixed" for a random one of them, the default) and reinserts them with regret-k
+// insertion, k given by regret (default 2)
+auto ruinAndRecreate(Genome& genome, const FunctionParameters& parameters) -> Genome;
 auto inverseJourney(Genome &genome, const FunctionParameters &parameters) -> Genome;
 auto splitJourney(Genome &genome, const FunctionParameters &parameters) -> Genome;
 auto insertionHeuristic(Genome& genome, const FunctionParameters &parameters) -> Genome;
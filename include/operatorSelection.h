@@ -0,0 +1,46 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+// Adaptive choice between the operators of one kind by probability matching. Every operator has a quality, the share
+// of the improvement per second it achieved, estimated with an exponential moving average. An operator is chosen with
+// probability minimumProbability + (1 - n * minimumProbability) * quality, so no operator is ever switched off.
+class AdaptiveOperatorSelection
+{
+private:
+    double minimumProbability;
+    double adaptationRate;
+    std::vector<double> qualities;
+    std::vector<double> probabilities;
+    // improvement, seconds and applications of every operator in the current generation
+    std::vector<double> improvements;
+    std::vector<double> seconds;
+    std::vector<int> applications;
+
+    void updateProbabilities();
+
+public:
+    // The qualities start as the shares of the rates. Throws std::invalid_argument if there are no rates, a rate is
+    // negative, all rates are 0, minimumProbability is not below 1 / number of operators or adaptationRate is not in (0, 1].
+    AdaptiveOperatorSelection(const std::vector<double> &rates, double minimumProbability, double adaptationRate);
+
+    // Function to choose an operator with a uniform random value in [0, 1)
+    auto selectOperator(double randomValue) const -> std::size_t;
+
+    // Function to add the time one application of an operator took
+    void recordApplication(std::size_t operatorIndex, double seconds);
+
+    // Function to credit an operator with the fitness gained by one of its applications
+    void recordImprovement(std::size_t operatorIndex, double improvement);
+
+    // Function to move the qualities of the operators applied in this generation towards their share of the
+    // improvement per second and start the next generation. Operators that were not applied keep their quality, and
+    // a generation without any improvement changes nothing.
+    void endGeneration();
+
+    auto getProbabilities() const -> const std::vector<double> & { return probabilities; }
+    auto getQualities() const -> const std::vector<double> & { return qualities; }
+
+    // Function to restore the qualities of a checkpoint, throws std::invalid_argument if the number does not match
+    void setQualities(const std::vector<double> &qualities);
+};
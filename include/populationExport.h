@@ -0,0 +1,61 @@
+#pragma once
+#include <fstream>
+#include <string>
+#include <vector>
+#include "structures.h"
+
+// Population of one generation as written by PopulationWriter, the individuals only carry their genome, fitness,
+// travel time and validity
+struct PopulationSnapshot
+{
+    int generation = 0;
+    Population population;
+};
+
+struct PopulationExport
+{
+    std::string instanceName;
+    std::vector<PopulationSnapshot> snapshots;
+};
+
+// Streams population snapshots to a file without building them in memory first. Every snapshot is flushed once it is
+// written, so the file can be read while the run continues.
+//
+// Binary: the magic "BIOAIPOP", a uint32 version and the instance name (uint32 length and bytes), then per snapshot an
+// int32 generation and a uint32 number of individuals. An individual is its fitness and travel time (float64), valid
+// (uint8), a uint16 number of journeys and per journey a uint16 length and the uint16 patient ids. All values are little
+// endian.
+//
+// JsonLines: one object per snapshot and line,
+// {"instance":"...","generation":3,"individuals":[{"fitness":-1692.2,"travelTime":1692.2,"valid":true,"genome":[[1,2],[3]]}]}
+class PopulationWriter
+{
+private:
+    std::ofstream stream;
+    PopulationExportFormat format;
+    std::string instanceName;
+
+    void writeBinarySnapshot(int generation, const Population &population);
+    void writeJsonLinesSnapshot(int generation, const Population &population);
+
+    // reads the snapshots of an existing export that a resumed run keeps
+    static auto snapshotsToKeep(const std::string &path, PopulationExportFormat format, const std::string &instanceName, int resumedGeneration) -> std::vector<PopulationSnapshot>;
+    // truncates the file and writes the snapshots again
+    PopulationWriter(const std::string &path, PopulationExportFormat format, const std::string &instanceName, const std::vector<PopulationSnapshot> &snapshots);
+
+public:
+    // Truncates the file at path, throws std::runtime_error if it can not be opened
+    PopulationWriter(const std::string &path, PopulationExportFormat format, const std::string &instanceName);
+
+    // Continues the export at path of a run resumed at resumedGeneration. The snapshots up to that generation are kept,
+    // later ones were written after the checkpoint and are dropped. A missing or empty file starts a new export. Throws
+    // std::runtime_error if the file is not an export of the instance in the format or can not be rewritten.
+    PopulationWriter(const std::string &path, PopulationExportFormat format, const std::string &instanceName, int resumedGeneration);
+
+    // Throws std::runtime_error if the snapshot can not be written or a patient id does not fit the binary format
+    void writeSnapshot(int generation, const Population &population);
+};
+
+// Function to read a file written by PopulationWriter in either format. Throws std::runtime_error if the file can not
+// be opened, is truncated, holds a count its size can not back or is not a population export.
+auto readPopulationExport(const std::string &path) -> PopulationExport;
@@ -0,0 +1,92 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// number of log2 buckets of the duration histograms (bucket i holds durations in [2^(i-1), 2^i) microseconds)
+constexpr int PROFILER_HISTOGRAM_BUCKETS = 32;
+
+struct SectionStatistics
+{
+    std::uint64_t calls = 0;
+    double totalSeconds = 0.0;
+    double maxSeconds = 0.0;
+    std::uint64_t allocations = 0;
+    std::array<std::uint64_t, PROFILER_HISTOGRAM_BUCKETS> histogram{};
+};
+
+struct GenerationProfile
+{
+    int generation = 0;
+    double wallSeconds = 0.0;
+    std::uint64_t evaluations = 0;
+    std::map<std::string, SectionStatistics> sections;
+};
+
+class Profiler
+{
+private:
+    std::atomic<bool> enabled{false};
+    std::atomic<std::uint64_t> evaluations{0};
+    std::mutex mutex;
+    std::map<std::string, SectionStatistics> currentGeneration;
+    std::map<std::string, SectionStatistics> totals;
+    std::vector<GenerationProfile> generations;
+    std::array<std::uint64_t, PROFILER_HISTOGRAM_BUCKETS> generationHistogram{};
+    std::chrono::steady_clock::time_point generationStart;
+    Profiler() = default;
+
+public:
+    static auto getInstance() -> Profiler &;
+
+    void setEnabled(bool enabled);
+    auto isEnabled() const -> bool { return enabled.load(std::memory_order_relaxed); }
+
+    // discard everything recorded so far
+    void reset();
+
+    // add one timed call of a section to the current generation
+    void record(const std::string &section, double seconds, std::uint64_t allocations);
+
+    void countEvaluation()
+    {
+        if (isEnabled())
+        {
+            evaluations.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // close the current generation, fold its sections into the run totals and start timing the next one
+    void endGeneration(int generation);
+
+    auto getGenerationProfiles() const -> const std::vector<GenerationProfile> & { return generations; }
+    auto getTotals() const -> const std::map<std::string, SectionStatistics> & { return totals; }
+
+    void exportJson(const std::string &path) const;
+    void exportCsv(const std::string &path) const;
+};
+
+// Number of heap allocations done by the calling thread. Only counts if built with PROFILE_ALLOCATIONS, otherwise always 0.
+auto threadAllocationCount() -> std::uint64_t;
+
+// Records the wall time and allocations of its scope under the given section name
+class ScopedTimer
+{
+private:
+    std::string section;
+    bool active;
+    std::chrono::steady_clock::time_point start;
+    std::uint64_t allocationsAtStart = 0;
+
+public:
+    explicit ScopedTimer(const char *section);
+    explicit ScopedTimer(const std::string &section);
+    ~ScopedTimer();
+    ScopedTimer(const ScopedTimer &) = delete;
+    auto operator=(const ScopedTimer &) -> ScopedTimer & = delete;
+};
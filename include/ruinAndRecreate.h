@@ -0,0 +1,29 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "structures.h"
+
+enum class RemovalStrategy
+{
+    // uniformly random patients
+    Random,
+    // patients close in space and time to already removed ones (Shaw removal)
+    Related,
+    // patients whose removal saves the most travel time
+    Worst,
+    // whole journeys
+    Route
+};
+
+// Function to parse "random", "related", "worst" or "route", anything else is rejected with std::invalid_argument
+auto parseRemovalStrategy(const std::string &strategy) -> RemovalStrategy;
+
+// Function to remove about numberOfPatients patients from the genome, returns the removed patients.
+// Route removal always removes complete journeys and may remove more patients.
+auto removePatients(Genome &genome, const ProblemInstance &problemInstance, RemovalStrategy strategy, int numberOfPatients) -> std::vector<int>;
+
+// Function to insert the patients with regret-k insertion: the patient that loses the most by not getting its best
+// journey compared to its k - 1 next best journeys is inserted first, regret 1 is plain cheapest insertion. Only
+// feasible places are used, checked in O(1) from the journey schedules. Patients without a feasible place are inserted
+// at their cheapest place at the end, so no patient is lost.
+auto regretInsertion(Genome &genome, const std::vector<int> &patients, const ProblemInstance &problemInstance, int regret) -> void;
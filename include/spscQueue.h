@@ -0,0 +1,63 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Bounded lock-free queue for exactly one producer thread and one consumer thread.
+// The slots form a ring buffer, the producer only writes tail and the consumer only writes head, each on its own cache line.
+template <typename T>
+class SpscQueue
+{
+private:
+    std::vector<T> slots;
+    std::size_t mask;
+    alignas(64) std::atomic<std::size_t> head{0};
+    alignas(64) std::atomic<std::size_t> tail{0};
+
+    static auto roundUpToPowerOfTwo(std::size_t value) -> std::size_t
+    {
+        std::size_t power = 1;
+        while (power < value)
+        {
+            power <<= 1;
+        }
+        return power;
+    }
+
+public:
+    // the capacity is rounded up to a power of two
+    explicit SpscQueue(std::size_t capacity) : slots(roundUpToPowerOfTwo(std::max<std::size_t>(capacity, 1))), mask(slots.size() - 1) {}
+
+    SpscQueue(const SpscQueue &) = delete;
+    auto operator=(const SpscQueue &) -> SpscQueue & = delete;
+
+    // called by the producer, returns false if the queue is full
+    auto push(T &&value) -> bool
+    {
+        const std::size_t currentTail = tail.load(std::memory_order_relaxed);
+        if (currentTail - head.load(std::memory_order_acquire) == slots.size())
+        {
+            return false;
+        }
+        slots[currentTail & mask] = std::move(value);
+        tail.store(currentTail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // called by the consumer, returns false if the queue is empty
+    auto pop(T &value) -> bool
+    {
+        const std::size_t currentHead = head.load(std::memory_order_relaxed);
+        if (currentHead == tail.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        value = std::move(slots[currentHead & mask]);
+        head.store(currentHead + 1, std::memory_order_release);
+        return true;
+    }
+
+    auto capacity() const -> std::size_t { return slots.size(); }
+};
@@ -0,0 +1,34 @@
+#pragma once
+#include <cstddef>
+#include "structures.h"
+
+struct GenerationStatistics
+{
+    std::size_t populationSize = 0;
+    int validSolutions = 0;
+    double percentageValid = 0.0;
+
+    double bestFitness = 0.0;
+    double averageFitness = 0.0;
+    double worstFitness = 0.0;
+    double fitnessStandardDeviation = 0.0;
+
+    double bestTravelTime = 0.0;
+    double averageTravelTime = 0.0;
+    double worstTravelTime = 0.0;
+    double travelTimeStandardDeviation = 0.0;
+
+    // index of the individual with the highest fitness and of the one with the lowest travel time
+    std::size_t fittestIndex = 0;
+    std::size_t fastestIndex = 0;
+
+    // diversity: number and share of pairwise distinct genomes
+    std::size_t uniqueGenomes = 0;
+    double uniqueGenomeRatio = 0.0;
+    // diversity: mean broken pairs distance of all individuals to the fittest one
+    double averageDistanceToFittest = 0.0;
+};
+
+// Computes all statistics of a generation in one pass over the evaluated population without reordering it.
+// With more than one thread the population is split into contiguous chunks that are processed in parallel.
+auto computeGenerationStatistics(const Population &population, int numberOfThreads = 1) -> GenerationStatistics;
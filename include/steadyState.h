@@ -0,0 +1,45 @@
+#pragma once
+#include <cstddef>
+#include <utility>
+#include "operatorSelection.h"
+#include "structures.h"
+
+// Children of one steady-state step, parents[i] is the population index of the parent child i descends from
+struct Offspring
+{
+    Population children;
+    std::vector<std::size_t> parents;
+};
+
+// Function to pick the index of the fittest of tournamentSize random individuals
+auto tournamentIndex(const Population &population, int tournamentSize) -> std::size_t;
+
+// Function to pick two parents by tournaments, the second one differs from the first unless it keeps winning
+auto selectParentPair(const Population &population, int tournamentSize) -> std::pair<std::size_t, std::size_t>;
+
+// Function to breed the children of two parents: a crossover with the summed crossover rates (capped at 1), then each
+// mutation rate is the expected number of applications per child. With selections the operators are drawn from them
+// and credited with the fitness the children gained over their parents. Children that are copies of a parent are
+// dropped, the others are evaluated.
+auto breedOffspring(const Population &population, std::size_t parent1, std::size_t parent2, Config &config, const ProblemInstance &problemInstance,
+                    AdaptiveOperatorSelection *crossoverSelection = nullptr, AdaptiveOperatorSelection *mutationSelection = nullptr) -> Offspring;
+
+// Function to replace the individual at the index if the child is at least as fit and not yet part of the population.
+// Returns 1 if it was replaced, 0 otherwise.
+auto replaceIfFitter(Population &population, std::size_t index, const Individual &child) -> int;
+
+// Function to pair two children with their parents for crowding, parentA and parentB are the genomes of
+// offspring.parents[0] and offspring.parents[1]. Returns offspring.parents, swapped if that gives the smaller summed
+// broken pairs distance.
+auto crowdingParents(const Genome &parentA, const Genome &parentB, const Offspring &offspring) -> std::vector<std::size_t>;
+
+// Function to insert the children into the population with the replacement strategy. Crowding pairs the children with
+// the parents so that the summed broken pairs distance is smallest. Worst and crowding skip children whose genome is
+// already in the population, which keeps copies of good individuals from taking it over. Returns the number of
+// children that were inserted.
+auto insertOffspring(Population &population, const Offspring &offspring, ReplacementStrategy strategy) -> int;
+
+// Function to run steady-state steps in place until populationSize children were bred, then end the generation of the
+// selections
+auto evolveSteadyState(Population &population, Config &config, const ProblemInstance &problemInstance,
+                       AdaptiveOperatorSelection *crossoverSelection = nullptr, AdaptiveOperatorSelection *mutationSelection = nullptr) -> void;
@@ -1,4 +1,5 @@
 #pragma once
+#include <algorithm>
 #include <utility>
 #include <vector>
 #include <variant>
@@ -36,9 +37,52 @@ struct ProblemInstance
     std::unordered_map<int, Patient> patients;
     // travel time matrix
     std::vector<std::vector<double>> travelTime;
+    // dense copy of patients indexed by patient id, unused ids hold a patient with id -1
+    std::vector<Patient> patientTable;
+    // row major copy of the travel time matrix and per patient time window, care time and demand arrays for the batch evaluator
+    int numberOfLocations = 0;
+    std::vector<double> flatTravelTime;
+    std::vector<double> patientStartTimes;
+    std::vector<double> patientEndTimes;
+    std::vector<double> patientCareTimes;
+    std::vector<double> patientDemands;
+    // nearest locations by travel time for every location (depot = 0), nearest first. Empty until buildNeighbourLists is called.
+    std::vector<std::vector<int>> neighbours;
 
     // Constructor
-    ProblemInstance(std::string instanceName, int numberOfNurses, int nurseCapacity, float benchmark, Depot depot, std::unordered_map<int, Patient> patients, std::vector<std::vector<double>> travelTime) : instanceName(std::move(instanceName)), numberOfNurses(numberOfNurses), nurseCapacity(nurseCapacity), benchmark(benchmark), depot(depot), patients(std::move(patients)), travelTime(std::move(travelTime)) {}
+    ProblemInstance(std::string instanceName, int numberOfNurses, int nurseCapacity, float benchmark, Depot depot, std::unordered_map<int, Patient> patients, std::vector<std::vector<double>> travelTime) : instanceName(std::move(instanceName)), numberOfNurses(numberOfNurses), nurseCapacity(nurseCapacity), benchmark(benchmark), depot(depot), patients(std::move(patients)), travelTime(std::move(travelTime))
+    {
+        int maxPatientId = 0;
+        for (const auto &[id, patient] : this->patients)
+        {
+            maxPatientId = std::max(maxPatientId, id);
+        }
+        patientTable.assign(maxPatientId + 1, Patient{-1, 0, 0, 0, 0, 0, 0});
+        for (const auto &[id, patient] : this->patients)
+        {
+            patientTable[id] = patient;
+        }
+        numberOfLocations = static_cast<int>(this->travelTime.size());
+        flatTravelTime.assign(numberOfLocations * numberOfLocations, 0.0);
+        for (int from = 0; from < numberOfLocations; from++)
+        {
+            const auto &row = this->travelTime[from];
+            std::copy_n(row.begin(), std::min<std::size_t>(row.size(), numberOfLocations), flatTravelTime.begin() + from * numberOfLocations);
+        }
+        for (const Patient &patient : patientTable)
+        {
+            patientStartTimes.push_back(patient.startTime);
+            patientEndTimes.push_back(patient.endTime);
+            patientCareTimes.push_back(patient.careTime);
+            patientDemands.push_back(patient.demand);
+        }
+    }
+
+    // Function to check if an id belongs to a patient of this instance
+    auto isPatient(int patientId) const -> bool
+    {
+        return patientId >= 0 && patientId < static_cast<int>(patientTable.size()) && patientTable[patientId].id == patientId;
+    }
 };
 
 using Journey = std::vector<int>;
@@ -52,10 +96,29 @@ struct Individual
     double missingCareTimePenality = 0.0;
     double capacityPenality = 0.0;
     double toLateToDepotPenality = 0.0;
+    // total driving time of all journeys, set by evaluateIndividual
+    double travelTime = 0.0;
+    // feasibility of every journey and of the whole genome, set by evaluateIndividual
+    std::vector<bool> journeyValid = {};
+    bool valid = false;
 };
 
 using Population = std::vector<Individual>;
 
+struct SolutionValidation
+{
+    bool valid = true;
+    // patients that appear more than once
+    int duplicateVisits = 0;
+    // patients of the instance that are not part of any journey
+    int missingPatients = 0;
+    // ids in the genome that are not patients of the instance
+    int unknownPatients = 0;
+    // journeys that violate a time window, the capacity or the return time
+    int invalidJourneys = 0;
+    int firstInvalidJourney = -1;
+};
+
 using FunctionParameters = std::map<std::string, std::variant<int, double, std::string, bool, ProblemInstance>>;
 using CrossoverFunction = std::pair<Genome, std::optional<Genome>> (*)(const Genome &, const Genome &);
 using MutationFunction = Genome (*)(Genome &, const FunctionParameters &parameters);
@@ -67,6 +130,35 @@ using MuationConfiguration = std::vector<std::tuple<MutationFunction, FunctionPa
 using ParentSelectionConfiguration = std::pair<ParentSelectionFunction, FunctionParameters &>;
 using SurvivorSelectionConfiguration = std::pair<SurvivorSelectionFunction, FunctionParameters &>;
 
+// Share of the initial population built by each constructive seeder, the rest is built by the greedy end time construction
+struct SeedingProportions
+{
+    // Clarke-Wright savings
+    double savings = 0.0;
+    // Solomon I1 insertion
+    double solomonI1 = 0.0;
+    // sweep by polar angle around the depot
+    double sweep = 0.0;
+};
+
+// Which individual an offspring replaces in the steady-state mode
+enum class ReplacementStrategy
+{
+    // the least fit individual, if the offspring is at least as fit
+    Worst,
+    // a random individual other than the fittest
+    Random,
+    // the parent closer to the offspring by broken pairs distance, if the offspring is at least as fit
+    Crowding
+};
+
+// File format of the population snapshots, see populationExport.h
+enum class PopulationExportFormat
+{
+    Binary,
+    JsonLines
+};
+
 struct Config
 {
     const int populationSize;
@@ -76,6 +168,53 @@ struct Config
     CrossoverConfiguration crossover;
     MuationConfiguration mutation;
     SurvivorSelectionConfiguration survivorSelection;
+    // number of threads used by the parallel parts of the algorithm
+    int numberOfThreads = 1;
+    // orders tried per individual by the feasible initialization before the unplaced patients are repaired
+    int maxConstructionAttempts = 10;
+    // how the feasible initialization splits the population over the constructive seeders
+    SeedingProportions seedingProportions;
+    // record per stage and per operator timings and export them as <profileOutputPrefix>.json/.csv after the run
+    bool enableProfiling = false;
+    std::string profileOutputPrefix = "profile";
+    // reuse the evaluation of genomes that were already evaluated, the cache holds at most fitnessCacheCapacity genomes.
+    // It pays off once about half of the evaluated genomes were seen before, as in the converged phase of a run.
+    bool enableFitnessCache = false;
+    std::size_t fitnessCacheCapacity = 1 << 16;
+    // reuse the evaluation of journeys that were already evaluated in any individual, holds at most journeyCacheCapacity journeys
+    bool enableJourneyCache = false;
+    std::size_t journeyCacheCapacity = 1 << 18;
+    // write a checkpoint to checkpointPath every checkpointInterval generations and after the last one, 0 disables it
+    int checkpointInterval = 0;
+    std::string checkpointPath = "checkpoint.bin";
+    // continue the run stored in checkpointPath up to numberOfGenerations instead of starting a new one
+    bool resumeFromCheckpoint = false;
+    // append the whole population to populationExportPath every populationExportInterval generations and after the
+    // last one, 0 disables it
+    int populationExportInterval = 0;
+    std::string populationExportPath = "population.bin";
+    PopulationExportFormat populationExportFormat = PopulationExportFormat::Binary;
+    // choose the operator of every crossover and mutation by probability matching on the improvement per second the
+    // operators achieve instead of applying each at its fixed rate, the rates then only set the number of applications
+    // per generation and the initial probabilities. The choices depend on measured times, so such runs are not
+    // reproducible from the seed alone.
+    bool adaptiveOperatorSelection = false;
+    // probability every operator keeps, must be below 1 / number of operators of a kind
+    double minimumOperatorProbability = 0.05;
+    // weight of the last generation in the quality of an operator
+    double operatorAdaptationRate = 0.3;
+    // replace individuals in place one offspring at a time instead of building a new population every generation.
+    // A generation then is populationSize offspring and the survivor selection is not used.
+    bool steadyState = false;
+    ReplacementStrategy steadyStateReplacement = ReplacementStrategy::Worst;
+    // individuals per tournament when a steady-state step picks a parent
+    int steadyStateTournamentSize = 2;
+    // breed and evaluate the steady-state offspring on numberOfThreads worker threads while this thread inserts them as
+    // they arrive, so no thread waits for the slowest offspring of a generation. Uses the steady-state replacement and
+    // tournament size, the order of the insertions depends on the scheduling so runs are not reproducible from the seed.
+    bool asynchronousEvolution = false;
+    // print the progress of the run to stdout, the log files are written either way
+    bool printProgress = true;
 
     // Constructor
     Config(const int populationSize, int numberOfGenerations, bool initialPopulationDistirbutePatientsEqually, ParentSelectionConfiguration parentSelection, CrossoverConfiguration crossover, MuationConfiguration mutation, SurvivorSelectionConfiguration survivorSelection) : populationSize(populationSize), numberOfGenerations(numberOfGenerations), initialPopulationDistirbutePatientsEqually(initialPopulationDistirbutePatientsEqually), parentSelection(std::move(parentSelection)), crossover(std::move(crossover)), mutation(std::move(mutation)), survivorSelection(std::move(survivorSelection)) {}
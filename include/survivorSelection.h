@@ -4,3 +4,11 @@
 auto fullReplacement(const Population& parents, const Population& children, const FunctionParameters& parameters, const int population_size) -> Population;
 auto rouletteWheelReplacement(const Population& parents, const Population& children, const FunctionParameters& parameters, const int population_size) -> Population;
 auto elitismWithFill(const Population& parents, const Population& children, const FunctionParameters& parameters, const int population_size) -> Population;
+// Removes duplicate genomes from parents and children and keeps the individuals with the best biased fitness: the
+// rank by fitness plus (1 - elites / size) times the rank by diversity contribution, which is the mean broken pairs
+// distance to the number_of_closest (default 5) closest individuals. To stay near linear in the population size an
+// individual is only compared to the comparison_window (default 50, 0 compares all pairs) individuals next to it in the
+// fitness order, where the clones and near clones are. The fittest individual always survives, duplicates only fill up
+// the population if there are not enough distinct genomes. Parameters: number_of_closest (int), number_of_elites (int,
+// default 10% of the population size), comparison_window (int).
+auto biasedFitnessReplacement(const Population& parents, const Population& children, const FunctionParameters& parameters, const int population_size) -> Population;
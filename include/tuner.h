@@ -0,0 +1,87 @@
+#pragma once
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+#include "nlohmann/json.hpp"
+#include "configLoader.h"
+
+// A value of the configuration that is tuned, sampled uniformly from [minimum, maximum]
+struct TunedParameter
+{
+    // json pointer into the configuration, e.g. /mutations/0/probability
+    std::string path;
+    // ParameterType::Int or ParameterType::Double
+    ParameterType type = ParameterType::Double;
+    double minimum = 0.0;
+    double maximum = 1.0;
+};
+
+struct TuningSettings
+{
+    // configuration every candidate starts from, it is the first candidate of the race
+    nlohmann::json baseConfiguration;
+    std::vector<std::string> instances;
+    std::vector<unsigned int> seeds;
+    std::vector<TunedParameter> parameters;
+    // candidates in the race including the base configuration
+    int numberOfCandidates = 16;
+    // blocks (instance and seed pairs, all instances with the first seed come first) every candidate is run on before the first elimination
+    int firstTest = 5;
+    // maximum number of SGA runs of the whole race
+    int budget = 500;
+    // runs done at the same time
+    int numberOfThreads = 1;
+    // seed for sampling the candidates
+    unsigned int samplingSeed = 1;
+    std::string outputPath = "tuned_config.json";
+};
+
+struct RaceResult
+{
+    std::vector<nlohmann::json> candidates;
+    // candidates that were not eliminated
+    std::vector<bool> alive;
+    // mean rank of every candidate over the blocks it was run on, 1 is best
+    std::vector<double> meanRanks;
+    std::size_t bestCandidate = 0;
+    int runs = 0;
+    int blocks = 0;
+};
+
+// Runs a configuration on an instance with a seed and returns the fitness of the result, higher is better
+using RunEvaluator = std::function<double(const nlohmann::json &configuration, const std::string &instanceFile, unsigned int seed)>;
+
+// Function to read the tuning settings, baseConfiguration is either a configuration or the path of one.
+// Throws std::invalid_argument if the settings are incomplete or a path does not exist in the base configuration.
+auto readTuningSettings(const nlohmann::json &settings) -> TuningSettings;
+
+// Function to create the candidates: the base configuration followed by numberOfCandidates - 1 uniform samples
+auto sampleCandidates(const TuningSettings &settings, std::mt19937_64 &engine) -> std::vector<nlohmann::json>;
+
+// Function to rank the results of one block, the highest fitness gets rank 1 and ties share the mean of their ranks
+auto rankBlock(const std::vector<double> &fitness) -> std::vector<double>;
+
+// Function to apply the Friedman test to the ranks (one row per block) and, if it rejects that all candidates are
+// equal, Conover's post-hoc test against the best candidate. Returns false for candidates that are significantly worse.
+auto friedmanSurvivors(const std::vector<std::vector<double>> &ranks, double significance = 0.05) -> std::vector<bool>;
+
+// Approximate quantiles used by the tests
+auto normalQuantile(double probability) -> double;
+// Wilson-Hilferty approximation
+auto chiSquareQuantile(double probability, int degreesOfFreedom) -> double;
+// Cornish-Fisher expansion around the normal quantile
+auto studentTQuantile(double probability, int degreesOfFreedom) -> double;
+
+// Function to race the candidates: the blocks are run one after the other, the alive candidates of a block are run on
+// numberOfThreads threads, and from firstTest blocks on dominated candidates are eliminated. The race ends when the
+// blocks or the budget run out or one candidate is left.
+auto race(const TuningSettings &settings, const std::vector<nlohmann::json> &candidates, const RunEvaluator &evaluate) -> RaceResult;
+
+// Function to create an evaluator that runs the SGA without caches, profiling, checkpoints and progress output.
+// Every run gets a new thread so that it starts with a fresh random generator seeded with the seed of the block.
+auto makeSGAEvaluator() -> RunEvaluator;
+
+// Function to sample and validate the candidates, race them with the SGA evaluator and write the winning configuration
+// to the output path of the settings
+auto tune(const TuningSettings &settings) -> RaceResult;
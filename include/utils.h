@@ -1,6 +1,15 @@
 #pragma once
 #include <vector>
 #include "structures.h"
+#include "logging.h"
+
+// Function to load a problem instance from the train folder, the neighbour lists are built with numberOfNeighbours entries
+auto loadInstance(const std::string &filename, int numberOfNeighbours = 20) -> ProblemInstance;
+
+// Function to fill the neighbour lists of an instance with the numberOfNeighbours patients that are reached fastest from
+// each location. With timeWindowCompatibleOnly a patient is skipped if it can not be cared for in time when the nurse
+// comes straight from the location after caring there as early as possible.
+auto buildNeighbourLists(ProblemInstance &problemInstance, int numberOfNeighbours, bool timeWindowCompatibleOnly = true) -> void;
 
 // Function to calculate the total travel time of a genome
 auto getTotalTravelTime(const Genome &genome, const ProblemInstance &problemInstance) -> double;
@@ -26,7 +35,12 @@ auto exportIndividual(const Individual& individual, const std::string& path) ->
 // Function to check if a journey is valid
 auto isJourneyValid(const Journey &nurseJourney, const ProblemInstance &problemInstance) -> bool;
 
+// Function to count duplicate, missing and unknown patient visits of a genome into validation.
+// Uses a thread local bitset over the patient ids and does not allocate after the first call.
+auto countPatientVisits(const Genome &genome, const ProblemInstance &problemInstance, SolutionValidation &validation) -> void;
+
+// Function to check every constraint of a genome and count the violations
+auto validateSolution(const Genome &genome, const ProblemInstance &problemInstance) -> SolutionValidation;
+
 // Function to check if a genome is valid
 auto isSolutionValid(const Genome &genome, const ProblemInstance &problemInstance) -> bool;
-
-auto initLogger() -> void;
\ No newline at end of file
@@ -11,6 +11,8 @@
 #include "crossover.h"
 #include "mutation.h"
 #include "survivorSelection.h"
+#include "configLoader.h"
+#include "tuner.h"
 #include <climits>
 #include <future>
 #include "utils.h"
@@ -21,82 +23,6 @@
 
 using json = nlohmann::json;
 
-auto loadInstance(const std::string &filename) -> ProblemInstance
-{
-    auto logger = spdlog::get("main_logger");
-    std::ifstream inputFileStream("./../train/" + filename);
-    json data = json::parse(inputFileStream);
-    const std::string instanceName = data["instance_name"];
-    spdlog::get("main_logger")->info("Loading instance: {}", instanceName);
-    // load the depot
-    Depot depot = {
-        data["depot"]["x_coord"],
-        data["depot"]["y_coord"],
-        data["depot"]["return_time"]};
-    // load the patients
-    const int numberOfPatients = data["patients"].size();
-    logger->info("Number of patients: {}", numberOfPatients);
-    std::unordered_map<int, Patient> patients;
-    patients.reserve(numberOfPatients);
-    for (const auto &entry : data["patients"].items())
-    {
-        const auto &patientData = entry.value();
-        patients.insert({std::stoi(entry.key()), {std::stoi(entry.key()), patientData["demand"], patientData["start_time"], patientData["end_time"], patientData["care_time"], patientData["x_coord"], patientData["y_coord"]}});
-    }
-    // load the travel time matrix
-    const int numberOfNurses = data["nbr_nurses"];
-    const int nurseCapacity = data["capacity_nurse"];
-    const float benchmark = data["benchmark"];
-    logger->info("Number of nurses: {}", numberOfNurses);
-    logger->info("Nurse capacity: {}", nurseCapacity);
-    logger->info("Benchmark: {}", benchmark);
-    std::vector<std::vector<double>> travelTimeMatrix;
-    travelTimeMatrix.reserve(numberOfPatients + 1);
-    for (const auto &row : data["travel_times"])
-    {
-        std::vector<double> helper;
-        helper.reserve(numberOfPatients + 1);
-        for (const auto &travelTime : row)
-        {
-            helper.push_back(travelTime);
-        }
-        travelTimeMatrix.push_back(helper);
-    }
-
-    ProblemInstance problemInstance = {
-        instanceName,
-        numberOfNurses,
-        nurseCapacity,
-        benchmark,
-        depot,
-        patients,
-        travelTimeMatrix};
-    logger->info("Instance loaded");
-    return problemInstance;
-}
-
-auto loadFunctionParameters(json functionJson) -> FunctionParameters
-{
-    FunctionParameters params = {
-        {"tournamentSize", functionJson["tournamentSize"]},
-        {"tournamentProbability", functionJson["tournamentProbability"]}};
-
-    return params;
-}
-
-auto loadConfig() -> void
-{
-    std::ifstream inputFileStream("./../config.json");
-    json data = json::parse(inputFileStream);
-
-    int populationSize = data["populationSize"];
-    int generations = data["generations"];
-
-    auto params = loadFunctionParameters(data["parentSelection"]);
-
-    return;
-}
-
 auto runInParallel(ProblemInstance instance, Config config) -> Individual
 {
     // Define an array to hold the threads
@@ -128,69 +54,62 @@ auto runInParallel(ProblemInstance instance, Config config) -> Individual
     return individuals[0];
 }
 
-auto main() -> int
+auto main(int argc, char **argv) -> int
 {
-    initLogger();
+    LoggingConfig loggingConfig;
+    initLogger(loggingConfig);
     auto logger = spdlog::get("main_logger");
 
     logger->info("Loggers created, starting program");
 
-    ProblemInstance problemInstance = loadInstance("train_9.json");
+    // the run is described by config.json, the command line overrides single values of it
+    RunConfiguration run;
+    try
+    {
+        CommandLineOptions options = parseCommandLine(std::vector<std::string>(argv + 1, argv + argc));
+        if (!options.tuningPath.empty())
+        {
+            // the overrides of the command line apply to the base configuration of the race
+            TuningSettings settings = readTuningSettings(readConfigurationFile(options.tuningPath));
+            settings.baseConfiguration.merge_patch(options.overrides);
+            RaceResult result = tune(settings);
+            std::cout << "Candidate " << result.bestCandidate << " won after " << result.runs << " runs, its configuration is written to " << settings.outputPath << std::endl;
+            shutdownLogger();
+            return 0;
+        }
+        json configuration = readConfigurationFile(options.configurationPath);
+        configuration.merge_patch(options.overrides);
+        run = loadRunConfiguration(configuration);
+    }
+    catch (const std::exception &exception)
+    {
+        std::cerr << exception.what() << '\n'
+                  << commandLineUsage() << '\n';
+        logger->error("Invalid configuration: {}", exception.what());
+        shutdownLogger();
+        return 1;
+    }
+    const ProblemInstance &problemInstance = *run.problemInstance;
     RandomGenerator &rng = RandomGenerator::getInstance();
-    rng.setSeed(4711);
+    rng.setSeed(run.seed);
+    logger->info("Running {} with seed {}", run.instanceFile, run.seed);
 
-    const int populationSize = 500;
-
-    FunctionParameters emptyParams;
-    // parent selection
-    FunctionParameters tournamentSelectionConfigurationParams = {{"tournamentSize", 5}, {"tournamentProbability", 0.8}};
-    ParentSelectionConfiguration tournamentSelectionConfiguration = {tournamentSelection, tournamentSelectionConfigurationParams};
-    ParentSelectionConfiguration rouletteWheelSelectionConfiguration = {rouletteWheelSelection, emptyParams};
-    // crossover
-    CrossoverConfiguration order1CrossoverConfiguration = {{order1Crossover, 0.3}};
-    CrossoverConfiguration partiallyMappedCrossoverConfiguration = {{partiallyMappedCrossover, 0.2}};
-    CrossoverConfiguration edgeRecombinationConfiguration = {{edgeRecombination, 0.8}};
-    CrossoverConfiguration partiallyMappedCrossoverAndEdgeRecombinationConfiguration = {{partiallyMappedCrossover, 0.2}, {edgeRecombination, 0.2}};
-    // mutation
-    FunctionParameters twoOptParams = {{"problem_instance", problemInstance}};
-    MuationConfiguration reassignOnePatientConfiguration = {{reassignOnePatient, emptyParams, 0.01}};
-    MuationConfiguration everyMutationConfiguration = {{reassignOnePatient, emptyParams, 0.01},
-                                                       {insertWithinJourney, emptyParams, 0.01},
-                                                       {swapBetweenJourneys, emptyParams, 0.01},
-                                                       {swapWithinJourney, emptyParams, 0.01},
-                                                       {insertionHeuristic, twoOptParams, 0.85},
-                                                       //{twoOpt, twoOptParams, 0.01}
-                                                       };
-    MuationConfiguration insertWithinJourneyConfiguration = {{insertWithinJourney, emptyParams, 0.1}};
-    // survivor selection
-    SurvivorSelectionConfiguration fullReplacementConfiguration = {fullReplacement, emptyParams};
-    SurvivorSelectionConfiguration rouletteWheelSurvivorSelectionConfiguration = {rouletteWheelReplacement, emptyParams};
-    FunctionParameters elitismWithFillParams = {{"elitism_percentage", 0.1}, {"fillFunction", "rouletteWheel"}};
-    SurvivorSelectionConfiguration elitismWithFillConfiguration = {elitismWithFill, elitismWithFillParams};
-
-    Config config = Config(populationSize, 1000, false,
-                           tournamentSelectionConfiguration,
-                           partiallyMappedCrossoverAndEdgeRecombinationConfiguration,
-                           everyMutationConfiguration,
-                           elitismWithFillConfiguration);
-
-    loadConfig();
-
-    // Individual result = runInParallel(problemInstance, config);
-    // std::cout << "Overall Fittest individual has fitness: " << result.fitness << std::endl;
-    // if (isSolutionValid(result.genome, problemInstance))
-    // {
-    //     std::cout << "Overall Fittest individual is valid" << std::endl;
-    // }
-    // else
-    // {
-    //     std::cout << "Overall Fittest individual is invalid" << std::endl;
-    // }
-    // std::cout << "Overall Fittest individual uses " << 100 / problemInstance.benchmark * getTotalTravelTime(result.genome, problemInstance) << "% of the benchmarks time" << std::endl;
-    // logger->info("Best individual: {}", result.fitness);
-    // logger->info("Exporting best individual to json");
-    // exportIndividual(result, "./../solution.json");
-    // logger->info("Best individual exported to solution.json");
+    Individual result = SGA(problemInstance, *run.config);
+    std::cout << "Overall Fittest individual has fitness: " << result.fitness << std::endl;
+    if (isSolutionValid(result.genome, problemInstance))
+    {
+        std::cout << "Overall Fittest individual is valid" << std::endl;
+    }
+    else
+    {
+        std::cout << "Overall Fittest individual is invalid" << std::endl;
+    }
+    std::cout << "Overall Fittest individual uses " << 100 / problemInstance.benchmark * getTotalTravelTime(result.genome, problemInstance) << "% of the benchmarks time" << std::endl;
+    logger->info("Best individual: {}", result.fitness);
+    logger->info("Exporting best individual to json");
+    exportIndividual(result, "./../solution.json");
+    logger->info("Best individual exported to solution.json");
 
+    shutdownLogger();
     return 0;
 }
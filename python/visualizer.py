@@ -11,6 +11,8 @@ import matplotlib.dates as mdates
 import numpy as np
 import matplotlib.patches as mpatches
 import ast
+import os
+import struct
 
 
 class Individual: 
@@ -303,7 +305,8 @@ def read_log_file_individual_statistics(filepath):
             thread_id = line.split('[')[2].split(']')[0]
             best = float(line.split('Best: ')[1].split(' Avg:')[0])
             avg = float(line.split('Avg: ')[1].split(' Worst:')[0])
-            worst = float(line.split('Worst: ')[1])
+            # newer logs append the standard deviation behind the worst value
+            worst = float(line.split('Worst: ')[1].split(' StdDev:')[0])
             thread_data = data.get(thread_id, {"Best Travel Time": [], "Avg Travel Time": [], "Worst Travel Time": [], "Best Fitness": [], "Avg Fitness": [], "Worst Fitness": []})
             thread_data["Best Travel Time"].append(best)
             thread_data["Avg Travel Time"].append(avg)
@@ -313,7 +316,7 @@ def read_log_file_individual_statistics(filepath):
             thread_id = line.split('[')[2].split(']')[0]
             best = float(line.split('Best: ')[1].split(' Avg:')[0])
             avg = float(line.split('Avg: ')[1].split(' Worst:')[0])
-            worst = float(line.split('Worst: ')[1])
+            worst = float(line.split('Worst: ')[1].split(' StdDev:')[0])
             thread_data = data.get(thread_id, {"Best Travel Time": [], "Avg Travel Time": [], "Worst Travel Time": [], "Best Fitness": [], "Avg Fitness": [], "Worst Fitness": []})
             thread_data["Best Fitness"].append(best)
             thread_data["Avg Fitness"].append(avg)
@@ -325,6 +328,70 @@ def read_log_file_individual_statistics(filepath):
 
 
 
+def read_population_export(filepath):
+    # reads a population export of the SGA (see include/populationExport.h) in the binary or the json lines format
+    # returns the instance name and a list of snapshots with the generation, fitness, travel time, validity and genomes
+    with open(filepath, 'rb') as file:
+        content = file.read()
+    if not content.startswith(b'BIOAIPOP'):
+        snapshots = []
+        instance_name = None
+        for line in content.decode('utf-8').splitlines():
+            if not line:
+                continue
+            snapshot = json.loads(line)
+            instance_name = snapshot['instance']
+            individuals = snapshot['individuals']
+            snapshots.append({
+                "generation": snapshot['generation'],
+                "fitness": np.array([individual['fitness'] for individual in individuals]),
+                "travelTime": np.array([individual['travelTime'] for individual in individuals]),
+                "valid": np.array([individual['valid'] for individual in individuals], dtype=bool),
+                "genomes": [individual['genome'] for individual in individuals],
+            })
+        return instance_name, snapshots
+    offset = 8
+    version, name_length = struct.unpack_from('<II', content, offset)
+    if version != 1:
+        raise ValueError(f"Unsupported population export version {version}")
+    offset += 8
+    instance_name = content[offset:offset + name_length].decode('utf-8')
+    offset += name_length
+    snapshots = []
+    while offset < len(content):
+        generation, count = struct.unpack_from('<iI', content, offset)
+        offset += 8
+        fitness = np.empty(count)
+        travel_time = np.empty(count)
+        valid = np.empty(count, dtype=bool)
+        genomes = []
+        for index in range(count):
+            fitness[index], travel_time[index], valid[index], journeys = struct.unpack_from('<ddBH', content, offset)
+            offset += 19
+            genome = []
+            for _ in range(journeys):
+                (length,) = struct.unpack_from('<H', content, offset)
+                offset += 2
+                genome.append(list(struct.unpack_from(f'<{length}H', content, offset)))
+                offset += 2 * length
+            genomes.append(genome)
+        snapshots.append({"generation": generation, "fitness": fitness, "travelTime": travel_time, "valid": valid, "genomes": genomes})
+    return instance_name, snapshots
+
+
+def visualize_population_export(snapshots):
+    # distribution of the travel time of the valid individuals in every snapshot
+    rows = []
+    for snapshot in snapshots:
+        for travel_time in snapshot["travelTime"][snapshot["valid"]]:
+            rows.append({"Generation": snapshot["generation"], "Travel Time": travel_time})
+    df = pd.DataFrame(rows)
+    fig, ax = plt.subplots()
+    sns.boxplot(data=df, x="Generation", y="Travel Time", ax=ax)
+    plt.title("Travel time of the valid individuals per exported generation")
+    plt.savefig('./metrics/population_export.png')
+
+
 def visualize_thread_data(thread_id, thread_data):
     df = pd.DataFrame(thread_data)
     fig, ax = plt.subplots()
@@ -367,6 +434,10 @@ if __name__ == "__main__":
     plt.savefig('./metrics/trip_gant.png')
     visualizeTripsOnMap(individual.genome, problem_instance)
     plt.savefig('./metrics/trip_map.png')
+    # visualize the population snapshots if the run exported them
+    if os.path.exists('./build/population.bin'):
+        instance_name, snapshots = read_population_export('./build/population.bin')
+        visualize_population_export(snapshots)
     # read the log file
     logfile_data_genome_development = read_log_file_genome_development('./build/statistics.txt')
     logfile_data_individual_statistics = read_log_file_individual_statistics('./build/statistics.txt')
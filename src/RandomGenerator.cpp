@@ -1,7 +1,11 @@
 #include "RandomGenerator.h"
 #include <spdlog/spdlog.h>
+#include "logging.h"
 #include <iostream>
-RandomGenerator* RandomGenerator::instance = nullptr;
+#include <sstream>
+#include <stdexcept>
+thread_local RandomGenerator* RandomGenerator::instance = nullptr;
+thread_local std::unique_ptr<RandomGenerator> RandomGenerator::ownedInstance;
 
 RandomGenerator::RandomGenerator() = default;
 
@@ -9,7 +13,8 @@ auto RandomGenerator::getInstance() -> RandomGenerator &
 {
     if (instance == nullptr)
     {
-        instance = new RandomGenerator();
+        ownedInstance.reset(new RandomGenerator());
+        instance = ownedInstance.get();
     }
     return *instance;
 }
@@ -23,8 +28,7 @@ void RandomGenerator::setSeed(unsigned int seed)
     }
     else
     {
-        auto logger = spdlog::get("main_logger");
-        logger->warn("Seed already set, ignoring new seed");
+        mainLogger().warn("Seed already set, ignoring new seed");
     }
 }
 
@@ -63,6 +67,27 @@ void RandomGenerator::shuffle(std::vector<int> &elements){
     std::shuffle(elements.begin(), elements.end(), generator);
 }
 
+auto RandomGenerator::getState() const -> std::string
+{
+    std::ostringstream stateStream;
+    stateStream << generator;
+    return stateStream.str();
+}
+
+void RandomGenerator::setState(const std::string &state)
+{
+    std::istringstream stateStream(state);
+    std::mt19937_64 restored;
+    stateStream >> restored;
+    if (stateStream.fail())
+    {
+        throw std::invalid_argument("Invalid random generator state");
+    }
+    generator = restored;
+    // a restored state counts as seeded, otherwise the next draw would reseed the engine
+    isSeeded = true;
+}
+
 #ifdef TESTING_MODE
 void RandomGenerator::setInstance(RandomGenerator *instance)
 {
@@ -1,87 +1,23 @@
 #include "SGA.h"
+#include "evaluation.h"
 #include "structures.h"
 #include "utils.h"
 #include "RandomGenerator.h"
 #include <iostream>
 #include <climits>
+#include <stdexcept>
 #include <spdlog/spdlog.h>
-
-
-
-auto evaluateIndividual(Individual *individual, const ProblemInstance &problemInstance) -> void
-{
-    double combinedTripTime = 0;
-    double missingCareTimePenality = 0;
-    double capacityPenality = 0;
-    double toLateToDepotPenality = 0;
-
-    const auto &travelTime = problemInstance.travelTime;
-
-    for (const Journey &nurseJourney : individual->genome)
-    {
-        double nurseTripTime = 0;
-        double nurseTravelTime = 0;
-        int nurseUsedCapacity = 0;
-
-        for (std::size_t j = 0; j < nurseJourney.size(); j++)
-        {
-
-            // Accumulate trip time. From Depot to first patient and after that from patient to patient. (Applies when patientID == index in travel matrix)
-            int patientId = nurseJourney[j];
-            if (j == 0)
-            {
-                nurseTripTime += travelTime[0][patientId];
-                nurseTravelTime += travelTime[0][patientId];
-            }
-            else
-            {
-                nurseTripTime += travelTime[nurseJourney[j - 1]][patientId];
-                nurseTravelTime += travelTime[nurseJourney[j - 1]][patientId];
-            }
-
-            // If the triptime to the patient is lower than his time window, wait to the start ot the timewindow
-            nurseTripTime = std::max(nurseTripTime, static_cast<double>(problemInstance.patients.at(patientId).startTime));
-
-            // Nurse is caring for the patient
-            nurseTripTime += problemInstance.patients.at(patientId).careTime;
-
-            // If the nurse is arriving to late we may not have enough time to care for the patient in the time window.
-            if (nurseTripTime > problemInstance.patients.at(patientId).endTime)
-            {
-                // Use the missed caretime as a penality
-                missingCareTimePenality = nurseTripTime - problemInstance.patients.at(patientId).endTime;
-            }
-
-            // We have now cared for the patient. Add the demand to our used capacity.
-            // We dont care if we are outside of time windows. The important part ist the capacity of a trip overall
-            nurseUsedCapacity += problemInstance.patients.at(patientId).demand;
-
-            // Capacity penality
-            if (nurseUsedCapacity > problemInstance.nurseCapacity)
-            {
-                capacityPenality = (nurseUsedCapacity - problemInstance.nurseCapacity);
-            }
-        }
-
-        // add the driving time from the last patient to the depot if there is at least one patient
-        if (!nurseJourney.empty())
-        {
-            nurseTripTime += travelTime[nurseJourney.back()][0];
-            nurseTravelTime += travelTime[nurseJourney.back()][0];
-        }
-
-        // add penality if we are too late to the depot
-        toLateToDepotPenality = std::max(0.0, nurseTripTime - problemInstance.depot.returnTime);
-        combinedTripTime += nurseTravelTime;
-    }
-
-    double fitness = -combinedTripTime - capacityPenality * 100000 - missingCareTimePenality * 10000 - toLateToDepotPenality * 10000;
-
-    individual->fitness = fitness;
-    individual->capacityPenality = capacityPenality;
-    individual->missingCareTimePenality = missingCareTimePenality;
-    individual->toLateToDepotPenality = toLateToDepotPenality;
-}
+#include "logging.h"
+#include "profiler.h"
+#include "statistics.h"
+#include "fitnessCache.h"
+#include "construction.h"
+#include "checkpoint.h"
+#include "steadyState.h"
+#include "asynchronousEvolution.h"
+#include "populationExport.h"
+#include <chrono>
+#include <optional>
 
 auto initializeRandomPopulation(const ProblemInstance &problemInstance, const Config &config) -> Population
 {
@@ -121,114 +57,86 @@ auto initializeRandomPopulation(const ProblemInstance &problemInstance, const Co
             }
         }
         // Create the Individual
-        Individual individual = {genome};
-        evaluateIndividual(&individual, problemInstance);
-        pop.push_back(individual);
+        pop.push_back(Individual{genome});
     }
+    evaluatePopulation(pop, problemInstance);
     return pop;
 }
 
 auto initializeFeasiblePopulation(const ProblemInstance &problemInstance, const Config &config) -> Population
 {
-    Population pop = std::vector<Individual>();
-    pop.reserve(config.populationSize);
-    // Seed the random number generator
+    // the seeds are drawn up front so that the population only depends on the seed of the run, not on the threads
     RandomGenerator &rng = RandomGenerator::getInstance();
-
-    std::map<int, std::vector<const Patient *>> PatientsByEndTime;
-    for (const auto &[id, patient] : problemInstance.patients)
+    std::vector<std::uint64_t> seeds(config.populationSize);
+    for (std::uint64_t &seed : seeds)
     {
-        PatientsByEndTime[patient.endTime].push_back(&patient);
+        seed = static_cast<std::uint64_t>(rng.generateRandomInt(0, INT_MAX));
     }
-    std::vector<int> startTimes;
-    startTimes.reserve(PatientsByEndTime.size());
-    for (const auto &[startTime, patients] : PatientsByEndTime)
-    {
-        startTimes.push_back(startTime);
-    }
-    // sort the start times
-    std::sort(startTimes.begin(), startTimes.end());
+    const std::vector<SeedingHeuristic> heuristics = assignSeedingHeuristics(config.populationSize, config.seedingProportions);
+    Population pop = constructPopulation(problemInstance, seeds, heuristics, config.numberOfThreads, config.maxConstructionAttempts);
+    evaluatePopulation(pop, problemInstance);
+    return pop;
+}
 
-    for (int i = 0; i < config.populationSize; i++)
+namespace {
+    // Returns the indices of all individuals flagged as replaced
+    auto replacedIndices(const std::vector<bool> &replaced) -> std::vector<std::size_t>
     {
-        // copy the  PatientsByEndTime
-        std::map<int, std::vector<const Patient *>> PatientsByEndTimeCopy(PatientsByEndTime.begin(), PatientsByEndTime.end());
-        // init genome with number of nurses x empty vector
-        Genome genome = std::vector<std::vector<int>>(problemInstance.numberOfNurses);
-        int currentStartTimeIndex = 0;
-        int currentStartTime = startTimes[currentStartTimeIndex];
-        int index;
-
-        for (int j = 0; j < problemInstance.patients.size(); j++)
+        std::vector<std::size_t> indices;
+        for (std::size_t index = 0; index < replaced.size(); index++)
         {
-
-            index = rng.generateRandomInt(0, PatientsByEndTimeCopy[currentStartTime].size() - 1);
-            const Patient *patient = PatientsByEndTimeCopy[currentStartTime][index];
-            PatientsByEndTimeCopy[currentStartTime].erase(PatientsByEndTimeCopy[currentStartTime].begin() + index);
-            // insert patient in genome
-            int minDetour = INT_MAX;
-            int minDetourIndex = -1;
-            for (int k = 0; k < genome.size(); k++)
+            if (replaced[index])
             {
-                if (genome[k].empty())
-                {
-                    minDetourIndex = k;
-                    minDetour = problemInstance.travelTime[k][patient->id] + problemInstance.travelTime[patient->id][0];
-                }
-                else
-                {
-                    genome[k].push_back(patient->id);
-                    if (isJourneyValid(genome[k], problemInstance))
-                    {
-                        int detour = problemInstance.travelTime[k - 1][patient->id] + problemInstance.travelTime[patient->id][0] - problemInstance.travelTime[k - 1][0];
-                        if (detour < minDetour)
-                        {
-                            minDetour = detour;
-                            minDetourIndex = k;
-                        }
-                    }
-                    genome[k].pop_back();
-                }
+                indices.push_back(index);
             }
-            if (minDetourIndex != -1)
+        }
+        return indices;
+    }
+
+    // Operator of every application in a generation: each operator ceil(n * rate) times in order, or with adaptive
+    // selection the same number of applications with operators drawn from the adaptive probabilities
+    auto scheduleApplications(const std::vector<double> &rates, std::size_t populationSize, const AdaptiveOperatorSelection *selection) -> std::vector<std::size_t>
+    {
+        std::vector<std::size_t> schedule;
+        for (std::size_t operatorIndex = 0; operatorIndex < rates.size(); operatorIndex++)
+        {
+            schedule.insert(schedule.end(), static_cast<std::size_t>(std::ceil(populationSize * rates[operatorIndex])), operatorIndex);
+        }
+        if (selection != nullptr)
+        {
+            RandomGenerator &rng = RandomGenerator::getInstance();
+            for (std::size_t &operatorIndex : schedule)
             {
-                genome[minDetourIndex].push_back(patient->id);
+                operatorIndex = selection->selectOperator(rng.generateRandomDouble(0.0, 1.0));
             }
-            else
+        }
+        return schedule;
+    }
+
+    // Splits the fitness gained by every replaced individual between the operators applied to it
+    auto creditImprovements(AdaptiveOperatorSelection &selection, const std::vector<double> &fitnessBefore, const Population &population, const std::vector<std::vector<std::size_t>> &appliedOperators) -> void
+    {
+        for (std::size_t index = 0; index < population.size(); index++)
+        {
+            if (appliedOperators[index].empty())
             {
-                break;
+                continue;
             }
-
-            // check if the current start time is empty
-            if (PatientsByEndTimeCopy[currentStartTime].empty())
+            const double improvement = std::max(0.0, population[index].fitness - fitnessBefore[index]);
+            for (std::size_t operatorIndex : appliedOperators[index])
             {
-                // remove the current start time from the map
-                PatientsByEndTimeCopy.erase(currentStartTime);
-                // check if the map is empty
-                if (PatientsByEndTimeCopy.empty())
-                {
-                    break;
-                }
-                currentStartTimeIndex++;
-                currentStartTime = startTimes[currentStartTimeIndex];
+                selection.recordImprovement(operatorIndex, improvement / static_cast<double>(appliedOperators[index].size()));
             }
         }
-        // Create the Individual
-        if (isSolutionValid(genome, problemInstance))
-        {
-            Individual individual = {genome};
-            evaluateIndividual(&individual, problemInstance);
-            pop.push_back(individual);
-        }
-        else
-        {
-            i--;
-        }
     }
-    return pop;
+
+    auto secondsSince(std::chrono::steady_clock::time_point start) -> double
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
 }
 
-auto applyCrossover(Population &parents, CrossoverConfiguration &crossover, ProblemInstance &problemInstance) -> Population
+auto applyCrossover(Population &parents, CrossoverConfiguration &crossover, ProblemInstance &problemInstance, AdaptiveOperatorSelection *selection) -> Population
 {
     Population children = std::vector<Individual>();
     children.reserve(parents.size());
@@ -237,158 +145,408 @@ auto applyCrossover(Population &parents, CrossoverConfiguration &crossover, Prob
         children.push_back(parent);
     }
     RandomGenerator &rng = RandomGenerator::getInstance();
-
-    for (std::pair<CrossoverFunction, double> crossoverPair : crossover)
+    // children are evaluated together after all crossovers
+    std::vector<bool> replaced(children.size(), false);
+    // operators that produced each child, only tracked for the adaptive selection
+    std::vector<std::vector<std::size_t>> appliedOperators(selection != nullptr ? children.size() : 0);
+
+    std::vector<double> rates;
+    std::vector<std::string> operatorSections;
+    for (const auto &[function, rate] : crossover)
     {
-        CrossoverFunction CrossoverFunction = crossoverPair.first;
-        int numberOfCrossovers = std::ceil(parents.size() * crossoverPair.second);
-
-        for (int i = 0; i < numberOfCrossovers; i++)
+        operatorSections.push_back("crossover[" + std::to_string(rates.size()) + "]");
+        rates.push_back(rate);
+    }
+    for (std::size_t operatorIndex : scheduleApplications(rates, parents.size(), selection))
+    {
+        CrossoverFunction CrossoverFunction = crossover[operatorIndex].first;
+        int individualIndex1 = rng.generateRandomInt(0, parents.size() - 1);
+        int individualIndex2 = rng.generateRandomInt(0, parents.size() - 1);
+        while (individualIndex1 == individualIndex2)
         {
-            int individualIndex1 = rng.generateRandomInt(0, parents.size() - 1);
-            int individualIndex2 = rng.generateRandomInt(0, parents.size() - 1);
-            while (individualIndex1 == individualIndex2)
-            {
-                individualIndex2 = rng.generateRandomInt(0, parents.size() - 1);
-            }
-            Individual individual1 = parents[individualIndex1];
-            Individual individual2 = parents[individualIndex2];
-            std::pair<Genome, std::optional<Genome>> childrenGenomes = CrossoverFunction(individual1.genome, individual2.genome);
-            Individual child1 = {childrenGenomes.first};
-            evaluateIndividual(&child1, problemInstance);
-            children[individualIndex1] = child1;
+            individualIndex2 = rng.generateRandomInt(0, parents.size() - 1);
+        }
+        Individual individual1 = parents[individualIndex1];
+        Individual individual2 = parents[individualIndex2];
+        std::pair<Genome, std::optional<Genome>> childrenGenomes;
+        const auto start = std::chrono::steady_clock::now();
+        {
+            ScopedTimer timer(operatorSections[operatorIndex]);
+            childrenGenomes = CrossoverFunction(individual1.genome, individual2.genome);
+        }
+        children[individualIndex1] = Individual{childrenGenomes.first};
+        replaced[individualIndex1] = true;
+        if (childrenGenomes.second.has_value())
+        {
+            children[individualIndex2] = Individual{childrenGenomes.second.value()};
+            replaced[individualIndex2] = true;
+        }
+        if (selection != nullptr)
+        {
+            selection->recordApplication(operatorIndex, secondsSince(start));
+            appliedOperators[individualIndex1].push_back(operatorIndex);
             if (childrenGenomes.second.has_value())
             {
-                Individual child2 = {childrenGenomes.second.value()};
-                evaluateIndividual(&child2, problemInstance);
-                children[individualIndex2] = child2;
+                appliedOperators[individualIndex2].push_back(operatorIndex);
             }
         }
     }
+    evaluateIndividuals(children, replacedIndices(replaced), problemInstance);
+    if (selection != nullptr)
+    {
+        std::vector<double> fitnessBefore;
+        fitnessBefore.reserve(parents.size());
+        for (const Individual &parent : parents)
+        {
+            fitnessBefore.push_back(parent.fitness);
+        }
+        creditImprovements(*selection, fitnessBefore, children, appliedOperators);
+    }
     return children;
 }
 
-auto applyMutation(Population &population, MuationConfiguration &mutation, ProblemInstance &problemInstance) -> Population
+auto applyMutation(Population &population, MuationConfiguration &mutation, ProblemInstance &problemInstance, AdaptiveOperatorSelection *selection) -> Population
 {
-    auto main_logger = spdlog::get("main_logger");
+    spdlog::logger &logger = mainLogger();
     RandomGenerator &rng = RandomGenerator::getInstance();
-    for (std::tuple<MutationFunction, FunctionParameters, double> mutationTuple : mutation)
-    {
-        MutationFunction MutationFunction = std::get<0>(mutationTuple);
-        FunctionParameters parameters = std::get<1>(mutationTuple);
-        double mutationRate = std::get<2>(mutationTuple);
-        int numberOfMutations = std::ceil(population.size() * mutationRate);
-        for (int i = 0; i < numberOfMutations; i++)
-        {
-            int individualIndex = rng.generateRandomInt(0, population.size() - 1);
-            Individual individual = population[individualIndex];
-            main_logger->trace("Applying mutation to individual {}", individualIndex);
-            main_logger->trace("Genome before mutation: {}", fmt::join(flattenGenome(individual.genome), ", "));
-            main_logger->trace("Is genome valid: {}", isSolutionValid(individual.genome, problemInstance));
-            Genome mutatedGenome = MutationFunction(individual.genome, parameters);
-            Individual mutatedIndividual = {mutatedGenome};
-            main_logger->trace("Genome after mutation: {}", fmt::join(flattenGenome(individual.genome), ", "));
-            main_logger->trace("Is mutated genome valid: {}", isSolutionValid(mutatedIndividual.genome, problemInstance));
-            evaluateIndividual(&mutatedIndividual, problemInstance);
-            population[individualIndex] = mutatedIndividual;
+    // mutated individuals are evaluated together after all mutations
+    std::vector<bool> replaced(population.size(), false);
+    // fitness before the mutations and the operators applied to each individual, only tracked for the adaptive selection
+    std::vector<double> fitnessBefore;
+    std::vector<std::vector<std::size_t>> appliedOperators;
+    if (selection != nullptr)
+    {
+        appliedOperators.resize(population.size());
+        for (const Individual &individual : population)
+        {
+            fitnessBefore.push_back(individual.fitness);
+        }
+    }
+    std::vector<double> rates;
+    std::vector<std::string> operatorSections;
+    for (const auto &[function, parameters, rate] : mutation)
+    {
+        operatorSections.push_back("mutation[" + std::to_string(rates.size()) + "]");
+        rates.push_back(rate);
+    }
+    for (std::size_t operatorIndex : scheduleApplications(rates, population.size(), selection))
+    {
+        MutationFunction MutationFunction = std::get<0>(mutation[operatorIndex]);
+        const FunctionParameters &parameters = std::get<1>(mutation[operatorIndex]);
+        int individualIndex = rng.generateRandomInt(0, population.size() - 1);
+        Individual individual = population[individualIndex];
+        LOG_TRACE(logger, "Applying mutation to individual {}", individualIndex);
+        LOG_TRACE(logger, "Genome before mutation: {}", fmt::join(flattenGenome(individual.genome), ", "));
+        LOG_TRACE(logger, "Is genome valid: {}", isSolutionValid(individual.genome, problemInstance));
+        Genome mutatedGenome;
+        const auto start = std::chrono::steady_clock::now();
+        {
+            ScopedTimer timer(operatorSections[operatorIndex]);
+            mutatedGenome = MutationFunction(individual.genome, parameters);
+        }
+        Individual mutatedIndividual = {mutatedGenome};
+        LOG_TRACE(logger, "Genome after mutation: {}", fmt::join(flattenGenome(mutatedIndividual.genome), ", "));
+        LOG_TRACE(logger, "Is mutated genome valid: {}", isSolutionValid(mutatedIndividual.genome, problemInstance));
+        population[individualIndex] = mutatedIndividual;
+        replaced[individualIndex] = true;
+        if (selection != nullptr)
+        {
+            selection->recordApplication(operatorIndex, secondsSince(start));
+            appliedOperators[individualIndex].push_back(operatorIndex);
         }
     }
+    evaluateIndividuals(population, replacedIndices(replaced), problemInstance);
+    if (selection != nullptr)
+    {
+        creditImprovements(*selection, fitnessBefore, population, appliedOperators);
+    }
     return population;
 }
 
+// Runs parent selection, crossover, mutation and survivor selection once and returns the next population
+auto evolveGeneration(const Population &pop, Config &config, ProblemInstance &problemInstance, AdaptiveOperatorSelection *crossoverSelection, AdaptiveOperatorSelection *mutationSelection) -> Population
+{
+    const int populationSize = config.populationSize;
+    // Parent selection
+    Population parents;
+    {
+        ScopedTimer timer("parentSelection");
+        parents = config.parentSelection.first(pop, config.parentSelection.second, populationSize);
+    }
+
+    // Crossover
+    Population children;
+    {
+        ScopedTimer timer("crossover");
+        children = applyCrossover(parents, config.crossover, problemInstance, crossoverSelection);
+    }
+    // Mutation
+    {
+        ScopedTimer timer("mutation");
+        children = applyMutation(children, config.mutation, problemInstance, mutationSelection);
+    }
+    for (AdaptiveOperatorSelection *selection : {crossoverSelection, mutationSelection})
+    {
+        if (selection != nullptr)
+        {
+            selection->endGeneration();
+        }
+    }
+
+    // Survivor selection
+    Population survivors;
+    {
+        ScopedTimer timer("survivorSelection");
+        survivors = config.survivorSelection.first(pop, children, config.survivorSelection.second, populationSize);
+    }
+    return survivors;
+}
+
 Individual SGA(ProblemInstance problemInstance, Config config)
 {
-    auto main_logger = spdlog::get("main_logger");
-    main_logger->info("Starting the SGA");
-    auto statistics_logger = spdlog::get("statistics_logger");
-    const  int populationSize = config.populationSize;
+    spdlog::logger &main_logger = mainLogger();
+    main_logger.info("Starting the SGA");
+    spdlog::logger &statistics_logger = statisticsLogger();
+    if (config.asynchronousEvolution && config.adaptiveOperatorSelection)
+    {
+        // the operator selections are updated by the breeding threads, which they are not made for
+        throw std::invalid_argument("asynchronousEvolution cannot be combined with adaptiveOperatorSelection");
+    }
+    Profiler &profiler = Profiler::getInstance();
+    // like the caches below the profiler is only touched by runs that profile, or that have to switch it off
+    if (config.enableProfiling || profiler.isEnabled())
+    {
+        profiler.setEnabled(config.enableProfiling);
+        profiler.reset();
+    }
+    // the caches are shared by all runs of the process, runs without caches leave them alone so that runs on several
+    // threads (e.g. while tuning) do not reconfigure them concurrently
+    FitnessCache &fitnessCache = FitnessCache::getInstance();
+    if (config.enableFitnessCache || fitnessCache.isEnabled())
+    {
+        fitnessCache.configure(config.enableFitnessCache, config.fitnessCacheCapacity, problemInstance.instanceName);
+    }
+    JourneyCache &journeyCache = JourneyCache::getInstance();
+    if (config.enableJourneyCache || journeyCache.isEnabled())
+    {
+        journeyCache.configure(config.enableJourneyCache, config.journeyCacheCapacity, problemInstance.instanceName);
+    }
 
-    Population pop = initializeFeasiblePopulation(problemInstance, config);
-    //Population pop = initializeRandomPopulation(problemInstance, config);
-    main_logger->info("Population initialized");
-    sortPopulationByFitness(pop, false);
-    logGenome(pop[0].genome, "Best", 0);
+    RandomGenerator &rng = RandomGenerator::getInstance();
+    std::optional<AdaptiveOperatorSelection> crossoverSelection;
+    std::optional<AdaptiveOperatorSelection> mutationSelection;
+    if (config.adaptiveOperatorSelection)
+    {
+        std::vector<double> crossoverRates;
+        for (const auto &[function, rate] : config.crossover)
+        {
+            crossoverRates.push_back(rate);
+        }
+        std::vector<double> mutationRates;
+        for (const auto &[function, parameters, rate] : config.mutation)
+        {
+            mutationRates.push_back(rate);
+        }
+        if (!crossoverRates.empty())
+        {
+            crossoverSelection.emplace(crossoverRates, config.minimumOperatorProbability, config.operatorAdaptationRate);
+        }
+        if (!mutationRates.empty())
+        {
+            mutationSelection.emplace(mutationRates, config.minimumOperatorProbability, config.operatorAdaptationRate);
+        }
+    }
+    Population pop;
+    int firstGeneration = 0;
+    std::vector<GenerationStatistics> statisticsHistory;
+    if (config.resumeFromCheckpoint)
+    {
+        ScopedTimer timer("initialization");
+        Checkpoint checkpoint = readCheckpoint(config.checkpointPath);
+        if (checkpoint.instanceName != problemInstance.instanceName)
+        {
+            throw std::runtime_error("Checkpoint " + config.checkpointPath + " belongs to instance " + checkpoint.instanceName);
+        }
+        pop = std::move(checkpoint.population);
+        firstGeneration = checkpoint.generation;
+        statisticsHistory = std::move(checkpoint.statistics);
+        // restoring the generator state makes the resumed run follow the same trajectory as an uninterrupted one
+        rng.setState(checkpoint.randomState);
+        // a checkpoint of a run without adaptive operator selection has no qualities, the selection then starts anew
+        if (crossoverSelection && !checkpoint.crossoverQualities.empty())
+        {
+            crossoverSelection->setQualities(checkpoint.crossoverQualities);
+        }
+        if (mutationSelection && !checkpoint.mutationQualities.empty())
+        {
+            mutationSelection->setQualities(checkpoint.mutationQualities);
+        }
+        main_logger.info("Resumed from {} at generation {}", config.checkpointPath, firstGeneration);
+    }
+    else
+    {
+        ScopedTimer timer("initialization");
+        pop = initializeFeasiblePopulation(problemInstance, config);
+        //pop = initializeRandomPopulation(problemInstance, config);
+    }
+    // the initialization is stored as generation -1
+    profiler.endGeneration(-1);
+    main_logger.info("Population initialized");
+    GenerationStatistics initialStatistics = computeGenerationStatistics(pop, config.numberOfThreads);
+    logGenome(pop[initialStatistics.fittestIndex].genome, "Best", 0);
     //  check if population only contains valid solutions
-    bool valid = std::all_of(pop.begin(), pop.end(), [&](const Individual &individual)
-                             { return isSolutionValid(individual.genome, problemInstance); });
+    bool valid = initialStatistics.validSolutions == static_cast<int>(pop.size());
     if (valid)
     {
-        main_logger->info("The initial population only contains valid solutions");
-        std::cout << "The initial population only contains valid solutions" << '\n';
+        main_logger.info("The initial population only contains valid solutions");
+        if (config.printProgress)
+        {
+            std::cout << "The initial population only contains valid solutions" << '\n';
+        }
     }
     else
     {
-        main_logger->info("The initial population contains invalid solutions");
-        std::cout << "The initial population contains invalid solutions" << '\n';
+        main_logger.info("The initial population contains invalid solutions");
+        if (config.printProgress)
+        {
+            std::cout << "The initial population contains invalid solutions" << '\n';
+        }
     }
-    for (int currentGeneration = 0; currentGeneration < config.numberOfGenerations; currentGeneration++)
+    // the workers start after the initialization so that their seeds follow a restored generator state
+    std::optional<AsynchronousEvolution> asynchronousEvolution;
+    if (config.asynchronousEvolution)
     {
-        main_logger->info("Generation: {}", currentGeneration);
-        statistics_logger->info("Generation: {}", currentGeneration);
-        std::cout << "Generation: " << currentGeneration << '\n';
-
-        // Parent selection
-        std::cout << "SEL|";
-        Population parents = config.parentSelection.first(pop, config.parentSelection.second, populationSize);
-
-        // Crossover
-        std::cout << "CROSS|";
-        Population children = applyCrossover(parents, config.crossover, problemInstance);
-        // Mutation
-        std::cout << "MUT|";
-        children = applyMutation(children, config.mutation, problemInstance);
-
-        // Survivor selection
-        std::cout << "SURV_SEL" << '\n';
-        pop = config.survivorSelection.first(pop, children, config.survivorSelection.second, populationSize);
-
-        // calculate percentage of valid solutions
-        int validSolutions = std::count_if(pop.begin(), pop.end(), [&](const Individual &individual)
-                                          { return isSolutionValid(individual.genome, problemInstance); });
-        double percentageValid = (validSolutions / static_cast<double>(pop.size())) * 100;
-        main_logger->info("Percentage of valid solutions: {}", percentageValid);
-        statistics_logger->info("Percentage of valid solutions: {}", percentageValid);
+        asynchronousEvolution.emplace(config, problemInstance, config.numberOfThreads);
+    }
+    // a resumed run continues the export with the snapshots up to the checkpoint
+    std::optional<PopulationWriter> populationWriter;
+    if (config.populationExportInterval > 0 && config.resumeFromCheckpoint)
+    {
+        populationWriter.emplace(config.populationExportPath, config.populationExportFormat, problemInstance.instanceName, firstGeneration);
+    }
+    else if (config.populationExportInterval > 0)
+    {
+        populationWriter.emplace(config.populationExportPath, config.populationExportFormat, problemInstance.instanceName);
+    }
+    for (int currentGeneration = firstGeneration; currentGeneration < config.numberOfGenerations; currentGeneration++)
+    {
+        main_logger.info("Generation: {}", currentGeneration);
+        statistics_logger.info("Generation: {}", currentGeneration);
+        if (config.printProgress)
+        {
+            std::cout << "Generation: " << currentGeneration << '\n';
+        }
 
-        // Average fitness
-        sortPopulationByTravelTime(pop, false, problemInstance);
-        double averageTravelTime = std::accumulate(pop.begin(), pop.end(), 0.0, [problemInstance](double sum, const Individual &individual)
-                                                   { return sum + getTotalTravelTime(individual.genome, problemInstance); }) /
-                                   pop.size();
-        main_logger->info("Travel Time Best: {} Avg: {} Worst: {}", getTotalTravelTime(pop[0].genome, problemInstance), averageTravelTime, getTotalTravelTime(pop[pop.size() - 1].genome, problemInstance));
-        statistics_logger->info("Travel Time Best: {} Avg: {} Worst: {}", getTotalTravelTime(pop[0].genome, problemInstance), averageTravelTime, getTotalTravelTime(pop[pop.size() - 1].genome, problemInstance));
-        std::cout << "Travel Time Best: " << getTotalTravelTime(pop[0].genome, problemInstance) << " Avg: " << averageTravelTime << " Worst: " << getTotalTravelTime(pop[pop.size() - 1].genome, problemInstance) << " Percentage of valid solutions: " << percentageValid << '\n';
+        if (asynchronousEvolution)
+        {
+            ScopedTimer timer("asynchronous");
+            asynchronousEvolution->evolveGeneration(pop);
+        }
+        else if (config.steadyState)
+        {
+            ScopedTimer timer("steadyState");
+            evolveSteadyState(pop, config, problemInstance, crossoverSelection ? &*crossoverSelection : nullptr, mutationSelection ? &*mutationSelection : nullptr);
+        }
+        else
+        {
+            pop = evolveGeneration(pop, config, problemInstance, crossoverSelection ? &*crossoverSelection : nullptr, mutationSelection ? &*mutationSelection : nullptr);
+        }
 
-        // Genome logging: 
-        // Log the Genome of the fastest individual
-        logGenome(pop[0].genome, "Fastest", currentGeneration);
-        // Log the Genome of the fittest individual
-        sortPopulationByFitness(pop, false);
-        logGenome(pop[0].genome, "Fittest", currentGeneration);
+        {
+            ScopedTimer timer("statistics");
+            GenerationStatistics statistics = computeGenerationStatistics(pop, config.numberOfThreads);
+            main_logger.info("Percentage of valid solutions: {}", statistics.percentageValid);
+            statistics_logger.info("Percentage of valid solutions: {}", statistics.percentageValid);
+
+            main_logger.info("Travel Time Best: {} Avg: {} Worst: {} StdDev: {}", statistics.bestTravelTime, statistics.averageTravelTime, statistics.worstTravelTime, statistics.travelTimeStandardDeviation);
+            statistics_logger.info("Travel Time Best: {} Avg: {} Worst: {} StdDev: {}", statistics.bestTravelTime, statistics.averageTravelTime, statistics.worstTravelTime, statistics.travelTimeStandardDeviation);
+            if (config.printProgress)
+            {
+                std::cout << "Travel Time Best: " << statistics.bestTravelTime << " Avg: " << statistics.averageTravelTime << " Worst: " << statistics.worstTravelTime << " Percentage of valid solutions: " << statistics.percentageValid << '\n';
+            }
 
-        // Log the fitness of the best, average and worst individual
-        double averageFitness = std::accumulate(pop.begin(), pop.end(), 0.0, [](double sum, const Individual &individual)
-                                                { return sum + individual.fitness; }) /
-                                pop.size();
-        main_logger->info("Fitness Best: {} Avg: {} Worst: {}", pop[0].fitness, averageFitness, pop[pop.size() - 1].fitness);
-        statistics_logger->info("Fitness Best: {} Avg: {} Worst: {}", pop[0].fitness, averageFitness, pop[pop.size() - 1].fitness);
-        
-        main_logger->flush();
-    }
-    sortPopulationByFitness(pop, false);
-    valid = isSolutionValid(pop[0].genome, problemInstance);
+            // Genome logging: 
+            // Log the Genome of the fastest individual
+            logGenome(pop[statistics.fastestIndex].genome, "Fastest", currentGeneration);
+            // Log the Genome of the fittest individual
+            logGenome(pop[statistics.fittestIndex].genome, "Fittest", currentGeneration);
+
+            // Log the fitness of the best, average and worst individual
+            main_logger.info("Fitness Best: {} Avg: {} Worst: {} StdDev: {}", statistics.bestFitness, statistics.averageFitness, statistics.worstFitness, statistics.fitnessStandardDeviation);
+            statistics_logger.info("Fitness Best: {} Avg: {} Worst: {} StdDev: {}", statistics.bestFitness, statistics.averageFitness, statistics.worstFitness, statistics.fitnessStandardDeviation);
+            statistics_logger.info("Unique genomes: {} ({}%)", statistics.uniqueGenomes, statistics.uniqueGenomeRatio * 100);
+            statistics_logger.info("Average broken pairs distance to the fittest: {}", statistics.averageDistanceToFittest);
+            if (fitnessCache.isEnabled())
+            {
+                statistics_logger.info("Fitness cache hits: {} misses: {} hit rate: {}%", fitnessCache.hits(), fitnessCache.misses(), fitnessCache.hitRate() * 100);
+            }
+            if (journeyCache.isEnabled())
+            {
+                statistics_logger.info("Journey cache hits: {} misses: {} hit rate: {}%", journeyCache.hits(), journeyCache.misses(), journeyCache.hitRate() * 100);
+            }
+            if (crossoverSelection)
+            {
+                statistics_logger.info("Crossover probabilities: {}", fmt::join(crossoverSelection->getProbabilities(), ", "));
+            }
+            if (mutationSelection)
+            {
+                statistics_logger.info("Mutation probabilities: {}", fmt::join(mutationSelection->getProbabilities(), ", "));
+            }
+            statisticsHistory.push_back(statistics);
+        }
+        const int completedGenerations = currentGeneration + 1;
+        if (config.checkpointInterval > 0 && (completedGenerations % config.checkpointInterval == 0 || completedGenerations == config.numberOfGenerations))
+        {
+            ScopedTimer timer("checkpoint");
+            writeCheckpoint({problemInstance.instanceName, completedGenerations, rng.getState(), pop, statisticsHistory,
+                             crossoverSelection ? crossoverSelection->getQualities() : std::vector<double>(),
+                             mutationSelection ? mutationSelection->getQualities() : std::vector<double>()},
+                            config.checkpointPath);
+            main_logger.info("Checkpoint of generation {} written to {}", completedGenerations, config.checkpointPath);
+        }
+        if (populationWriter && (completedGenerations % config.populationExportInterval == 0 || completedGenerations == config.numberOfGenerations))
+        {
+            ScopedTimer timer("populationExport");
+            populationWriter->writeSnapshot(completedGenerations, pop);
+        }
+        profiler.endGeneration(currentGeneration);
+    }
+    if (config.enableProfiling)
+    {
+        profiler.exportJson(config.profileOutputPrefix + ".json");
+        profiler.exportCsv(config.profileOutputPrefix + ".csv");
+        main_logger.info("Run profile exported to {}.json and {}.csv", config.profileOutputPrefix, config.profileOutputPrefix);
+    }
+    if (fitnessCache.isEnabled())
+    {
+        main_logger.info("Fitness cache hits: {} misses: {} hit rate: {}%", fitnessCache.hits(), fitnessCache.misses(), fitnessCache.hitRate() * 100);
+    }
+    if (journeyCache.isEnabled())
+    {
+        main_logger.info("Journey cache hits: {} misses: {} hit rate: {}%", journeyCache.hits(), journeyCache.misses(), journeyCache.hitRate() * 100);
+    }
+    const Individual &fittest = *std::max_element(pop.begin(), pop.end(), [](const Individual &individualA, const Individual &individualB)
+                                                  { return individualA.fitness < individualB.fitness; });
+    valid = fittest.valid;
 
-    double totalTravelTime = getTotalTravelTime(pop[0].genome, problemInstance);
+    double totalTravelTime = fittest.travelTime;
     if(valid)
     {
-        main_logger->info("The solution is valid and fullfills {}% of the benchmark", (problemInstance.benchmark / totalTravelTime) * 100);
-        std::cout << "The solution is valid and fullfills " << ((problemInstance.benchmark / totalTravelTime) * 100) << "% of the benchmark" << '\n';
+        main_logger.info("The solution is valid and fullfills {}% of the benchmark", (problemInstance.benchmark / totalTravelTime) * 100);
+        if (config.printProgress)
+        {
+            std::cout << "The solution is valid and fullfills " << ((problemInstance.benchmark / totalTravelTime) * 100) << "% of the benchmark" << '\n';
+        }
     }
     else
     {
-        main_logger->info("The solution is invalid and fullfills {}% of the benchmark", (problemInstance.benchmark / totalTravelTime) * 100);
-        std::cout << "The solution is invalid and fullfills " << ((problemInstance.benchmark / totalTravelTime) * 100) << "% of the benchmark" << '\n';
+        main_logger.info("The solution is invalid and fullfills {}% of the benchmark", (problemInstance.benchmark / totalTravelTime) * 100);
+        if (config.printProgress)
+        {
+            std::cout << "The solution is invalid and fullfills " << ((problemInstance.benchmark / totalTravelTime) * 100) << "% of the benchmark" << '\n';
+        }
     }
     
 
-    return pop[0];
+    return fittest;
 }
\ No newline at end of file
@@ -0,0 +1,177 @@
+#include "asynchronousEvolution.h"
+#include <chrono>
+#include <climits>
+#include <exception>
+#include "profiler.h"
+#include "RandomGenerator.h"
+
+namespace {
+    // tasks a worker holds at once, one to work on and one to start right after it
+    constexpr int TASKS_IN_FLIGHT = 2;
+
+    // Yields at first and sleeps after a while, so waiting threads do not take the core of a working one
+    void backoff(int &idleRounds)
+    {
+        if (++idleRounds < 64)
+        {
+            std::this_thread::yield();
+        }
+        else
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+}
+
+AsynchronousEvolution::AsynchronousEvolution(Config &config, const ProblemInstance &problemInstance, int numberOfWorkers)
+    : config(config), problemInstance(problemInstance)
+{
+    RandomGenerator &rng = RandomGenerator::getInstance();
+    for (int index = 0; index < numberOfWorkers; index++)
+    {
+        workers.push_back(std::make_unique<Worker>(TASKS_IN_FLIGHT));
+    }
+    // the seeds are drawn before any worker starts so that they only depend on the state of the calling thread
+    std::vector<unsigned int> seeds;
+    for (int index = 0; index < numberOfWorkers; index++)
+    {
+        seeds.push_back(static_cast<unsigned int>(rng.generateRandomInt(0, INT_MAX)));
+    }
+    for (int index = 0; index < numberOfWorkers; index++)
+    {
+        Worker &worker = *workers[index];
+        worker.thread = std::thread(&AsynchronousEvolution::runWorker, this, std::ref(worker), seeds[index]);
+    }
+}
+
+AsynchronousEvolution::~AsynchronousEvolution()
+{
+    stopping.store(true, std::memory_order_release);
+    for (std::unique_ptr<Worker> &worker : workers)
+    {
+        worker->thread.join();
+    }
+}
+
+void AsynchronousEvolution::runWorker(Worker &worker, unsigned int seed)
+{
+    // the random generator is thread local, the operators of this worker draw from this one
+    RandomGenerator::getInstance().setSeed(seed);
+    int idleRounds = 0;
+    while (!stopping.load(std::memory_order_acquire))
+    {
+        Task task;
+        if (!worker.tasks.pop(task))
+        {
+            backoff(idleRounds);
+            continue;
+        }
+        idleRounds = 0;
+        Result result;
+        try
+        {
+            Population parents = {std::move(task.parent1), std::move(task.parent2)};
+            result.offspring = breedOffspring(parents, 0, 1, config, problemInstance);
+            // the parents go back with the children, crowding measures against them
+            task.parent1 = std::move(parents[0]);
+            task.parent2 = std::move(parents[1]);
+            result.task = std::move(task);
+        }
+        catch (...)
+        {
+            worker.error = std::current_exception();
+            worker.failed.store(true, std::memory_order_release);
+            return;
+        }
+        // the integrator takes the results of every task it hands out, so the queue is only full for a moment
+        while (!worker.results.push(std::move(result)))
+        {
+            if (stopping.load(std::memory_order_acquire))
+            {
+                return;
+            }
+            backoff(idleRounds);
+        }
+    }
+}
+
+void AsynchronousEvolution::integrate(Population &population, Result &result)
+{
+    Offspring &offspring = result.offspring;
+    const Task &task = result.task;
+    const std::size_t slots[2] = {task.index1, task.index2};
+    if (config.steadyStateReplacement != ReplacementStrategy::Crowding)
+    {
+        for (std::size_t &parent : offspring.parents)
+        {
+            parent = slots[parent];
+        }
+        insertOffspring(population, offspring, config.steadyStateReplacement);
+        return;
+    }
+    // the slots may hold other individuals by now, so the children are paired with the parents they were bred from
+    // and only compete for a slot that was not replaced since the task was created
+    const std::uint64_t versions[2] = {task.version1, task.version2};
+    std::vector<std::size_t> parents = offspring.parents;
+    if (offspring.children.size() == 2 && slots[parents[0]] != slots[parents[1]])
+    {
+        const Genome &parentA = parents[0] == 0 ? task.parent1.genome : task.parent2.genome;
+        const Genome &parentB = parents[1] == 0 ? task.parent1.genome : task.parent2.genome;
+        parents = crowdingParents(parentA, parentB, offspring);
+    }
+    for (std::size_t child = 0; child < offspring.children.size(); child++)
+    {
+        const std::size_t slot = slots[parents[child]];
+        if (slotVersions[slot] == versions[parents[child]] && replaceIfFitter(population, slot, offspring.children[child]) > 0)
+        {
+            slotVersions[slot]++;
+        }
+    }
+}
+
+void AsynchronousEvolution::evolveGeneration(Population &population)
+{
+    slotVersions.resize(population.size());
+    const int pairsPerGeneration = (config.populationSize + 1) / 2;
+    int integratedPairs = 0;
+    int idleRounds = 0;
+    while (integratedPairs < pairsPerGeneration)
+    {
+        bool progressed = false;
+        for (std::unique_ptr<Worker> &worker : workers)
+        {
+            if (worker->failed.load(std::memory_order_acquire))
+            {
+                std::rethrow_exception(worker->error);
+            }
+            Result result;
+            while (integratedPairs < pairsPerGeneration && worker->results.pop(result))
+            {
+                worker->inFlight--;
+                integratedPairs++;
+                progressed = true;
+                ScopedTimer timer("replacement");
+                integrate(population, result);
+            }
+            // tasks left in flight at the end of the generation are integrated in the next one
+            while (worker->inFlight < TASKS_IN_FLIGHT)
+            {
+                const auto [parent1, parent2] = selectParentPair(population, config.steadyStateTournamentSize);
+                if (!worker->tasks.push({population[parent1], population[parent2], parent1, parent2, slotVersions[parent1], slotVersions[parent2]}))
+                {
+                    break;
+                }
+                worker->inFlight++;
+                progressed = true;
+            }
+        }
+        if (progressed)
+        {
+            idleRounds = 0;
+        }
+        else
+        {
+            backoff(idleRounds);
+        }
+    }
+}
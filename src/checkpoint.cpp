@@ -0,0 +1,206 @@
+#include "checkpoint.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+namespace {
+    constexpr char CHECKPOINT_MAGIC[8] = {'B', 'I', 'O', 'A', 'I', 'C', 'K', 'P'};
+    constexpr std::uint32_t CHECKPOINT_VERSION = 2;
+
+    template <typename T>
+    auto writeValue(std::ostream &stream, const T &value) -> void
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        stream.write(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    auto readValue(std::istream &stream) -> T
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        T value;
+        if (!stream.read(reinterpret_cast<char *>(&value), sizeof(T)))
+        {
+            throw std::runtime_error("Checkpoint is truncated");
+        }
+        return value;
+    }
+
+    // Reads a count and checks that the rest of the file can hold that many elements of at least elementSize bytes,
+    // so a corrupt count is reported instead of being used to allocate
+    auto readCount(std::istream &stream, std::uint64_t fileSize, std::uint64_t elementSize) -> std::size_t
+    {
+        const auto count = readValue<std::uint64_t>(stream);
+        const auto remaining = fileSize - static_cast<std::uint64_t>(stream.tellg());
+        if (count > remaining / elementSize)
+        {
+            throw std::runtime_error("Checkpoint is truncated");
+        }
+        return static_cast<std::size_t>(count);
+    }
+
+    auto writeString(std::ostream &stream, const std::string &value) -> void
+    {
+        writeValue<std::uint64_t>(stream, value.size());
+        stream.write(value.data(), static_cast<std::streamsize>(value.size()));
+    }
+
+    auto readString(std::istream &stream, std::uint64_t fileSize) -> std::string
+    {
+        std::string value(readCount(stream, fileSize, 1), '\0');
+        if (!stream.read(value.data(), static_cast<std::streamsize>(value.size())))
+        {
+            throw std::runtime_error("Checkpoint is truncated");
+        }
+        return value;
+    }
+
+    auto writeDoubles(std::ostream &stream, const std::vector<double> &values) -> void
+    {
+        writeValue<std::uint64_t>(stream, values.size());
+        stream.write(reinterpret_cast<const char *>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(double)));
+    }
+
+    auto readDoubles(std::istream &stream, std::uint64_t fileSize) -> std::vector<double>
+    {
+        std::vector<double> values(readCount(stream, fileSize, sizeof(double)));
+        if (!stream.read(reinterpret_cast<char *>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(double))))
+        {
+            throw std::runtime_error("Checkpoint is truncated");
+        }
+        return values;
+    }
+
+    auto writeIndividual(std::ostream &stream, const Individual &individual) -> void
+    {
+        writeValue<std::uint64_t>(stream, individual.genome.size());
+        for (const Journey &journey : individual.genome)
+        {
+            writeValue<std::uint64_t>(stream, journey.size());
+            stream.write(reinterpret_cast<const char *>(journey.data()), static_cast<std::streamsize>(journey.size() * sizeof(int)));
+        }
+        writeValue(stream, individual.fitness);
+        writeValue(stream, individual.missingCareTimePenality);
+        writeValue(stream, individual.capacityPenality);
+        writeValue(stream, individual.toLateToDepotPenality);
+        writeValue(stream, individual.travelTime);
+        writeValue<std::uint64_t>(stream, individual.journeyValid.size());
+        for (bool journeyValid : individual.journeyValid)
+        {
+            writeValue<std::uint8_t>(stream, journeyValid);
+        }
+        writeValue<std::uint8_t>(stream, individual.valid);
+    }
+
+    // an individual without journeys still holds its genome and journey counts, five doubles and valid
+    constexpr std::uint64_t MINIMUM_INDIVIDUAL_SIZE = 2 * sizeof(std::uint64_t) + 5 * sizeof(double) + sizeof(std::uint8_t);
+
+    auto readIndividual(std::istream &stream, std::uint64_t fileSize) -> Individual
+    {
+        Individual individual;
+        individual.genome.resize(readCount(stream, fileSize, sizeof(std::uint64_t)));
+        for (Journey &journey : individual.genome)
+        {
+            journey.resize(readCount(stream, fileSize, sizeof(int)));
+            if (!stream.read(reinterpret_cast<char *>(journey.data()), static_cast<std::streamsize>(journey.size() * sizeof(int))))
+            {
+                throw std::runtime_error("Checkpoint is truncated");
+            }
+        }
+        individual.fitness = readValue<double>(stream);
+        individual.missingCareTimePenality = readValue<double>(stream);
+        individual.capacityPenality = readValue<double>(stream);
+        individual.toLateToDepotPenality = readValue<double>(stream);
+        individual.travelTime = readValue<double>(stream);
+        individual.journeyValid.resize(readCount(stream, fileSize, sizeof(std::uint8_t)));
+        for (std::size_t journey = 0; journey < individual.journeyValid.size(); journey++)
+        {
+            individual.journeyValid[journey] = readValue<std::uint8_t>(stream) != 0;
+        }
+        individual.valid = readValue<std::uint8_t>(stream) != 0;
+        return individual;
+    }
+}
+
+auto writeCheckpoint(const Checkpoint &checkpoint, const std::string &path) -> void
+{
+    const std::string temporaryPath = path + ".tmp";
+    {
+        std::ofstream stream(temporaryPath, std::ios::binary | std::ios::trunc);
+        if (!stream)
+        {
+            throw std::runtime_error("Could not open " + temporaryPath + " for writing");
+        }
+        stream.write(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+        writeValue(stream, CHECKPOINT_VERSION);
+        // the statistics are stored as raw structs, their size guards against reading them with another layout
+        writeValue<std::uint32_t>(stream, sizeof(GenerationStatistics));
+        writeString(stream, checkpoint.instanceName);
+        writeValue<std::int32_t>(stream, checkpoint.generation);
+        writeString(stream, checkpoint.randomState);
+        writeValue<std::uint64_t>(stream, checkpoint.population.size());
+        for (const Individual &individual : checkpoint.population)
+        {
+            writeIndividual(stream, individual);
+        }
+        writeValue<std::uint64_t>(stream, checkpoint.statistics.size());
+        for (const GenerationStatistics &statistics : checkpoint.statistics)
+        {
+            writeValue(stream, statistics);
+        }
+        writeDoubles(stream, checkpoint.crossoverQualities);
+        writeDoubles(stream, checkpoint.mutationQualities);
+        stream.flush();
+        if (!stream)
+        {
+            throw std::runtime_error("Could not write " + temporaryPath);
+        }
+    }
+    if (std::rename(temporaryPath.c_str(), path.c_str()) != 0)
+    {
+        throw std::runtime_error("Could not move " + temporaryPath + " to " + path);
+    }
+}
+
+auto readCheckpoint(const std::string &path) -> Checkpoint
+{
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream)
+    {
+        throw std::runtime_error("Could not open " + path);
+    }
+    char magic[sizeof(CHECKPOINT_MAGIC)];
+    if (!stream.read(magic, sizeof(magic)) || !std::equal(std::begin(magic), std::end(magic), std::begin(CHECKPOINT_MAGIC)))
+    {
+        throw std::runtime_error(path + " is not a checkpoint");
+    }
+    if (readValue<std::uint32_t>(stream) != CHECKPOINT_VERSION || readValue<std::uint32_t>(stream) != sizeof(GenerationStatistics))
+    {
+        throw std::runtime_error(path + " was written by an incompatible build");
+    }
+    // the counts in the file are checked against its size before anything is allocated for them
+    stream.seekg(0, std::ios::end);
+    const auto fileSize = static_cast<std::uint64_t>(stream.tellg());
+    stream.seekg(sizeof(CHECKPOINT_MAGIC) + 2 * sizeof(std::uint32_t));
+    Checkpoint checkpoint;
+    checkpoint.instanceName = readString(stream, fileSize);
+    checkpoint.generation = readValue<std::int32_t>(stream);
+    checkpoint.randomState = readString(stream, fileSize);
+    checkpoint.population.resize(readCount(stream, fileSize, MINIMUM_INDIVIDUAL_SIZE));
+    for (Individual &individual : checkpoint.population)
+    {
+        individual = readIndividual(stream, fileSize);
+    }
+    checkpoint.statistics.resize(readCount(stream, fileSize, sizeof(GenerationStatistics)));
+    for (GenerationStatistics &statistics : checkpoint.statistics)
+    {
+        statistics = readValue<GenerationStatistics>(stream);
+    }
+    checkpoint.crossoverQualities = readDoubles(stream, fileSize);
+    checkpoint.mutationQualities = readDoubles(stream, fileSize);
+    return checkpoint;
+}
@@ -0,0 +1,494 @@
+#include "configLoader.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <fstream>
+#include <set>
+#include <stdexcept>
+#include <type_traits>
+#include "crossover.h"
+#include "mutation.h"
+#include "parentSelection.h"
+#include "survivorSelection.h"
+#include "utils.h"
+
+using json = nlohmann::json;
+
+namespace {
+    auto typeName(ParameterType type) -> std::string
+    {
+        switch (type)
+        {
+        case ParameterType::Int:
+            return "an integer";
+        case ParameterType::Double:
+            return "a number";
+        case ParameterType::String:
+            return "a string";
+        default:
+            return "a bool";
+        }
+    }
+
+    // Returns true if the json value can be read as the given type, integers are accepted for doubles
+    auto hasType(const json &value, ParameterType type) -> bool
+    {
+        switch (type)
+        {
+        case ParameterType::Int:
+            return value.is_number_integer();
+        case ParameterType::Double:
+            return value.is_number();
+        case ParameterType::String:
+            return value.is_string();
+        default:
+            return value.is_boolean();
+        }
+    }
+
+    auto checkType(const json &value, ParameterType type, const std::string &context) -> void
+    {
+        if (!hasType(value, type))
+        {
+            throw std::invalid_argument(context + " must be " + typeName(type));
+        }
+    }
+
+    auto boundText(double bound, ParameterType type) -> std::string
+    {
+        return type == ParameterType::Int ? std::to_string(static_cast<long long>(bound)) : json(bound).dump();
+    }
+
+    auto rangeText(const ParameterRule &rule) -> std::string
+    {
+        const std::string minimum = boundText(rule.minimum, rule.type);
+        if (std::isinf(rule.maximum))
+        {
+            return (rule.minimumExcluded ? "greater than " : "at least ") + minimum;
+        }
+        return std::string("in ") + (rule.minimumExcluded ? "(" : "[") + minimum + ", " + boundText(rule.maximum, rule.type) + "]";
+    }
+
+    // Rejects numbers outside the range of the rule and strings that are not among its allowed values, the type has to
+    // be checked before
+    auto checkValue(const json &value, const ParameterRule &rule, const std::string &context) -> void
+    {
+        if (rule.type == ParameterType::Int || rule.type == ParameterType::Double)
+        {
+            const double number = value.get<double>();
+            const bool aboveMinimum = rule.minimumExcluded ? number > rule.minimum : number >= rule.minimum;
+            if (!aboveMinimum || number > rule.maximum)
+            {
+                throw std::invalid_argument(context + " must be " + rangeText(rule));
+            }
+        }
+        else if (rule.type == ParameterType::String && !rule.allowedValues.empty() &&
+                 std::find(rule.allowedValues.begin(), rule.allowedValues.end(), value.get<std::string>()) == rule.allowedValues.end())
+        {
+            std::string allowed;
+            for (const std::string &allowedValue : rule.allowedValues)
+            {
+                allowed += (allowed.empty() ? "" : ", ") + allowedValue;
+            }
+            throw std::invalid_argument(context + " must be one of " + allowed);
+        }
+    }
+
+    // Rejects integers that do not fit the type they are read as, json holds them with 64 bits
+    template <typename T>
+    auto checkFits(const json &value, const std::string &context) -> void
+    {
+        if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>)
+        {
+            const double number = value.get<double>();
+            if (number < static_cast<double>(std::numeric_limits<T>::lowest()) || number > static_cast<double>(std::numeric_limits<T>::max()))
+            {
+                throw std::invalid_argument(context + " is out of range");
+            }
+        }
+    }
+
+    // Rejects every key of the object that is not in the allowed keys
+    auto checkKeys(const json &object, const std::set<std::string> &allowedKeys, const std::string &context) -> void
+    {
+        if (!object.is_object())
+        {
+            throw std::invalid_argument(context + " must be an object");
+        }
+        for (const auto &[key, value] : object.items())
+        {
+            if (allowedKeys.count(key) == 0)
+            {
+                throw std::invalid_argument("Unknown key " + key + " in " + context);
+            }
+        }
+    }
+
+    template <typename T>
+    auto valueOr(const json &object, const std::string &key, const ParameterRule &rule, T fallback) -> T
+    {
+        auto value = object.find(key);
+        if (value == object.end())
+        {
+            return fallback;
+        }
+        checkType(*value, rule.type, key);
+        checkValue(*value, rule, key);
+        checkFits<T>(*value, key);
+        return value->get<T>();
+    }
+
+    template <typename T>
+    auto valueOr(const json &object, const std::string &key, ParameterType type, T fallback) -> T
+    {
+        return valueOr<T>(object, key, ParameterRule{type}, fallback);
+    }
+
+    // Builds the function parameters of an operator from its json object, all keys except name and probability are
+    // parameters of the operator
+    template <typename Function>
+    auto loadOperator(const json &object, const std::map<std::string, RegisteredOperator<Function>> &registry, const std::string &kind, bool hasProbability, const ProblemInstance &problemInstance, FunctionParameters &parameters) -> Function
+    {
+        if (!object.is_object() || !object.contains("name") || !object.at("name").is_string())
+        {
+            throw std::invalid_argument("Every " + kind + " needs a name");
+        }
+        const std::string name = object.at("name").get<std::string>();
+        auto entry = registry.find(name);
+        if (entry == registry.end())
+        {
+            throw std::invalid_argument("Unknown " + kind + " " + name);
+        }
+        const RegisteredOperator<Function> &registered = entry->second;
+        for (const auto &item : object.items())
+        {
+            const std::string &key = item.key();
+            const json &value = item.value();
+            if (key == "name" || (hasProbability && key == "probability"))
+            {
+                continue;
+            }
+            auto parameter = registered.parameters.find(key);
+            if (parameter == registered.parameters.end())
+            {
+                throw std::invalid_argument("Unknown parameter " + key + " of " + kind + " " + name);
+            }
+            const std::string context = "Parameter " + key + " of " + kind + " " + name;
+            checkType(value, parameter->second.type, context);
+            checkValue(value, parameter->second, context);
+            switch (parameter->second.type)
+            {
+            case ParameterType::Int:
+                checkFits<int>(value, context);
+                parameters[key] = value.get<int>();
+                break;
+            case ParameterType::Double:
+                parameters[key] = value.get<double>();
+                break;
+            case ParameterType::String:
+                parameters[key] = value.get<std::string>();
+                break;
+            default:
+                parameters[key] = value.get<bool>();
+                break;
+            }
+        }
+        for (const std::string &required : registered.required)
+        {
+            if (parameters.find(required) == parameters.end())
+            {
+                throw std::invalid_argument("Missing parameter " + required + " of " + kind + " " + name);
+            }
+        }
+        if (registered.needsProblemInstance)
+        {
+            parameters.insert_or_assign("problem_instance", problemInstance);
+        }
+        return registered.function;
+    }
+
+    auto probabilityOf(const json &object, const std::string &kind) -> double
+    {
+        if (!object.contains("probability"))
+        {
+            throw std::invalid_argument("Every " + kind + " needs a probability");
+        }
+        checkType(object.at("probability"), ParameterType::Double, "The probability of a " + kind);
+        const double probability = object.at("probability").get<double>();
+        if (probability < 0.0 || probability > 1.0)
+        {
+            throw std::invalid_argument("The probability of a " + kind + " must be in [0, 1]");
+        }
+        return probability;
+    }
+
+    auto parseInt(const std::string &option, const std::string &value) -> int
+    {
+        std::size_t consumed = 0;
+        int number = 0;
+        try
+        {
+            number = std::stoi(value, &consumed);
+        }
+        catch (const std::exception &)
+        {
+            consumed = 0;
+        }
+        if (consumed == 0 || consumed != value.size())
+        {
+            throw std::invalid_argument(option + " expects an integer, got " + value);
+        }
+        return number;
+    }
+}
+
+auto parentSelectionRegistry() -> const std::map<std::string, RegisteredOperator<ParentSelectionFunction>> &
+{
+    static const std::map<std::string, RegisteredOperator<ParentSelectionFunction>> registry = {
+        {"rouletteWheelSelection", {rouletteWheelSelection}},
+        {"tournamentSelection", {tournamentSelection, {{"tournamentSize", {.type = ParameterType::Int, .minimum = 1}}, {"tournamentProbability", {.type = ParameterType::Double, .minimum = 0, .maximum = 1}}}, {"tournamentSize", "tournamentProbability"}}}};
+    return registry;
+}
+
+auto crossoverRegistry() -> const std::map<std::string, RegisteredOperator<CrossoverFunction>> &
+{
+    static const std::map<std::string, RegisteredOperator<CrossoverFunction>> registry = {
+        {"order1Crossover", {order1Crossover}},
+        {"partiallyMappedCrossover", {partiallyMappedCrossover}},
+        {"edgeRecombination", {edgeRecombination}}};
+    return registry;
+}
+
+auto mutationRegistry() -> const std::map<std::string, RegisteredOperator<MutationFunction>> &
+{
+    const ParameterRule segmentLength = {.type = ParameterType::Int, .minimum = 1};
+    const ParameterRule improvementStrategy = {.type = ParameterType::String, .allowedValues = {"first", "best"}};
+    const std::map<std::string, ParameterRule> localSearchParameters = {{"relocate", {ParameterType::Bool}}, {"exchange", {ParameterType::Bool}}, {"two_opt_star", {ParameterType::Bool}}, {"cross_exchange", {ParameterType::Bool}}, {"max_segment_length", segmentLength}};
+    const std::map<std::string, ParameterRule> ruinAndRecreateParameters = {
+        {"removal_fraction", {.type = ParameterType::Double, .minimum = 0, .maximum = 1, .minimumExcluded = true}},
+        {"regret", {.type = ParameterType::Int, .minimum = 2}},
+        {"removal_strategy", {.type = ParameterType::String, .allowedValues = {"mixed", "random", "related", "worst", "route"}}}};
+    static const std::map<std::string, RegisteredOperator<MutationFunction>> registry = {
+        {"reassignOnePatient", {reassignOnePatient}},
+        {"swapWithinJourney", {swapWithinJourney}},
+        {"swapBetweenJourneys", {swapBetweenJourneys}},
+        {"insertWithinJourney", {insertWithinJourney}},
+        {"inverseJourney", {inverseJourney}},
+        {"moveToNeighbour", {moveToNeighbour, {}, {}, true}},
+        {"2opt", {twoOpt, {{"improvement_strategy", improvementStrategy}}, {}, true}},
+        {"twoOpt", {twoOpt, {{"improvement_strategy", improvementStrategy}}, {}, true}},
+        {"interRouteLocalSearch", {interRouteLocalSearch, localSearchParameters, {}, true}},
+        {"orOpt", {orOpt, {{"max_segment_length", segmentLength}}, {}, true}},
+        {"ruinAndRecreate", {ruinAndRecreate, ruinAndRecreateParameters, {}, true}},
+        {"splitJourney", {splitJourney, {}, {}, true}},
+        {"insertionHeuristic", {insertionHeuristic, {}, {}, true}}};
+    return registry;
+}
+
+auto survivorSelectionRegistry() -> const std::map<std::string, RegisteredOperator<SurvivorSelectionFunction>> &
+{
+    static const std::map<std::string, RegisteredOperator<SurvivorSelectionFunction>> registry = {
+        {"fullReplacement", {fullReplacement}},
+        {"rouletteWheelReplacement", {rouletteWheelReplacement}},
+        {"elitismWithFill", {elitismWithFill, {{"elitism_percentage", {.type = ParameterType::Double, .minimum = 0, .maximum = 1}}, {"fillFunction", {.type = ParameterType::String, .allowedValues = {"rouletteWheel"}}}}, {"elitism_percentage", "fillFunction"}}},
+        // a comparison window of 0 compares with the whole population
+        {"biasedFitnessReplacement", {biasedFitnessReplacement, {{"number_of_closest", {.type = ParameterType::Int, .minimum = 1}}, {"number_of_elites", {.type = ParameterType::Int, .minimum = 0}}, {"comparison_window", {.type = ParameterType::Int, .minimum = 0}}}}}};
+    return registry;
+}
+
+auto readConfigurationFile(const std::string &path) -> json
+{
+    std::ifstream inputFileStream(path);
+    if (!inputFileStream)
+    {
+        throw std::runtime_error("Could not open configuration " + path);
+    }
+    try
+    {
+        return json::parse(inputFileStream);
+    }
+    catch (const json::parse_error &error)
+    {
+        throw std::runtime_error("Could not parse configuration " + path + ": " + error.what());
+    }
+}
+
+auto loadRunConfiguration(const json &configuration, const InstanceLoader &instanceLoader) -> RunConfiguration
+{
+    checkKeys(configuration, {"instance", "seed", "numberOfNeighbours", "populationSize", "generations", "initialPopulationDistributePatientsEqually", "parentSelection", "crossovers", "mutations", "survivorSelection", "numberOfThreads", "maxConstructionAttempts", "seedingProportions", "enableProfiling", "profileOutputPrefix", "enableFitnessCache", "fitnessCacheCapacity", "enableJourneyCache", "journeyCacheCapacity", "checkpointInterval", "checkpointPath", "resumeFromCheckpoint", "adaptiveOperatorSelection", "minimumOperatorProbability", "operatorAdaptationRate", "steadyState", "steadyStateReplacement", "steadyStateTournamentSize", "asynchronousEvolution", "populationExportInterval", "populationExportPath", "populationExportFormat"}, "the configuration");
+    for (const char *key : {"instance", "populationSize", "generations", "parentSelection", "survivorSelection"})
+    {
+        if (!configuration.contains(key))
+        {
+            throw std::invalid_argument("The configuration needs " + std::string(key));
+        }
+    }
+    RunConfiguration run;
+    run.instanceFile = valueOr<std::string>(configuration, "instance", ParameterType::String, "");
+    run.seed = static_cast<unsigned int>(valueOr<long long>(configuration, "seed", {.type = ParameterType::Int, .minimum = 0, .maximum = UINT_MAX}, 4711));
+    const int numberOfNeighbours = valueOr<int>(configuration, "numberOfNeighbours", {.type = ParameterType::Int, .minimum = 0}, 20);
+    const int populationSize = valueOr<int>(configuration, "populationSize", ParameterType::Int, 0);
+    const int numberOfGenerations = valueOr<int>(configuration, "generations", ParameterType::Int, 0);
+    if (populationSize < 2)
+    {
+        throw std::invalid_argument("populationSize must be at least 2");
+    }
+    if (numberOfGenerations < 0)
+    {
+        throw std::invalid_argument("generations must not be negative");
+    }
+    run.problemInstance = std::make_unique<ProblemInstance>(instanceLoader(run.instanceFile, numberOfNeighbours));
+    const ProblemInstance &problemInstance = *run.problemInstance;
+
+    // the deque keeps the parameters in place while operators are added, Config only holds references to them
+    FunctionParameters &parentSelectionParameters = run.functionParameters.emplace_back();
+    ParentSelectionFunction parentSelection = loadOperator(configuration.at("parentSelection"), parentSelectionRegistry(), "parent selection", false, problemInstance, parentSelectionParameters);
+    FunctionParameters &survivorSelectionParameters = run.functionParameters.emplace_back();
+    SurvivorSelectionFunction survivorSelection = loadOperator(configuration.at("survivorSelection"), survivorSelectionRegistry(), "survivor selection", false, problemInstance, survivorSelectionParameters);
+
+    CrossoverConfiguration crossover;
+    for (const json &crossoverJson : configuration.value("crossovers", json::array()))
+    {
+        // crossovers take no parameters, the map only collects them for validation
+        FunctionParameters unused;
+        crossover.emplace_back(loadOperator(crossoverJson, crossoverRegistry(), "crossover", true, problemInstance, unused), probabilityOf(crossoverJson, "crossover"));
+    }
+    MuationConfiguration mutation;
+    for (const json &mutationJson : configuration.value("mutations", json::array()))
+    {
+        FunctionParameters &parameters = run.functionParameters.emplace_back();
+        MutationFunction function = loadOperator(mutationJson, mutationRegistry(), "mutation", true, problemInstance, parameters);
+        mutation.emplace_back(function, parameters, probabilityOf(mutationJson, "mutation"));
+    }
+
+    const bool distributeEqually = valueOr<bool>(configuration, "initialPopulationDistributePatientsEqually", ParameterType::Bool, false);
+    run.config = std::make_unique<Config>(populationSize, numberOfGenerations, distributeEqually,
+                                          ParentSelectionConfiguration{parentSelection, parentSelectionParameters},
+                                          crossover, mutation,
+                                          SurvivorSelectionConfiguration{survivorSelection, survivorSelectionParameters});
+    Config &config = *run.config;
+    config.numberOfThreads = valueOr<int>(configuration, "numberOfThreads", ParameterType::Int, config.numberOfThreads);
+    config.maxConstructionAttempts = valueOr<int>(configuration, "maxConstructionAttempts", {.type = ParameterType::Int, .minimum = 1}, config.maxConstructionAttempts);
+    if (configuration.contains("seedingProportions"))
+    {
+        const json &seeding = configuration.at("seedingProportions");
+        checkKeys(seeding, {"savings", "solomonI1", "sweep"}, "seedingProportions");
+        const ParameterRule proportion = {.type = ParameterType::Double, .minimum = 0, .maximum = 1};
+        config.seedingProportions.savings = valueOr<double>(seeding, "savings", proportion, 0.0);
+        config.seedingProportions.solomonI1 = valueOr<double>(seeding, "solomonI1", proportion, 0.0);
+        config.seedingProportions.sweep = valueOr<double>(seeding, "sweep", proportion, 0.0);
+        if (config.seedingProportions.savings + config.seedingProportions.solomonI1 + config.seedingProportions.sweep > 1.0 + 1e-9)
+        {
+            throw std::invalid_argument("seedingProportions must sum to at most 1");
+        }
+    }
+    config.enableProfiling = valueOr<bool>(configuration, "enableProfiling", ParameterType::Bool, config.enableProfiling);
+    config.profileOutputPrefix = valueOr<std::string>(configuration, "profileOutputPrefix", ParameterType::String, config.profileOutputPrefix);
+    config.enableFitnessCache = valueOr<bool>(configuration, "enableFitnessCache", ParameterType::Bool, config.enableFitnessCache);
+    config.fitnessCacheCapacity = valueOr<std::size_t>(configuration, "fitnessCacheCapacity", {.type = ParameterType::Int, .minimum = 0}, config.fitnessCacheCapacity);
+    config.enableJourneyCache = valueOr<bool>(configuration, "enableJourneyCache", ParameterType::Bool, config.enableJourneyCache);
+    config.journeyCacheCapacity = valueOr<std::size_t>(configuration, "journeyCacheCapacity", {.type = ParameterType::Int, .minimum = 0}, config.journeyCacheCapacity);
+    config.checkpointInterval = valueOr<int>(configuration, "checkpointInterval", {.type = ParameterType::Int, .minimum = 0}, config.checkpointInterval);
+    config.checkpointPath = valueOr<std::string>(configuration, "checkpointPath", ParameterType::String, config.checkpointPath);
+    config.resumeFromCheckpoint = valueOr<bool>(configuration, "resumeFromCheckpoint", ParameterType::Bool, config.resumeFromCheckpoint);
+    config.adaptiveOperatorSelection = valueOr<bool>(configuration, "adaptiveOperatorSelection", ParameterType::Bool, config.adaptiveOperatorSelection);
+    config.minimumOperatorProbability = valueOr<double>(configuration, "minimumOperatorProbability", {.type = ParameterType::Double, .minimum = 0, .maximum = 1}, config.minimumOperatorProbability);
+    config.operatorAdaptationRate = valueOr<double>(configuration, "operatorAdaptationRate", {.type = ParameterType::Double, .minimum = 0, .maximum = 1, .minimumExcluded = true}, config.operatorAdaptationRate);
+    config.steadyState = valueOr<bool>(configuration, "steadyState", ParameterType::Bool, config.steadyState);
+    const std::map<std::string, ReplacementStrategy> replacementStrategies = {{"worst", ReplacementStrategy::Worst}, {"random", ReplacementStrategy::Random}, {"crowding", ReplacementStrategy::Crowding}};
+    const std::string replacement = valueOr<std::string>(configuration, "steadyStateReplacement", ParameterType::String, "worst");
+    if (replacementStrategies.count(replacement) == 0)
+    {
+        throw std::invalid_argument("steadyStateReplacement must be worst, random or crowding");
+    }
+    config.steadyStateReplacement = replacementStrategies.at(replacement);
+    config.steadyStateTournamentSize = valueOr<int>(configuration, "steadyStateTournamentSize", ParameterType::Int, config.steadyStateTournamentSize);
+    config.asynchronousEvolution = valueOr<bool>(configuration, "asynchronousEvolution", ParameterType::Bool, config.asynchronousEvolution);
+    config.populationExportInterval = valueOr<int>(configuration, "populationExportInterval", ParameterType::Int, config.populationExportInterval);
+    config.populationExportPath = valueOr<std::string>(configuration, "populationExportPath", ParameterType::String, config.populationExportPath);
+    const std::map<std::string, PopulationExportFormat> exportFormats = {{"binary", PopulationExportFormat::Binary}, {"jsonl", PopulationExportFormat::JsonLines}};
+    const std::string exportFormat = valueOr<std::string>(configuration, "populationExportFormat", ParameterType::String, "binary");
+    if (exportFormats.count(exportFormat) == 0)
+    {
+        throw std::invalid_argument("populationExportFormat must be binary or jsonl");
+    }
+    config.populationExportFormat = exportFormats.at(exportFormat);
+    if (config.numberOfThreads < 1)
+    {
+        throw std::invalid_argument("numberOfThreads must be at least 1");
+    }
+    if (config.populationExportInterval < 0)
+    {
+        throw std::invalid_argument("populationExportInterval must not be negative");
+    }
+    if (config.steadyStateTournamentSize < 1)
+    {
+        throw std::invalid_argument("steadyStateTournamentSize must be at least 1");
+    }
+    if (config.asynchronousEvolution && config.adaptiveOperatorSelection)
+    {
+        throw std::invalid_argument("asynchronousEvolution cannot be combined with adaptiveOperatorSelection");
+    }
+    // every operator keeps the minimum probability, so together they may not take up the whole probability
+    const std::size_t largestOperatorCount = std::max(crossover.size(), mutation.size());
+    if (config.adaptiveOperatorSelection && config.minimumOperatorProbability * static_cast<double>(largestOperatorCount) >= 1.0)
+    {
+        throw std::invalid_argument("minimumOperatorProbability must be below 1 / number of operators");
+    }
+    return run;
+}
+
+auto loadRunConfiguration(const json &configuration) -> RunConfiguration
+{
+    return loadRunConfiguration(configuration, [](const std::string &instanceFile, int numberOfNeighbours)
+                                { return loadInstance(instanceFile, numberOfNeighbours); });
+}
+
+auto parseCommandLine(const std::vector<std::string> &arguments) -> CommandLineOptions
+{
+    // options that take a value and the configuration key they set
+    const std::map<std::string, std::string> integerOptions = {{"--seed", "seed"}, {"--threads", "numberOfThreads"}, {"--population", "populationSize"}, {"--generations", "generations"}, {"--checkpoint-interval", "checkpointInterval"}};
+    CommandLineOptions options;
+    for (std::size_t index = 0; index < arguments.size(); index++)
+    {
+        const std::string &option = arguments[index];
+        if (option == "--resume")
+        {
+            options.overrides["resumeFromCheckpoint"] = true;
+            continue;
+        }
+        const bool takesValue = option == "--config" || option == "--instance" || option == "--tune" || integerOptions.count(option) > 0;
+        if (!takesValue)
+        {
+            throw std::invalid_argument("Unknown option " + option);
+        }
+        if (index + 1 == arguments.size())
+        {
+            throw std::invalid_argument(option + " needs a value");
+        }
+        const std::string &value = arguments[++index];
+        if (option == "--config")
+        {
+            options.configurationPath = value;
+        }
+        else if (option == "--instance")
+        {
+            options.overrides["instance"] = value;
+        }
+        else if (option == "--tune")
+        {
+            options.tuningPath = value;
+        }
+        else
+        {
+            options.overrides[integerOptions.at(option)] = parseInt(option, value);
+        }
+    }
+    return options;
+}
+
+auto commandLineUsage() -> std::string
+{
+    return "Usage: BIOAI-2 [--config <path>] [--instance <file>] [--seed <n>] [--threads <n>] [--population <n>] "
+           "[--generations <n>] [--checkpoint-interval <n>] [--resume] [--tune <path>]";
+}
@@ -0,0 +1,458 @@
+#include "construction.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <numbers>
+#include <stdexcept>
+#include <thread>
+#include "localSearch.h"
+#include "ruinAndRecreate.h"
+
+namespace {
+    // what an append needs to know about a journey
+    struct JourneyTail
+    {
+        int lastPatientId = 0;
+        double departureTime = 0;
+        int load = 0;
+    };
+
+    // Tries to append every patient, returns the patients that did not fit anywhere
+    auto appendAll(const ProblemInstance &problemInstance, const EndTimeGroups &groups, std::mt19937_64 &engine, Genome &genome) -> std::vector<int>
+    {
+        const auto &travelTime = problemInstance.travelTime;
+        genome.assign(problemInstance.numberOfNurses, Journey());
+        std::vector<JourneyTail> tails(problemInstance.numberOfNurses);
+        std::vector<int> unplaced;
+        std::vector<int> group;
+        for (const std::vector<int> &patientsOfGroup : groups)
+        {
+            group = patientsOfGroup;
+            std::shuffle(group.begin(), group.end(), engine);
+            for (int patientId : group)
+            {
+                const Patient &patient = problemInstance.patientTable[patientId];
+                double minDetour = std::numeric_limits<double>::infinity();
+                int bestNurse = -1;
+                double bestDeparture = 0;
+                bool emptyJourneyRated = false;
+                for (int nurse = 0; nurse < problemInstance.numberOfNurses; nurse++)
+                {
+                    const JourneyTail &tail = tails[nurse];
+                    // all empty journeys are alike, rating one of them is enough
+                    if (genome[nurse].empty())
+                    {
+                        if (emptyJourneyRated)
+                        {
+                            continue;
+                        }
+                        emptyJourneyRated = true;
+                    }
+                    const double departure = std::max(tail.departureTime + travelTime[tail.lastPatientId][patientId], static_cast<double>(patient.startTime)) + patient.careTime;
+                    if (departure > patient.endTime || tail.load + patient.demand > problemInstance.nurseCapacity || departure + travelTime[patientId][0] > problemInstance.depot.returnTime)
+                    {
+                        continue;
+                    }
+                    const double detour = travelTime[tail.lastPatientId][patientId] + travelTime[patientId][0] - travelTime[tail.lastPatientId][0];
+                    if (detour < minDetour)
+                    {
+                        minDetour = detour;
+                        bestNurse = nurse;
+                        bestDeparture = departure;
+                    }
+                }
+                if (bestNurse < 0)
+                {
+                    unplaced.push_back(patientId);
+                    continue;
+                }
+                genome[bestNurse].push_back(patientId);
+                tails[bestNurse] = {patientId, bestDeparture, tails[bestNurse].load + patient.demand};
+            }
+        }
+        return unplaced;
+    }
+
+    // All patient ids of the instance in ascending order
+    auto sortedPatientIds(const ProblemInstance &problemInstance) -> std::vector<int>
+    {
+        std::vector<int> patientIds;
+        patientIds.reserve(problemInstance.patients.size());
+        for (const auto &[id, patient] : problemInstance.patients)
+        {
+            patientIds.push_back(id);
+        }
+        std::sort(patientIds.begin(), patientIds.end());
+        return patientIds;
+    }
+
+    // Returns the cheapest feasible position to insert the patient and its detour, position -1 if there is none
+    auto cheapestFeasiblePosition(const Journey &journey, const RouteSchedule &schedule, int patientId, const ProblemInstance &problemInstance) -> std::pair<int, double>
+    {
+        const auto &travelTime = problemInstance.travelTime;
+        int bestPosition = -1;
+        double bestCost = std::numeric_limits<double>::infinity();
+        for (int position = 0; position <= static_cast<int>(journey.size()); position++)
+        {
+            const int before = position > 0 ? journey[position - 1] : 0;
+            const int after = position < static_cast<int>(journey.size()) ? journey[position] : 0;
+            const double cost = travelTime[before][patientId] + travelTime[patientId][after] - travelTime[before][after];
+            if (cost < bestCost && isInsertionFeasible(journey, schedule, position, patientId, problemInstance))
+            {
+                bestPosition = position;
+                bestCost = cost;
+            }
+        }
+        return {bestPosition, bestCost};
+    }
+}
+
+auto groupPatientsByEndTime(const ProblemInstance &problemInstance) -> EndTimeGroups
+{
+    std::map<int, std::vector<int>> patientsByEndTime;
+    for (const auto &[id, patient] : problemInstance.patients)
+    {
+        patientsByEndTime[patient.endTime].push_back(id);
+    }
+    EndTimeGroups groups;
+    groups.reserve(patientsByEndTime.size());
+    for (auto &[endTime, patients] : patientsByEndTime)
+    {
+        // the unordered_map iteration order is not portable, the shuffle has to start from a fixed order
+        std::sort(patients.begin(), patients.end());
+        groups.push_back(std::move(patients));
+    }
+    return groups;
+}
+
+auto constructGenome(const ProblemInstance &problemInstance, const EndTimeGroups &groups, std::mt19937_64 &engine, int maxAttempts) -> Genome
+{
+    Genome best;
+    std::vector<int> bestUnplaced;
+    Genome genome;
+    for (int attempt = 0; attempt < std::max(maxAttempts, 1); attempt++)
+    {
+        std::vector<int> unplaced = appendAll(problemInstance, groups, engine, genome);
+        if (attempt == 0 || unplaced.size() < bestUnplaced.size())
+        {
+            best = genome;
+            bestUnplaced = std::move(unplaced);
+        }
+        if (bestUnplaced.empty())
+        {
+            return best;
+        }
+    }
+    regretInsertion(best, bestUnplaced, problemInstance, 2);
+    return best;
+}
+
+auto savingsGenome(const ProblemInstance &problemInstance, std::mt19937_64 &engine) -> Genome
+{
+    struct Saving
+    {
+        double value;
+        int from;
+        int to;
+    };
+    const auto &travelTime = problemInstance.travelTime;
+    std::uniform_real_distribution<double> shape(0.6, 1.4);
+    std::uniform_real_distribution<double> noise(0.95, 1.05);
+    const double lambda = shape(engine);
+    const std::vector<int> patientIds = sortedPatientIds(problemInstance);
+
+    std::vector<Saving> savings;
+    savings.reserve(patientIds.size() * patientIds.size());
+    for (int from : patientIds)
+    {
+        for (int to : patientIds)
+        {
+            if (from == to)
+            {
+                continue;
+            }
+            const double value = (travelTime[from][0] + travelTime[0][to] - lambda * travelTime[from][to]) * noise(engine);
+            if (value > 0)
+            {
+                savings.push_back({value, from, to});
+            }
+        }
+    }
+    std::sort(savings.begin(), savings.end(), [](const Saving &a, const Saving &b)
+              { return a.value > b.value || (a.value == b.value && std::pair(a.from, a.to) < std::pair(b.from, b.to)); });
+
+    // journeys are indexed by the patient they started with, routeOf maps each patient to its journey
+    std::vector<Journey> journeys(problemInstance.patientTable.size());
+    std::vector<int> loads(problemInstance.patientTable.size(), 0);
+    std::vector<int> routeOf(problemInstance.patientTable.size(), -1);
+    for (int id : patientIds)
+    {
+        journeys[id] = {id};
+        loads[id] = problemInstance.patientTable[id].demand;
+        routeOf[id] = id;
+    }
+    RouteSchedule schedule;
+    Journey joined;
+    for (const Saving &saving : savings)
+    {
+        const int first = routeOf[saving.from];
+        const int second = routeOf[saving.to];
+        if (first == second || journeys[first].back() != saving.from || journeys[second].front() != saving.to ||
+            loads[first] + loads[second] > problemInstance.nurseCapacity)
+        {
+            continue;
+        }
+        joined = journeys[first];
+        joined.insert(joined.end(), journeys[second].begin(), journeys[second].end());
+        buildRouteSchedule(joined, problemInstance, schedule);
+        if (!schedule.timeFeasible)
+        {
+            continue;
+        }
+        for (int patientId : journeys[second])
+        {
+            routeOf[patientId] = first;
+        }
+        journeys[first].swap(joined);
+        journeys[second].clear();
+        loads[first] += loads[second];
+    }
+
+    // the longest journeys get a nurse, the patients of the others are repaired
+    std::vector<Journey> built;
+    for (Journey &journey : journeys)
+    {
+        if (!journey.empty())
+        {
+            built.push_back(std::move(journey));
+        }
+    }
+    std::stable_sort(built.begin(), built.end(), [](const Journey &a, const Journey &b)
+                     { return a.size() > b.size(); });
+    Genome genome(problemInstance.numberOfNurses);
+    std::vector<int> unplaced;
+    for (std::size_t index = 0; index < built.size(); index++)
+    {
+        if (index < genome.size())
+        {
+            genome[index] = std::move(built[index]);
+        }
+        else
+        {
+            unplaced.insert(unplaced.end(), built[index].begin(), built[index].end());
+        }
+    }
+    regretInsertion(genome, unplaced, problemInstance, 2);
+    return genome;
+}
+
+auto solomonI1Genome(const ProblemInstance &problemInstance, std::mt19937_64 &engine) -> Genome
+{
+    const auto &travelTime = problemInstance.travelTime;
+    const auto &patientTable = problemInstance.patientTable;
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    // mu = 1 as in Solomon's paper, the other parameters are randomized for diversity
+    const double alpha1 = unit(engine);
+    const double alpha2 = 1.0 - alpha1;
+    const double lambda = 1.0 + unit(engine);
+    const bool seedByDistance = unit(engine) < 0.5;
+
+    // time the nurse starts caring at location, the depot has no time window
+    auto beginTime = [&](int location, double arrival)
+    {
+        return location == 0 ? arrival : std::max(arrival, static_cast<double>(patientTable[location].startTime));
+    };
+
+    std::vector<int> unrouted = sortedPatientIds(problemInstance);
+    Genome genome(problemInstance.numberOfNurses);
+    RouteSchedule schedule;
+    for (Journey &journey : genome)
+    {
+        if (unrouted.empty())
+        {
+            break;
+        }
+        auto seed = std::max_element(unrouted.begin(), unrouted.end(), [&](int a, int b)
+                                     { return seedByDistance ? travelTime[0][a] < travelTime[0][b] : patientTable[a].endTime > patientTable[b].endTime; });
+        journey.push_back(*seed);
+        unrouted.erase(seed);
+
+        while (!unrouted.empty())
+        {
+            buildRouteSchedule(journey, problemInstance, schedule);
+            std::size_t bestIndex = 0;
+            int bestPosition = -1;
+            double bestCriterion = std::numeric_limits<double>::lowest();
+            for (std::size_t index = 0; index < unrouted.size(); index++)
+            {
+                const int patientId = unrouted[index];
+                const Patient &patient = patientTable[patientId];
+                int position = -1;
+                double minCost = std::numeric_limits<double>::infinity();
+                for (int candidate = 0; candidate <= static_cast<int>(journey.size()); candidate++)
+                {
+                    const int before = candidate > 0 ? journey[candidate - 1] : 0;
+                    const int after = candidate < static_cast<int>(journey.size()) ? journey[candidate] : 0;
+                    const double departure = candidate > 0 ? schedule.departureTimes[candidate - 1] : 0.0;
+                    const double detour = travelTime[before][patientId] + travelTime[patientId][after] - travelTime[before][after];
+                    const double departureOfPatient = beginTime(patientId, departure + travelTime[before][patientId]) + patient.careTime;
+                    const double delay = beginTime(after, departureOfPatient + travelTime[patientId][after]) - beginTime(after, departure + travelTime[before][after]);
+                    const double cost = alpha1 * detour + alpha2 * delay;
+                    if (cost < minCost && isInsertionFeasible(journey, schedule, candidate, patientId, problemInstance))
+                    {
+                        minCost = cost;
+                        position = candidate;
+                    }
+                }
+                if (position < 0)
+                {
+                    continue;
+                }
+                const double criterion = lambda * travelTime[0][patientId] - minCost;
+                if (criterion > bestCriterion)
+                {
+                    bestCriterion = criterion;
+                    bestIndex = index;
+                    bestPosition = position;
+                }
+            }
+            if (bestPosition < 0)
+            {
+                break;
+            }
+            journey.insert(journey.begin() + bestPosition, unrouted[bestIndex]);
+            unrouted.erase(unrouted.begin() + bestIndex);
+        }
+    }
+    regretInsertion(genome, unrouted, problemInstance, 2);
+    return genome;
+}
+
+auto sweepGenome(const ProblemInstance &problemInstance, std::mt19937_64 &engine) -> Genome
+{
+    constexpr double fullCircle = 2 * std::numbers::pi;
+    std::uniform_real_distribution<double> angle(0.0, fullCircle);
+    const double startAngle = angle(engine);
+    const bool clockwise = std::bernoulli_distribution(0.5)(engine);
+
+    std::vector<std::pair<double, int>> order;
+    for (int patientId : sortedPatientIds(problemInstance))
+    {
+        const Patient &patient = problemInstance.patientTable[patientId];
+        const double polarAngle = std::atan2(patient.yCoord - problemInstance.depot.yCoord, patient.xCoord - problemInstance.depot.xCoord);
+        double swept = std::fmod(polarAngle - startAngle + 2 * fullCircle, fullCircle);
+        if (clockwise)
+        {
+            swept = std::fmod(fullCircle - swept, fullCircle);
+        }
+        order.emplace_back(swept, patientId);
+    }
+    std::sort(order.begin(), order.end());
+
+    Genome genome(problemInstance.numberOfNurses);
+    if (genome.empty())
+    {
+        return genome;
+    }
+    std::vector<int> unplaced;
+    RouteSchedule schedule;
+    std::size_t nurse = 0;
+    buildRouteSchedule(genome[nurse], problemInstance, schedule);
+    for (const auto &[swept, patientId] : order)
+    {
+        if (schedule.load + problemInstance.patientTable[patientId].demand > problemInstance.nurseCapacity && nurse + 1 < genome.size())
+        {
+            nurse++;
+            buildRouteSchedule(genome[nurse], problemInstance, schedule);
+        }
+        const auto [position, cost] = cheapestFeasiblePosition(genome[nurse], schedule, patientId, problemInstance);
+        if (position < 0)
+        {
+            unplaced.push_back(patientId);
+            continue;
+        }
+        genome[nurse].insert(genome[nurse].begin() + position, patientId);
+        buildRouteSchedule(genome[nurse], problemInstance, schedule);
+    }
+    regretInsertion(genome, unplaced, problemInstance, 2);
+    return genome;
+}
+
+auto assignSeedingHeuristics(int populationSize, const SeedingProportions &proportions) -> std::vector<SeedingHeuristic>
+{
+    if (proportions.savings < 0 || proportions.solomonI1 < 0 || proportions.sweep < 0 ||
+        proportions.savings + proportions.solomonI1 + proportions.sweep > 1.0 + 1e-9)
+    {
+        throw std::invalid_argument("Seeding proportions must be non negative and sum to at most 1");
+    }
+    std::vector<SeedingHeuristic> heuristics;
+    heuristics.reserve(std::max(populationSize, 0));
+    for (const auto &[heuristic, proportion] : {std::pair(SeedingHeuristic::Savings, proportions.savings),
+                                                std::pair(SeedingHeuristic::SolomonI1, proportions.solomonI1),
+                                                std::pair(SeedingHeuristic::Sweep, proportions.sweep)})
+    {
+        const int count = static_cast<int>(std::floor(proportion * populationSize + 1e-9));
+        heuristics.insert(heuristics.end(), count, heuristic);
+    }
+    heuristics.resize(std::max(populationSize, 0), SeedingHeuristic::EndTime);
+    return heuristics;
+}
+
+auto constructPopulation(const ProblemInstance &problemInstance, const std::vector<std::uint64_t> &seeds, int numberOfThreads, int maxAttempts) -> Population
+{
+    return constructPopulation(problemInstance, seeds, std::vector<SeedingHeuristic>(seeds.size(), SeedingHeuristic::EndTime), numberOfThreads, maxAttempts);
+}
+
+auto constructPopulation(const ProblemInstance &problemInstance, const std::vector<std::uint64_t> &seeds, const std::vector<SeedingHeuristic> &heuristics, int numberOfThreads, int maxAttempts) -> Population
+{
+    if (heuristics.size() != seeds.size())
+    {
+        throw std::invalid_argument("Every seed needs a seeding heuristic");
+    }
+    const EndTimeGroups groups = groupPatientsByEndTime(problemInstance);
+    Population population(seeds.size());
+    auto constructRange = [&](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t index = begin; index < end; index++)
+        {
+            std::mt19937_64 engine(seeds[index]);
+            switch (heuristics[index])
+            {
+            case SeedingHeuristic::Savings:
+                population[index].genome = savingsGenome(problemInstance, engine);
+                break;
+            case SeedingHeuristic::SolomonI1:
+                population[index].genome = solomonI1Genome(problemInstance, engine);
+                break;
+            case SeedingHeuristic::Sweep:
+                population[index].genome = sweepGenome(problemInstance, engine);
+                break;
+            default:
+                population[index].genome = constructGenome(problemInstance, groups, engine, maxAttempts);
+                break;
+            }
+        }
+    };
+
+    const std::size_t numberOfChunks = std::clamp<std::size_t>(numberOfThreads, 1, std::max<std::size_t>(seeds.size(), 1));
+    if (numberOfChunks == 1)
+    {
+        constructRange(0, seeds.size());
+        return population;
+    }
+    const std::size_t chunkSize = (seeds.size() + numberOfChunks - 1) / numberOfChunks;
+    std::vector<std::thread> threads;
+    threads.reserve(numberOfChunks);
+    for (std::size_t chunk = 0; chunk < numberOfChunks; chunk++)
+    {
+        const std::size_t begin = std::min(chunk * chunkSize, seeds.size());
+        const std::size_t end = std::min(begin + chunkSize, seeds.size());
+        threads.emplace_back(constructRange, begin, end);
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+    return population;
+}
@@ -0,0 +1,131 @@
+#include "diversity.h"
+#include <algorithm>
+#include <unordered_set>
+#include "genomeHash.h"
+
+namespace {
+    // Returns one more than the largest id in the genome
+    auto locationsOf(const Genome &genome) -> int
+    {
+        int maxId = 0;
+        for (const Journey &journey : genome)
+        {
+            for (int patientId : journey)
+            {
+                maxId = std::max(maxId, patientId);
+            }
+        }
+        return maxId + 1;
+    }
+}
+
+auto buildAdjacency(const Genome &genome, int numberOfLocations) -> GenomeAdjacency
+{
+    GenomeAdjacency adjacency;
+    adjacency.successor.assign(numberOfLocations, -1);
+    adjacency.predecessor.assign(numberOfLocations, -1);
+    for (const Journey &journey : genome)
+    {
+        int previous = 0;
+        for (int patientId : journey)
+        {
+            adjacency.predecessor[patientId] = previous;
+            if (previous != 0)
+            {
+                adjacency.successor[previous] = patientId;
+            }
+            previous = patientId;
+            adjacency.numberOfPatients++;
+        }
+        if (previous != 0)
+        {
+            adjacency.successor[previous] = 0;
+        }
+    }
+    return adjacency;
+}
+
+auto brokenPairsDistance(const GenomeAdjacency &a, const GenomeAdjacency &b) -> double
+{
+    if (a.numberOfPatients == 0)
+    {
+        return 0.0;
+    }
+    const std::size_t shared = std::min(a.successor.size(), b.successor.size());
+    int brokenPairs = 0;
+    for (std::size_t patientId = 1; patientId < a.successor.size(); patientId++)
+    {
+        const int successor = a.successor[patientId];
+        if (successor < 0)
+        {
+            continue;
+        }
+        if (patientId >= shared)
+        {
+            brokenPairs++;
+            continue;
+        }
+        if (successor != b.successor[patientId] && successor != b.predecessor[patientId])
+        {
+            brokenPairs++;
+        }
+        // the depot edges are not covered by the successors, a journey start is broken if b visits the patient mid journey
+        if (a.predecessor[patientId] == 0 && b.predecessor[patientId] > 0 && b.successor[patientId] > 0)
+        {
+            brokenPairs++;
+        }
+    }
+    return brokenPairs / static_cast<double>(a.numberOfPatients);
+}
+
+auto brokenPairsDistance(const Genome &a, const Genome &b) -> double
+{
+    const int numberOfLocations = std::max(locationsOf(a), locationsOf(b));
+    return brokenPairsDistance(buildAdjacency(a, numberOfLocations), buildAdjacency(b, numberOfLocations));
+}
+
+auto canonicalGenomeHash(const Genome &genome) -> std::uint64_t
+{
+    // journey hashes of nurse 0 summed up do not depend on the order of the journeys
+    std::uint64_t hash = 0;
+    for (const Journey &journey : genome)
+    {
+        hash += hashJourney(journey, 0);
+    }
+    return mixHash(hash);
+}
+
+auto removeDuplicates(Population &population) -> Population
+{
+    std::unordered_set<std::uint64_t> seen;
+    seen.reserve(population.size());
+    Population duplicates;
+    auto end = std::stable_partition(population.begin(), population.end(), [&seen](const Individual &individual)
+                                     { return seen.insert(canonicalGenomeHash(individual.genome)).second; });
+    duplicates.assign(std::make_move_iterator(end), std::make_move_iterator(population.end()));
+    population.erase(end, population.end());
+    return duplicates;
+}
+
+auto averageDistanceTo(const Population &population, std::size_t index) -> double
+{
+    if (population.size() < 2 || index >= population.size())
+    {
+        return 0.0;
+    }
+    int numberOfLocations = 0;
+    for (const Individual &individual : population)
+    {
+        numberOfLocations = std::max(numberOfLocations, locationsOf(individual.genome));
+    }
+    const GenomeAdjacency reference = buildAdjacency(population[index].genome, numberOfLocations);
+    double distanceSum = 0.0;
+    for (std::size_t other = 0; other < population.size(); other++)
+    {
+        if (other != index)
+        {
+            distanceSum += brokenPairsDistance(buildAdjacency(population[other].genome, numberOfLocations), reference);
+        }
+    }
+    return distanceSum / static_cast<double>(population.size() - 1);
+}
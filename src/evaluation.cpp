@@ -0,0 +1,437 @@
+#include "evaluation.h"
+#include <algorithm>
+#include "utils.h"
+#include "profiler.h"
+#include "fitnessCache.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define BIOAI_HAS_AVX2_KERNEL 1
+#else
+#define BIOAI_HAS_AVX2_KERNEL 0
+#endif
+
+auto evaluateJourney(const Journey &nurseJourney, const ProblemInstance &problemInstance) -> JourneyEvaluation
+{
+    JourneyEvaluation evaluation;
+    if (nurseJourney.empty())
+    {
+        return evaluation;
+    }
+    const auto &travelTime = problemInstance.travelTime;
+    double nurseTripTime = 0;
+    int previousPatientId = 0;
+
+    for (int patientId : nurseJourney)
+    {
+        const Patient &patient = problemInstance.patientTable[patientId];
+
+        // Accumulate trip time. From Depot to first patient and after that from patient to patient. (Applies when patientID == index in travel matrix)
+        nurseTripTime += travelTime[previousPatientId][patientId];
+        evaluation.travelTime += travelTime[previousPatientId][patientId];
+
+        // If the triptime to the patient is lower than his time window, wait to the start ot the timewindow
+        nurseTripTime = std::max(nurseTripTime, static_cast<double>(patient.startTime));
+
+        // Nurse is caring for the patient
+        nurseTripTime += patient.careTime;
+
+        // If the nurse is arriving to late we may not have enough time to care for the patient in the time window.
+        if (nurseTripTime > patient.endTime)
+        {
+            // Use the missed caretime as a penality
+            evaluation.missingCareTime = nurseTripTime - patient.endTime;
+            evaluation.valid = false;
+        }
+
+        // We have now cared for the patient. Add the demand to our used capacity.
+        // We dont care if we are outside of time windows. The important part ist the capacity of a trip overall
+        evaluation.demand += patient.demand;
+
+        // Capacity penality
+        if (evaluation.demand > problemInstance.nurseCapacity)
+        {
+            evaluation.capacityExcess = evaluation.demand - problemInstance.nurseCapacity;
+            evaluation.valid = false;
+        }
+        previousPatientId = patientId;
+    }
+
+    // add the driving time from the last patient to the depot
+    nurseTripTime += travelTime[previousPatientId][0];
+    evaluation.travelTime += travelTime[previousPatientId][0];
+    evaluation.returnTime = nurseTripTime;
+    if (nurseTripTime > problemInstance.depot.returnTime)
+    {
+        evaluation.valid = false;
+    }
+    return evaluation;
+}
+
+namespace {
+    constexpr double CAPACITY_PENALTY_FACTOR = 100000;
+    constexpr double MISSING_CARE_TIME_PENALTY_FACTOR = 10000;
+    constexpr double TO_LATE_TO_DEPOT_PENALTY_FACTOR = 10000;
+}
+
+auto journeyPenalty(const JourneyEvaluation &evaluation, const ProblemInstance &problemInstance) -> double
+{
+    const double toLateToDepot = std::max(0.0, evaluation.returnTime - problemInstance.depot.returnTime);
+    return evaluation.capacityExcess * CAPACITY_PENALTY_FACTOR + evaluation.missingCareTime * MISSING_CARE_TIME_PENALTY_FACTOR + toLateToDepot * TO_LATE_TO_DEPOT_PENALTY_FACTOR;
+}
+
+namespace {
+    // Combines the journey evaluations of an individual into fitness, penalties and validity
+    auto applyJourneyEvaluations(Individual *individual, const JourneyEvaluation *journeyEvaluations, const ProblemInstance &problemInstance) -> void
+    {
+        double combinedTripTime = 0;
+        double missingCareTimePenality = 0;
+        double capacityPenality = 0;
+        double toLateToDepotPenality = 0;
+        bool allJourneysValid = true;
+
+        const Genome &genome = individual->genome;
+        individual->journeyValid.resize(genome.size());
+        for (std::size_t nurse = 0; nurse < genome.size(); nurse++)
+        {
+            const JourneyEvaluation &journeyEvaluation = journeyEvaluations[nurse];
+
+            // the penalties hold the value of the last violation in the genome
+            if (journeyEvaluation.missingCareTime > 0)
+            {
+                missingCareTimePenality = journeyEvaluation.missingCareTime;
+            }
+            if (journeyEvaluation.capacityExcess > 0)
+            {
+                capacityPenality = journeyEvaluation.capacityExcess;
+            }
+            // add penality if we are too late to the depot
+            toLateToDepotPenality = std::max(0.0, journeyEvaluation.returnTime - problemInstance.depot.returnTime);
+            combinedTripTime += journeyEvaluation.travelTime;
+
+            individual->journeyValid[nurse] = journeyEvaluation.valid;
+            allJourneysValid = allJourneysValid && journeyEvaluation.valid;
+        }
+
+        double fitness = -combinedTripTime - capacityPenality * CAPACITY_PENALTY_FACTOR - missingCareTimePenality * MISSING_CARE_TIME_PENALTY_FACTOR - toLateToDepotPenality * TO_LATE_TO_DEPOT_PENALTY_FACTOR;
+
+        individual->fitness = fitness;
+        individual->capacityPenality = capacityPenality;
+        individual->missingCareTimePenality = missingCareTimePenality;
+        individual->toLateToDepotPenality = toLateToDepotPenality;
+        individual->travelTime = combinedTripTime;
+        // a genome that does not visit every patient exactly once is invalid even if all journeys are feasible
+        SolutionValidation coverage;
+        countPatientVisits(genome, problemInstance, coverage);
+        individual->valid = allJourneysValid && coverage.duplicateVisits == 0 && coverage.missingPatients == 0 && coverage.unknownPatients == 0;
+    }
+
+    auto evaluateJourneysScalar(const std::vector<const Journey *> &journeys, const std::vector<std::size_t> &order, const ProblemInstance &problemInstance, std::vector<JourneyEvaluation> &evaluations) -> void
+    {
+        for (std::size_t index : order)
+        {
+            evaluations[index] = evaluateJourney(*journeys[index], problemInstance);
+        }
+    }
+
+#if BIOAI_HAS_AVX2_KERNEL
+    // Evaluates four journeys per iteration, one per lane. Every step gathers the travel time from the
+    // previous stop and the time window, care time and demand of the current patient for all lanes.
+    // Lanes whose journey is already finished gather zeros and are masked out of the comparisons.
+    // The arithmetic mirrors evaluateJourney operation by operation, so the results are bit identical.
+    __attribute__((target("avx2"))) auto evaluateJourneysAvx2(const std::vector<const Journey *> &journeys, const std::vector<std::size_t> &order, const ProblemInstance &problemInstance, std::vector<JourneyEvaluation> &evaluations) -> void
+    {
+        constexpr int lanes = 4;
+        const int numberOfLocations = problemInstance.numberOfLocations;
+        const double *travelTime = problemInstance.flatTravelTime.data();
+        const double *startTimes = problemInstance.patientStartTimes.data();
+        const double *endTimes = problemInstance.patientEndTimes.data();
+        const double *careTimes = problemInstance.patientCareTimes.data();
+        const double *demands = problemInstance.patientDemands.data();
+        const __m256d zero = _mm256_setzero_pd();
+        const __m256d capacity = _mm256_set1_pd(problemInstance.nurseCapacity);
+        const __m256d depotReturnTime = _mm256_set1_pd(problemInstance.depot.returnTime);
+
+        for (std::size_t first = 0; first < order.size(); first += lanes)
+        {
+            const int *stops[lanes] = {};
+            int lengths[lanes] = {};
+            int maxLength = 0;
+            for (int lane = 0; lane < lanes && first + lane < order.size(); lane++)
+            {
+                const Journey &journey = *journeys[order[first + lane]];
+                stops[lane] = journey.data();
+                lengths[lane] = static_cast<int>(journey.size());
+                maxLength = std::max(maxLength, lengths[lane]);
+            }
+
+            __m256d tripTime = zero;
+            __m256d totalTravelTime = zero;
+            __m256d demand = zero;
+            __m256d missingCareTime = zero;
+            __m256d capacityExcess = zero;
+            __m256d invalid = zero;
+
+            for (int step = 0; step < maxLength; step++)
+            {
+                alignas(16) int travelIndex[lanes];
+                alignas(16) int patientIndex[lanes];
+                alignas(32) long long activeLanes[lanes];
+                for (int lane = 0; lane < lanes; lane++)
+                {
+                    const bool active = step < lengths[lane];
+                    const int patientId = active ? stops[lane][step] : 0;
+                    const int previousPatientId = active && step > 0 ? stops[lane][step - 1] : 0;
+                    travelIndex[lane] = previousPatientId * numberOfLocations + patientId;
+                    patientIndex[lane] = patientId;
+                    activeLanes[lane] = active ? -1 : 0;
+                }
+                const __m256d active = _mm256_castsi256_pd(_mm256_load_si256(reinterpret_cast<const __m256i *>(activeLanes)));
+                const __m128i travelOffsets = _mm_load_si128(reinterpret_cast<const __m128i *>(travelIndex));
+                const __m128i patientOffsets = _mm_load_si128(reinterpret_cast<const __m128i *>(patientIndex));
+
+                const __m256d travel = _mm256_mask_i32gather_pd(zero, travelTime, travelOffsets, active, 8);
+                const __m256d startTime = _mm256_mask_i32gather_pd(zero, startTimes, patientOffsets, active, 8);
+                const __m256d endTime = _mm256_mask_i32gather_pd(zero, endTimes, patientOffsets, active, 8);
+                const __m256d careTime = _mm256_mask_i32gather_pd(zero, careTimes, patientOffsets, active, 8);
+                const __m256d patientDemand = _mm256_mask_i32gather_pd(zero, demands, patientOffsets, active, 8);
+
+                tripTime = _mm256_add_pd(tripTime, travel);
+                totalTravelTime = _mm256_add_pd(totalTravelTime, travel);
+                tripTime = _mm256_max_pd(tripTime, startTime);
+                tripTime = _mm256_add_pd(tripTime, careTime);
+
+                const __m256d tooLate = _mm256_and_pd(_mm256_cmp_pd(tripTime, endTime, _CMP_GT_OQ), active);
+                missingCareTime = _mm256_blendv_pd(missingCareTime, _mm256_sub_pd(tripTime, endTime), tooLate);
+
+                demand = _mm256_add_pd(demand, patientDemand);
+                const __m256d overCapacity = _mm256_and_pd(_mm256_cmp_pd(demand, capacity, _CMP_GT_OQ), active);
+                capacityExcess = _mm256_blendv_pd(capacityExcess, _mm256_sub_pd(demand, capacity), overCapacity);
+
+                invalid = _mm256_or_pd(invalid, _mm256_or_pd(tooLate, overCapacity));
+            }
+
+            // drive back to the depot from the last patient of every non empty journey
+            alignas(16) int returnIndex[lanes];
+            alignas(32) long long nonEmptyLanes[lanes];
+            for (int lane = 0; lane < lanes; lane++)
+            {
+                const bool nonEmpty = lengths[lane] > 0;
+                returnIndex[lane] = nonEmpty ? stops[lane][lengths[lane] - 1] * numberOfLocations : 0;
+                nonEmptyLanes[lane] = nonEmpty ? -1 : 0;
+            }
+            const __m256d nonEmpty = _mm256_castsi256_pd(_mm256_load_si256(reinterpret_cast<const __m256i *>(nonEmptyLanes)));
+            const __m256d travel = _mm256_mask_i32gather_pd(zero, travelTime, _mm_load_si128(reinterpret_cast<const __m128i *>(returnIndex)), nonEmpty, 8);
+            tripTime = _mm256_add_pd(tripTime, travel);
+            totalTravelTime = _mm256_add_pd(totalTravelTime, travel);
+            invalid = _mm256_or_pd(invalid, _mm256_and_pd(_mm256_cmp_pd(tripTime, depotReturnTime, _CMP_GT_OQ), nonEmpty));
+
+            alignas(32) double travelTimes[lanes];
+            alignas(32) double returnTimes[lanes];
+            alignas(32) double missingCareTimes[lanes];
+            alignas(32) double capacityExcesses[lanes];
+            alignas(32) double demandSums[lanes];
+            _mm256_store_pd(travelTimes, totalTravelTime);
+            _mm256_store_pd(returnTimes, tripTime);
+            _mm256_store_pd(missingCareTimes, missingCareTime);
+            _mm256_store_pd(capacityExcesses, capacityExcess);
+            _mm256_store_pd(demandSums, demand);
+            const int invalidLanes = _mm256_movemask_pd(invalid);
+
+            for (int lane = 0; lane < lanes && first + lane < order.size(); lane++)
+            {
+                JourneyEvaluation &evaluation = evaluations[order[first + lane]];
+                evaluation.travelTime = travelTimes[lane];
+                evaluation.returnTime = returnTimes[lane];
+                evaluation.missingCareTime = missingCareTimes[lane];
+                evaluation.capacityExcess = capacityExcesses[lane];
+                evaluation.demand = static_cast<int>(demandSums[lane]);
+                evaluation.valid = (invalidLanes & (1 << lane)) == 0;
+            }
+        }
+    }
+#endif
+}
+
+auto isAvx2EvaluationAvailable() -> bool
+{
+#if BIOAI_HAS_AVX2_KERNEL
+    static const bool available = __builtin_cpu_supports("avx2");
+    return available;
+#else
+    return false;
+#endif
+}
+
+auto evaluateJourneys(const std::vector<const Journey *> &journeys, const ProblemInstance &problemInstance, std::vector<JourneyEvaluation> &evaluations) -> void
+{
+    evaluations.assign(journeys.size(), JourneyEvaluation());
+
+    // order the journeys by length so the lanes of one batch finish at about the same step
+    std::size_t maxLength = 0;
+    for (const Journey *journey : journeys)
+    {
+        maxLength = std::max(maxLength, journey->size());
+    }
+    std::vector<std::size_t> offsets(maxLength + 2, 0);
+    for (const Journey *journey : journeys)
+    {
+        offsets[journey->size() + 1]++;
+    }
+    for (std::size_t length = 1; length < offsets.size(); length++)
+    {
+        offsets[length] += offsets[length - 1];
+    }
+    std::vector<std::size_t> order(journeys.size());
+    for (std::size_t index = 0; index < journeys.size(); index++)
+    {
+        order[offsets[journeys[index]->size()]++] = index;
+    }
+
+#if BIOAI_HAS_AVX2_KERNEL
+    if (isAvx2EvaluationAvailable())
+    {
+        evaluateJourneysAvx2(journeys, order, problemInstance, evaluations);
+        return;
+    }
+#endif
+    evaluateJourneysScalar(journeys, order, problemInstance, evaluations);
+}
+
+auto evaluateIndividual(Individual *individual, const ProblemInstance &problemInstance) -> void
+{
+    ScopedTimer timer("evaluateIndividual");
+    FitnessCache &cache = FitnessCache::getInstance();
+    HashWithCheck key;
+    if (cache.isEnabled())
+    {
+        key = cache.keyOf(individual->genome);
+        if (cache.restore(key, individual))
+        {
+            return;
+        }
+    }
+    Profiler::getInstance().countEvaluation();
+    std::vector<JourneyEvaluation> journeyEvaluations;
+    journeyEvaluations.reserve(individual->genome.size());
+    JourneyCache &journeyCache = JourneyCache::getInstance();
+    for (const Journey &journey : individual->genome)
+    {
+        // empty journeys are cheaper to evaluate than to look up
+        if (!journeyCache.isEnabled() || journey.empty())
+        {
+            journeyEvaluations.push_back(evaluateJourney(journey, problemInstance));
+            continue;
+        }
+        const HashWithCheck journeyKey = journeyCache.keyOf(journey);
+        JourneyEvaluation journeyEvaluation;
+        if (!journeyCache.find(journeyKey, journeyEvaluation))
+        {
+            journeyEvaluation = evaluateJourney(journey, problemInstance);
+            journeyCache.store(journeyKey, journeyEvaluation);
+        }
+        journeyEvaluations.push_back(journeyEvaluation);
+    }
+    applyJourneyEvaluations(individual, journeyEvaluations.data(), problemInstance);
+    if (cache.isEnabled())
+    {
+        cache.store(key, *individual);
+    }
+}
+
+auto evaluateIndividuals(Population &population, const std::vector<std::size_t> &indices, const ProblemInstance &problemInstance) -> void
+{
+    if (indices.empty())
+    {
+        return;
+    }
+    ScopedTimer timer("evaluateIndividuals");
+    // individuals whose genome is cached are restored directly, only the others are evaluated
+    FitnessCache &cache = FitnessCache::getInstance();
+    std::vector<std::size_t> uncached;
+    std::vector<HashWithCheck> keys;
+    if (cache.isEnabled())
+    {
+        for (std::size_t index : indices)
+        {
+            const HashWithCheck key = cache.keyOf(population[index].genome);
+            if (!cache.restore(key, &population[index]))
+            {
+                uncached.push_back(index);
+                keys.push_back(key);
+            }
+        }
+    }
+    else
+    {
+        uncached = indices;
+    }
+
+    std::vector<const Journey *> journeys;
+    std::vector<std::size_t> firstJourney;
+    firstJourney.reserve(uncached.size());
+    for (std::size_t index : uncached)
+    {
+        firstJourney.push_back(journeys.size());
+        for (const Journey &journey : population[index].genome)
+        {
+            journeys.push_back(&journey);
+        }
+    }
+    std::vector<JourneyEvaluation> journeyEvaluations;
+    JourneyCache &journeyCache = JourneyCache::getInstance();
+    if (journeyCache.isEnabled())
+    {
+        // only journeys that were never seen before go through the batch evaluator
+        journeyEvaluations.resize(journeys.size());
+        std::vector<const Journey *> unseenJourneys;
+        std::vector<std::size_t> unseenPositions;
+        std::vector<HashWithCheck> unseenKeys;
+        for (std::size_t position = 0; position < journeys.size(); position++)
+        {
+            if (journeys[position]->empty())
+            {
+                continue;
+            }
+            const HashWithCheck journeyKey = journeyCache.keyOf(*journeys[position]);
+            if (!journeyCache.find(journeyKey, journeyEvaluations[position]))
+            {
+                unseenJourneys.push_back(journeys[position]);
+                unseenPositions.push_back(position);
+                unseenKeys.push_back(journeyKey);
+            }
+        }
+        std::vector<JourneyEvaluation> unseenEvaluations;
+        evaluateJourneys(unseenJourneys, problemInstance, unseenEvaluations);
+        for (std::size_t unseen = 0; unseen < unseenJourneys.size(); unseen++)
+        {
+            journeyEvaluations[unseenPositions[unseen]] = unseenEvaluations[unseen];
+            journeyCache.store(unseenKeys[unseen], unseenEvaluations[unseen]);
+        }
+    }
+    else
+    {
+        evaluateJourneys(journeys, problemInstance, journeyEvaluations);
+    }
+    Profiler &profiler = Profiler::getInstance();
+    for (std::size_t position = 0; position < uncached.size(); position++)
+    {
+        profiler.countEvaluation();
+        Individual &individual = population[uncached[position]];
+        applyJourneyEvaluations(&individual, journeyEvaluations.data() + firstJourney[position], problemInstance);
+        if (cache.isEnabled())
+        {
+            cache.store(keys[position], individual);
+        }
+    }
+}
+
+auto evaluatePopulation(Population &population, const ProblemInstance &problemInstance) -> void
+{
+    std::vector<std::size_t> indices(population.size());
+    for (std::size_t index = 0; index < population.size(); index++)
+    {
+        indices[index] = index;
+    }
+    evaluateIndividuals(population, indices, problemInstance);
+}
@@ -0,0 +1,80 @@
+#include "fitnessCache.h"
+#include "genomeHash.h"
+
+auto FitnessCache::getInstance() -> FitnessCache &
+{
+    static FitnessCache instance;
+    return instance;
+}
+
+void FitnessCache::configure(bool enabled, std::size_t capacity, const std::string &instanceName)
+{
+    this->enabled = enabled;
+    instanceSalt = hashInstanceName(instanceName);
+    cache.setCapacity(capacity);
+}
+
+auto FitnessCache::keyOf(const Genome &genome) const -> HashWithCheck
+{
+    HashWithCheck hash = hashGenomeWithCheck(genome);
+    hash.key ^= instanceSalt;
+    return hash;
+}
+
+auto FitnessCache::restore(const HashWithCheck &key, Individual *individual) -> bool
+{
+    CachedEvaluation evaluation;
+    if (!cache.findMatching(key.key, evaluation, [&key](const CachedEvaluation &entry) { return entry.check == key.check; }))
+    {
+        return false;
+    }
+    individual->fitness = evaluation.fitness;
+    individual->missingCareTimePenality = evaluation.missingCareTimePenality;
+    individual->capacityPenality = evaluation.capacityPenality;
+    individual->toLateToDepotPenality = evaluation.toLateToDepotPenality;
+    individual->travelTime = evaluation.travelTime;
+    individual->journeyValid = std::move(evaluation.journeyValid);
+    individual->valid = evaluation.valid;
+    return true;
+}
+
+void FitnessCache::store(const HashWithCheck &key, const Individual &individual)
+{
+    cache.insert(key.key, {individual.fitness, individual.missingCareTimePenality, individual.capacityPenality, individual.toLateToDepotPenality, individual.travelTime, individual.journeyValid, individual.valid, key.check});
+}
+
+auto JourneyCache::getInstance() -> JourneyCache &
+{
+    static JourneyCache instance;
+    return instance;
+}
+
+void JourneyCache::configure(bool enabled, std::size_t capacity, const std::string &instanceName)
+{
+    this->enabled = enabled;
+    instanceSalt = hashInstanceName(instanceName);
+    cache.setCapacity(capacity);
+}
+
+auto JourneyCache::keyOf(const Journey &journey) const -> HashWithCheck
+{
+    HashWithCheck hash = hashJourneyWithCheck(journey);
+    hash.key ^= instanceSalt;
+    return hash;
+}
+
+auto JourneyCache::find(const HashWithCheck &key, JourneyEvaluation &evaluation) -> bool
+{
+    CachedJourneyEvaluation entry;
+    if (!cache.findMatching(key.key, entry, [&key](const CachedJourneyEvaluation &cached) { return cached.check == key.check; }))
+    {
+        return false;
+    }
+    evaluation = entry.evaluation;
+    return true;
+}
+
+void JourneyCache::store(const HashWithCheck &key, const JourneyEvaluation &evaluation)
+{
+    cache.insert(key.key, {evaluation, key.check});
+}
@@ -0,0 +1,83 @@
+#include "genomeHash.h"
+#include <functional>
+
+auto mixHash(std::uint64_t value) -> std::uint64_t
+{
+    value += 0x9e3779b97f4a7c15ULL;
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+
+auto edgeKey(int nurse, int from, int to) -> std::uint64_t
+{
+    const std::uint64_t edge = (static_cast<std::uint64_t>(static_cast<std::uint16_t>(nurse)) << 32) | (static_cast<std::uint64_t>(static_cast<std::uint16_t>(from)) << 16) | static_cast<std::uint16_t>(to);
+    return mixHash(edge);
+}
+
+auto hashJourney(const Journey &journey, int nurse) -> std::uint64_t
+{
+    if (journey.empty())
+    {
+        return 0;
+    }
+    std::uint64_t hash = 0;
+    int previousPatientId = 0;
+    for (int patientId : journey)
+    {
+        hash += edgeKey(nurse, previousPatientId, patientId);
+        previousPatientId = patientId;
+    }
+    return hash + edgeKey(nurse, previousPatientId, 0);
+}
+
+auto hashGenome(const Genome &genome) -> std::uint64_t
+{
+    // the number of nurses is part of the hash so that trailing empty journeys are not ignored
+    std::uint64_t hash = mixHash(genome.size());
+    for (std::size_t nurse = 0; nurse < genome.size(); nurse++)
+    {
+        hash += hashJourney(genome[nurse], static_cast<int>(nurse));
+    }
+    return hash;
+}
+
+namespace {
+    // FNV-1a 64 bit prime, the check multiplies by it once per patient
+    constexpr std::uint64_t CHECK_PRIME = 0x100000001b3ULL;
+
+    // adds the journey to both hashes, a journey ends with 0 in the check so that the split into journeys counts
+    auto addJourney(HashWithCheck &hash, const Journey &journey, int nurse) -> void
+    {
+        hash.key += hashJourney(journey, nurse);
+        for (int patientId : journey)
+        {
+            hash.check = hash.check * CHECK_PRIME + static_cast<std::uint64_t>(static_cast<std::uint32_t>(patientId)) + 1;
+        }
+        hash.check *= CHECK_PRIME;
+    }
+}
+
+auto hashJourneyWithCheck(const Journey &journey) -> HashWithCheck
+{
+    HashWithCheck hash;
+    addJourney(hash, journey, 0);
+    hash.check = mixHash(hash.check);
+    return hash;
+}
+
+auto hashGenomeWithCheck(const Genome &genome) -> HashWithCheck
+{
+    HashWithCheck hash = {mixHash(genome.size()), 0};
+    for (std::size_t nurse = 0; nurse < genome.size(); nurse++)
+    {
+        addJourney(hash, genome[nurse], static_cast<int>(nurse));
+    }
+    hash.check = mixHash(hash.check);
+    return hash;
+}
+
+auto hashInstanceName(const std::string &instanceName) -> std::uint64_t
+{
+    return mixHash(std::hash<std::string>{}(instanceName));
+}
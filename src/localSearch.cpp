@@ -0,0 +1,837 @@
+#include "localSearch.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include "evaluation.h"
+
+auto buildRouteSchedule(const Journey &journey, const ProblemInstance &problemInstance, RouteSchedule &schedule) -> void
+{
+    const std::size_t length = journey.size();
+    schedule.departureTimes.resize(length);
+    schedule.latestArrivalTimes.resize(length);
+    schedule.cumulativeDemand.resize(length);
+    schedule.timeFeasible = true;
+    schedule.firstViolation = static_cast<int>(length);
+    schedule.load = 0;
+    if (length == 0)
+    {
+        return;
+    }
+    const auto &travelTime = problemInstance.travelTime;
+
+    double time = 0;
+    int previousPatientId = 0;
+    for (std::size_t position = 0; position < length; position++)
+    {
+        const Patient &patient = problemInstance.patientTable[journey[position]];
+        time = std::max(time + travelTime[previousPatientId][patient.id], static_cast<double>(patient.startTime)) + patient.careTime;
+        if (time > patient.endTime && schedule.timeFeasible)
+        {
+            schedule.timeFeasible = false;
+            schedule.firstViolation = static_cast<int>(position);
+        }
+        schedule.departureTimes[position] = time;
+        schedule.load += patient.demand;
+        schedule.cumulativeDemand[position] = schedule.load;
+        previousPatientId = patient.id;
+    }
+    if (time + travelTime[previousPatientId][0] > problemInstance.depot.returnTime)
+    {
+        schedule.timeFeasible = false;
+    }
+
+    // walk backwards: the latest arrival is bounded by the own time window and by the latest arrival at the successor
+    double latestDeparture = problemInstance.depot.returnTime - travelTime[journey[length - 1]][0];
+    for (std::size_t position = length; position-- > 0;)
+    {
+        const Patient &patient = problemInstance.patientTable[journey[position]];
+        double latestArrival = std::min(static_cast<double>(patient.endTime), latestDeparture) - patient.careTime;
+        // waiting for the time window to open already makes the rest of the journey infeasible
+        if (patient.startTime > latestArrival)
+        {
+            latestArrival = std::numeric_limits<double>::lowest();
+        }
+        schedule.latestArrivalTimes[position] = latestArrival;
+        if (position > 0)
+        {
+            latestDeparture = latestArrival - travelTime[journey[position - 1]][patient.id];
+        }
+    }
+}
+
+auto parseImprovementStrategy(const std::string &strategy) -> ImprovementStrategy
+{
+    if (strategy == "first")
+    {
+        return ImprovementStrategy::FirstImprovement;
+    }
+    if (strategy == "best")
+    {
+        return ImprovementStrategy::BestImprovement;
+    }
+    throw std::invalid_argument("Unknown improvement strategy: " + strategy);
+}
+
+namespace {
+    // Checks if reversing the positions first..last keeps a time feasible journey within its time windows.
+    // Only the reversed segment is walked, the rest is covered by the latest arrival time behind it.
+    auto reversalKeepsTimeWindows(const Journey &journey, int first, int last, const RouteSchedule &schedule, const ProblemInstance &problemInstance) -> bool
+    {
+        const auto &travelTime = problemInstance.travelTime;
+        double time = first > 0 ? schedule.departureTimes[first - 1] : 0.0;
+        int previousPatientId = first > 0 ? journey[first - 1] : 0;
+        for (int position = last; position >= first; position--)
+        {
+            const Patient &patient = problemInstance.patientTable[journey[position]];
+            time = std::max(time + travelTime[previousPatientId][patient.id], static_cast<double>(patient.startTime)) + patient.careTime;
+            if (time > patient.endTime)
+            {
+                return false;
+            }
+            previousPatientId = patient.id;
+        }
+        if (last + 1 < static_cast<int>(journey.size()))
+        {
+            return time + travelTime[previousPatientId][journey[last + 1]] <= schedule.latestArrivalTimes[last + 1];
+        }
+        return time + travelTime[previousPatientId][0] <= problemInstance.depot.returnTime;
+    }
+
+    // travel time saved by reversing the positions first..last, the depot is used before the first and after the last position
+    auto reversalGain(const Journey &journey, int first, int last, const ProblemInstance &problemInstance) -> double
+    {
+        const auto &travelTime = problemInstance.travelTime;
+        const int before = first > 0 ? journey[first - 1] : 0;
+        const int after = last + 1 < static_cast<int>(journey.size()) ? journey[last + 1] : 0;
+        const double oldCost = travelTime[before][journey[first]] + travelTime[journey[last]][after];
+        const double newCost = travelTime[before][journey[last]] + travelTime[journey[first]][after];
+        return oldCost - newCost;
+    }
+}
+
+auto twoOptJourney(Journey &journey, const ProblemInstance &problemInstance, ImprovementStrategy strategy) -> bool
+{
+    const int length = static_cast<int>(journey.size());
+    if (length < 2)
+    {
+        return false;
+    }
+    // don't look bits indexed by patient id
+    thread_local std::vector<char> dontLook;
+    dontLook.assign(problemInstance.patientTable.size(), 0);
+    // with neighbour lists only reversals creating an edge to a near neighbour are tried
+    const bool granular = !problemInstance.neighbours.empty();
+    thread_local std::vector<int> positionInJourney;
+    if (granular)
+    {
+        positionInJourney.assign(problemInstance.patientTable.size(), -1);
+        for (int position = 0; position < length; position++)
+        {
+            positionInJourney[journey[position]] = position;
+        }
+    }
+    RouteSchedule schedule;
+    buildRouteSchedule(journey, problemInstance, schedule);
+    const bool respectTimeWindows = schedule.timeFeasible;
+
+    auto isAllowed = [&](int first, int last)
+    {
+        return !respectTimeWindows || reversalKeepsTimeWindows(journey, first, last, schedule, problemInstance);
+    };
+    // reverse first..last and wake up the nodes whose edges changed
+    auto applyReversal = [&](int first, int last)
+    {
+        std::reverse(journey.begin() + first, journey.begin() + last + 1);
+        if (granular)
+        {
+            for (int position = first; position <= last; position++)
+            {
+                positionInJourney[journey[position]] = position;
+            }
+        }
+        dontLook[journey[first]] = 0;
+        dontLook[journey[last]] = 0;
+        if (first > 0)
+        {
+            dontLook[journey[first - 1]] = 0;
+        }
+        if (last + 1 < length)
+        {
+            dontLook[journey[last + 1]] = 0;
+        }
+        if (respectTimeWindows)
+        {
+            buildRouteSchedule(journey, problemInstance, schedule);
+        }
+    };
+
+    bool changed = false;
+    bool foundImprovement;
+    do
+    {
+        foundImprovement = false;
+        int bestFirst = -1;
+        int bestLast = -1;
+        double bestGain = 0;
+        // i is the position in front of the reversed segment, -1 stands for the depot
+        for (int i = -1; i <= length - 2; i++)
+        {
+            if (i >= 0 && dontLook[journey[i]])
+            {
+                continue;
+            }
+            bool improvingMove = false;
+            auto considerReversal = [&](int j)
+            {
+                const double gain = reversalGain(journey, i + 1, j, problemInstance);
+                if (gain <= 0)
+                {
+                    return;
+                }
+                if (strategy == ImprovementStrategy::BestImprovement)
+                {
+                    // the node stays awake even if the move is dominated, it may be the best one in the next pass
+                    improvingMove = true;
+                    if (gain > bestGain && isAllowed(i + 1, j))
+                    {
+                        bestGain = gain;
+                        bestFirst = i + 1;
+                        bestLast = j;
+                    }
+                    return;
+                }
+                if (isAllowed(i + 1, j))
+                {
+                    improvingMove = true;
+                    applyReversal(i + 1, j);
+                    foundImprovement = true;
+                }
+            };
+            if (granular)
+            {
+                // only reversals that connect the node in front of the segment to one of its neighbours
+                for (int neighbour : problemInstance.neighbours[i >= 0 ? journey[i] : 0])
+                {
+                    const int j = positionInJourney[neighbour];
+                    if (j > i + 1)
+                    {
+                        considerReversal(j);
+                    }
+                }
+            }
+            else
+            {
+                for (int j = i + 1; j < length; j++)
+                {
+                    considerReversal(j);
+                }
+            }
+            if (!improvingMove && i >= 0)
+            {
+                dontLook[journey[i]] = 1;
+            }
+        }
+        if (strategy == ImprovementStrategy::BestImprovement && bestFirst >= 0)
+        {
+            applyReversal(bestFirst, bestLast);
+            foundImprovement = true;
+        }
+        changed = changed || foundImprovement;
+    } while (foundImprovement);
+    return changed;
+}
+
+namespace {
+    // moves have to save at least this much travel time, protects against cycling on rounding noise
+    constexpr double minimumGain = 1e-9;
+
+    // patient at a position of a journey, the depot before the first and after the last position
+    auto nodeAt(const Journey &journey, int position) -> int
+    {
+        return position < 0 || position >= static_cast<int>(journey.size()) ? 0 : journey[position];
+    }
+
+    auto demandBetween(const RouteSchedule &schedule, int first, int length) -> int
+    {
+        if (length == 0)
+        {
+            return 0;
+        }
+        const int before = first > 0 ? schedule.cumulativeDemand[first - 1] : 0;
+        return schedule.cumulativeDemand[first + length - 1] - before;
+    }
+
+    auto isFeasible(const RouteSchedule &schedule, const ProblemInstance &problemInstance) -> bool
+    {
+        return schedule.timeFeasible && schedule.load <= problemInstance.nurseCapacity;
+    }
+
+    // Checks the journey prefix[0..prefixEnd] + middle + suffixJourney[suffixStart..]. The middle is walked, the prefix
+    // is covered by its first violation and the suffix by its latest arrival times.
+    auto isJoinFeasible(const Journey &prefixJourney, const RouteSchedule &prefixSchedule, int prefixEnd,
+                        const int *middle, int middleLength,
+                        const Journey &suffixJourney, const RouteSchedule &suffixSchedule, int suffixStart,
+                        const ProblemInstance &problemInstance) -> bool
+    {
+        if (prefixSchedule.firstViolation <= prefixEnd)
+        {
+            return false;
+        }
+        const auto &travelTime = problemInstance.travelTime;
+        double time = prefixEnd >= 0 ? prefixSchedule.departureTimes[prefixEnd] : 0.0;
+        int previousPatientId = nodeAt(prefixJourney, prefixEnd);
+        for (int position = 0; position < middleLength; position++)
+        {
+            const Patient &patient = problemInstance.patientTable[middle[position]];
+            time = std::max(time + travelTime[previousPatientId][patient.id], static_cast<double>(patient.startTime)) + patient.careTime;
+            if (time > patient.endTime)
+            {
+                return false;
+            }
+            previousPatientId = patient.id;
+        }
+        if (suffixStart < static_cast<int>(suffixJourney.size()))
+        {
+            return time + travelTime[previousPatientId][suffixJourney[suffixStart]] <= suffixSchedule.latestArrivalTimes[suffixStart];
+        }
+        return time + travelTime[previousPatientId][0] <= problemInstance.depot.returnTime;
+    }
+
+    // Writes the journey prefix[0..prefixEnd] + middle + suffixJourney[suffixStart..] checked by isJoinFeasible
+    auto joinJourney(const Journey &prefixJourney, int prefixEnd, const int *middle, int middleLength,
+                     const Journey &suffixJourney, int suffixStart, Journey &journey) -> void
+    {
+        journey.assign(prefixJourney.begin(), prefixJourney.begin() + prefixEnd + 1);
+        journey.insert(journey.end(), middle, middle + middleLength);
+        journey.insert(journey.end(), suffixJourney.begin() + suffixStart, suffixJourney.end());
+    }
+
+    class InterRouteSearch
+    {
+    private:
+        Genome &genome;
+        const ProblemInstance &problemInstance;
+        const std::vector<std::vector<double>> &travelTime;
+        std::vector<RouteSchedule> schedules;
+        // penalty of every journey weighted like in the fitness
+        std::vector<double> penalties;
+        // journey and position of every patient, kept up to date for the neighbour list driven sweep
+        std::vector<int> routeOf;
+        std::vector<int> positionOf;
+
+        auto countFeasible(int routeA, int routeB) const -> int
+        {
+            return isFeasible(schedules[routeA], problemInstance) + isFeasible(schedules[routeB], problemInstance);
+        }
+
+        // Infeasible journeys are compared by their penalties, a move that saves travel time but adds more penalty
+        // than it removes would lower the fitness
+        auto keepsPenalty(int routeA, const Journey &journeyA, int routeB, const Journey &journeyB) const -> bool
+        {
+            double penaltyAfter = journeyPenalty(evaluateJourney(journeyA, problemInstance), problemInstance);
+            double penaltyBefore = penalties[routeA];
+            if (routeB != routeA)
+            {
+                penaltyAfter += journeyPenalty(evaluateJourney(journeyB, problemInstance), problemInstance);
+                penaltyBefore += penalties[routeB];
+            }
+            return penaltyAfter <= penaltyBefore;
+        }
+
+        void rebuild(int route)
+        {
+            buildRouteSchedule(genome[route], problemInstance, schedules[route]);
+            penalties[route] = isFeasible(schedules[route], problemInstance) ? 0.0 : journeyPenalty(evaluateJourney(genome[route], problemInstance), problemInstance);
+            for (int position = 0; position < static_cast<int>(genome[route].size()); position++)
+            {
+                routeOf[genome[route][position]] = route;
+                positionOf[genome[route][position]] = position;
+            }
+        }
+
+    public:
+        InterRouteSearch(Genome &genome, const ProblemInstance &problemInstance) : genome(genome), problemInstance(problemInstance), travelTime(problemInstance.travelTime), schedules(genome.size()), penalties(genome.size()), routeOf(problemInstance.patientTable.size(), -1), positionOf(problemInstance.patientTable.size(), -1)
+        {
+            for (std::size_t route = 0; route < genome.size(); route++)
+            {
+                rebuild(static_cast<int>(route));
+            }
+        }
+
+        // Replaces lengthA patients at positionA of routeA by lengthB patients at positionB of routeB and vice versa.
+        // lengthB == 0 relocates, lengthA == lengthB == 1 exchanges, longer segments are a CROSS exchange.
+        auto trySegmentSwap(int routeA, int positionA, int lengthA, int routeB, int positionB, int lengthB) -> bool
+        {
+            const Journey &journeyA = genome[routeA];
+            const Journey &journeyB = genome[routeB];
+            const int beforeA = nodeAt(journeyA, positionA - 1);
+            const int afterA = nodeAt(journeyA, positionA + lengthA);
+            const int beforeB = nodeAt(journeyB, positionB - 1);
+            const int afterB = nodeAt(journeyB, positionB + lengthB);
+
+            auto edgeCost = [&](int before, const Journey &journey, int position, int length, int after)
+            {
+                return length == 0 ? travelTime[before][after] : travelTime[before][journey[position]] + travelTime[journey[position + length - 1]][after];
+            };
+            const double oldCost = edgeCost(beforeA, journeyA, positionA, lengthA, afterA) + edgeCost(beforeB, journeyB, positionB, lengthB, afterB);
+            const double newCost = edgeCost(beforeA, journeyB, positionB, lengthB, afterA) + edgeCost(beforeB, journeyA, positionA, lengthA, afterB);
+            if (newCost > oldCost - minimumGain)
+            {
+                return false;
+            }
+
+            const RouteSchedule &scheduleA = schedules[routeA];
+            const RouteSchedule &scheduleB = schedules[routeB];
+            const int demandA = demandBetween(scheduleA, positionA, lengthA);
+            const int demandB = demandBetween(scheduleB, positionB, lengthB);
+            const bool capacityA = scheduleA.load - demandA + demandB <= problemInstance.nurseCapacity;
+            const bool capacityB = scheduleB.load - demandB + demandA <= problemInstance.nurseCapacity;
+            const int feasibleBefore = countFeasible(routeA, routeB);
+            const int feasibleAfter = (capacityA && isJoinFeasible(journeyA, scheduleA, positionA - 1, journeyB.data() + positionB, lengthB, journeyA, scheduleA, positionA + lengthA, problemInstance)) +
+                                      (capacityB && isJoinFeasible(journeyB, scheduleB, positionB - 1, journeyA.data() + positionA, lengthA, journeyB, scheduleB, positionB + lengthB, problemInstance));
+            if (feasibleAfter < feasibleBefore)
+            {
+                return false;
+            }
+            if (feasibleBefore < 2)
+            {
+                thread_local Journey newA;
+                thread_local Journey newB;
+                joinJourney(journeyA, positionA - 1, journeyB.data() + positionB, lengthB, journeyA, positionA + lengthA, newA);
+                joinJourney(journeyB, positionB - 1, journeyA.data() + positionA, lengthA, journeyB, positionB + lengthB, newB);
+                if (!keepsPenalty(routeA, newA, routeB, newB))
+                {
+                    return false;
+                }
+            }
+
+            Journey segmentA(journeyA.begin() + positionA, journeyA.begin() + positionA + lengthA);
+            Journey segmentB(journeyB.begin() + positionB, journeyB.begin() + positionB + lengthB);
+            genome[routeA].erase(genome[routeA].begin() + positionA, genome[routeA].begin() + positionA + lengthA);
+            genome[routeA].insert(genome[routeA].begin() + positionA, segmentB.begin(), segmentB.end());
+            genome[routeB].erase(genome[routeB].begin() + positionB, genome[routeB].begin() + positionB + lengthB);
+            genome[routeB].insert(genome[routeB].begin() + positionB, segmentA.begin(), segmentA.end());
+            rebuild(routeA);
+            rebuild(routeB);
+            return true;
+        }
+
+        // Swaps the tails behind lastA of routeA and behind lastB of routeB
+        auto tryTailSwap(int routeA, int lastA, int routeB, int lastB) -> bool
+        {
+            const Journey &journeyA = genome[routeA];
+            const Journey &journeyB = genome[routeB];
+            const int endA = nodeAt(journeyA, lastA);
+            const int startA = nodeAt(journeyA, lastA + 1);
+            const int endB = nodeAt(journeyB, lastB);
+            const int startB = nodeAt(journeyB, lastB + 1);
+            const double oldCost = travelTime[endA][startA] + travelTime[endB][startB];
+            const double newCost = travelTime[endA][startB] + travelTime[endB][startA];
+            if (newCost > oldCost - minimumGain)
+            {
+                return false;
+            }
+
+            const RouteSchedule &scheduleA = schedules[routeA];
+            const RouteSchedule &scheduleB = schedules[routeB];
+            const int headDemandA = lastA >= 0 ? scheduleA.cumulativeDemand[lastA] : 0;
+            const int headDemandB = lastB >= 0 ? scheduleB.cumulativeDemand[lastB] : 0;
+            const bool capacityA = headDemandA + scheduleB.load - headDemandB <= problemInstance.nurseCapacity;
+            const bool capacityB = headDemandB + scheduleA.load - headDemandA <= problemInstance.nurseCapacity;
+            const int feasibleBefore = countFeasible(routeA, routeB);
+            const int feasibleAfter = (capacityA && isJoinFeasible(journeyA, scheduleA, lastA, nullptr, 0, journeyB, scheduleB, lastB + 1, problemInstance)) +
+                                      (capacityB && isJoinFeasible(journeyB, scheduleB, lastB, nullptr, 0, journeyA, scheduleA, lastA + 1, problemInstance));
+            if (feasibleAfter < feasibleBefore)
+            {
+                return false;
+            }
+            if (feasibleBefore < 2)
+            {
+                thread_local Journey newA;
+                thread_local Journey newB;
+                joinJourney(journeyA, lastA, nullptr, 0, journeyB, lastB + 1, newA);
+                joinJourney(journeyB, lastB, nullptr, 0, journeyA, lastA + 1, newB);
+                if (!keepsPenalty(routeA, newA, routeB, newB))
+                {
+                    return false;
+                }
+            }
+
+            Journey tailA(journeyA.begin() + lastA + 1, journeyA.end());
+            genome[routeA].resize(lastA + 1);
+            genome[routeA].insert(genome[routeA].end(), journeyB.begin() + lastB + 1, journeyB.end());
+            genome[routeB].resize(lastB + 1);
+            genome[routeB].insert(genome[routeB].end(), tailA.begin(), tailA.end());
+            rebuild(routeA);
+            rebuild(routeB);
+            return true;
+        }
+
+        // Travel time saved by moving the segment of length patients at position of routeA to position target of routeB.
+        // For routeA == routeB the target counts positions of the journey without the segment. Returns -infinity if the
+        // move would lower the number of feasible journeys.
+        auto rateSegmentMove(int routeA, int position, int length, int routeB, int target) -> double
+        {
+            const Journey &journeyA = genome[routeA];
+            const Journey &journeyB = genome[routeB];
+            const bool sameRoute = routeA == routeB;
+            // the target is the original position in routeA, nothing would change
+            if (sameRoute && target == position)
+            {
+                return -std::numeric_limits<double>::infinity();
+            }
+            const int first = journeyA[position];
+            const int last = journeyA[position + length - 1];
+            const int beforeSegment = nodeAt(journeyA, position - 1);
+            const int afterSegment = nodeAt(journeyA, position + length);
+            // neighbours of the target position, inside routeA the segment is skipped
+            auto targetNode = [&](int index)
+            {
+                return sameRoute && index >= position ? nodeAt(journeyA, index + length) : nodeAt(journeyB, index);
+            };
+            const int before = targetNode(target - 1);
+            const int after = targetNode(target);
+            const double removalGain = travelTime[beforeSegment][first] + travelTime[last][afterSegment] - travelTime[beforeSegment][afterSegment];
+            const double insertionCost = travelTime[before][first] + travelTime[last][after] - travelTime[before][after];
+            const double gain = removalGain - insertionCost;
+            if (gain <= minimumGain)
+            {
+                return -std::numeric_limits<double>::infinity();
+            }
+
+            const RouteSchedule &scheduleA = schedules[routeA];
+            const RouteSchedule &scheduleB = schedules[routeB];
+            if (sameRoute)
+            {
+                // walk the part between the old and the new place of the segment, the load stays the same
+                thread_local Journey middle;
+                middle.clear();
+                int prefixEnd;
+                int suffixStart;
+                if (target < position)
+                {
+                    middle.insert(middle.end(), journeyA.begin() + position, journeyA.begin() + position + length);
+                    middle.insert(middle.end(), journeyA.begin() + target, journeyA.begin() + position);
+                    prefixEnd = target - 1;
+                    suffixStart = position + length;
+                }
+                else
+                {
+                    middle.insert(middle.end(), journeyA.begin() + position + length, journeyA.begin() + target + length);
+                    middle.insert(middle.end(), journeyA.begin() + position, journeyA.begin() + position + length);
+                    prefixEnd = position - 1;
+                    suffixStart = target + length;
+                }
+                if (!isFeasible(scheduleA, problemInstance))
+                {
+                    thread_local Journey newA;
+                    joinJourney(journeyA, prefixEnd, middle.data(), static_cast<int>(middle.size()), journeyA, suffixStart, newA);
+                    return keepsPenalty(routeA, newA, routeA, newA) ? gain : -std::numeric_limits<double>::infinity();
+                }
+                const bool feasible = isJoinFeasible(journeyA, scheduleA, prefixEnd, middle.data(), static_cast<int>(middle.size()), journeyA, scheduleA, suffixStart, problemInstance);
+                return feasible ? gain : -std::numeric_limits<double>::infinity();
+            }
+
+            const int demand = demandBetween(scheduleA, position, length);
+            const int feasibleBefore = countFeasible(routeA, routeB);
+            const int feasibleAfter = (scheduleA.load - demand <= problemInstance.nurseCapacity && isJoinFeasible(journeyA, scheduleA, position - 1, nullptr, 0, journeyA, scheduleA, position + length, problemInstance)) +
+                                      (scheduleB.load + demand <= problemInstance.nurseCapacity && isJoinFeasible(journeyB, scheduleB, target - 1, journeyA.data() + position, length, journeyB, scheduleB, target, problemInstance));
+            if (feasibleAfter < feasibleBefore)
+            {
+                return -std::numeric_limits<double>::infinity();
+            }
+            if (feasibleBefore < 2)
+            {
+                thread_local Journey newA;
+                thread_local Journey newB;
+                joinJourney(journeyA, position - 1, nullptr, 0, journeyA, position + length, newA);
+                joinJourney(journeyB, target - 1, journeyA.data() + position, length, journeyB, target, newB);
+                if (!keepsPenalty(routeA, newA, routeB, newB))
+                {
+                    return -std::numeric_limits<double>::infinity();
+                }
+            }
+            return gain;
+        }
+
+        void applySegmentMove(int routeA, int position, int length, int routeB, int target)
+        {
+            Journey segment(genome[routeA].begin() + position, genome[routeA].begin() + position + length);
+            genome[routeA].erase(genome[routeA].begin() + position, genome[routeA].begin() + position + length);
+            genome[routeB].insert(genome[routeB].begin() + target, segment.begin(), segment.end());
+            rebuild(routeA);
+            if (routeB != routeA)
+            {
+                rebuild(routeB);
+            }
+        }
+
+        // Moves the segment to its best place. With neighbour lists only the places right behind a neighbour of the
+        // first patient and right in front of a neighbour of the last patient are rated, otherwise every place is.
+        auto tryOrOpt(int routeA, int position, int length, bool granular) -> bool
+        {
+            double bestGain = minimumGain;
+            int bestRoute = -1;
+            int bestTarget = -1;
+            auto rate = [&](int routeB, int target)
+            {
+                const double gain = rateSegmentMove(routeA, position, length, routeB, target);
+                if (gain > bestGain)
+                {
+                    bestGain = gain;
+                    bestRoute = routeB;
+                    bestTarget = target;
+                }
+            };
+            if (granular)
+            {
+                // target position of a slot next to patient v, -1 if v is part of the segment
+                auto slotNextTo = [&](int v, int offset)
+                {
+                    const int routeB = routeOf[v];
+                    int index = positionOf[v] + offset;
+                    if (routeB == routeA)
+                    {
+                        if (positionOf[v] >= position && positionOf[v] < position + length)
+                        {
+                            return -1;
+                        }
+                        if (positionOf[v] >= position + length)
+                        {
+                            index -= length;
+                        }
+                    }
+                    return index;
+                };
+                const int first = genome[routeA][position];
+                const int last = genome[routeA][position + length - 1];
+                for (int v : problemInstance.neighbours[first])
+                {
+                    const int target = routeOf[v] >= 0 ? slotNextTo(v, 1) : -1;
+                    if (target >= 0)
+                    {
+                        rate(routeOf[v], target);
+                    }
+                }
+                for (int v : problemInstance.neighbours[last])
+                {
+                    const int target = routeOf[v] >= 0 ? slotNextTo(v, 0) : -1;
+                    if (target >= 0)
+                    {
+                        rate(routeOf[v], target);
+                    }
+                }
+            }
+            else
+            {
+                for (int routeB = 0; routeB < static_cast<int>(genome.size()); routeB++)
+                {
+                    const int slots = static_cast<int>(genome[routeB].size()) - (routeB == routeA ? length : 0);
+                    for (int target = 0; target <= slots; target++)
+                    {
+                        rate(routeB, target);
+                    }
+                }
+            }
+            if (bestRoute < 0)
+            {
+                return false;
+            }
+            applySegmentMove(routeA, position, length, bestRoute, bestTarget);
+            return true;
+        }
+
+        // Runs one Or-opt sweep over all segments of 1 to maxSegmentLength patients. Returns true if anything changed.
+        auto orOptSweep(int maxSegmentLength, bool granular) -> bool
+        {
+            bool changed = false;
+            for (int routeA = 0; routeA < static_cast<int>(genome.size()); routeA++)
+            {
+                for (int length = 1; length <= maxSegmentLength; length++)
+                {
+                    for (int position = 0; position + length <= static_cast<int>(genome[routeA].size()); position++)
+                    {
+                        changed = tryOrOpt(routeA, position, length, granular) || changed;
+                    }
+                }
+            }
+            return changed;
+        }
+
+        // Runs one sweep over every patient u and its near neighbours v in other journeys. Only moves that create an
+        // edge between u and v are tried, which shrinks the neighbourhoods from all pairs to the neighbour list length.
+        auto granularSweep(const InterRouteNeighbourhoods &neighbourhoods) -> bool
+        {
+            bool changed = false;
+            for (int u = 1; u < static_cast<int>(routeOf.size()); u++)
+            {
+                if (routeOf[u] < 0 || u >= static_cast<int>(problemInstance.neighbours.size()))
+                {
+                    continue;
+                }
+                for (int v : problemInstance.neighbours[u])
+                {
+                    const int routeU = routeOf[u];
+                    const int routeV = routeOf[v];
+                    if (routeV < 0 || routeU == routeV)
+                    {
+                        continue;
+                    }
+                    const int positionU = positionOf[u];
+                    const int positionV = positionOf[v];
+                    const int lengthV = static_cast<int>(genome[routeV].size());
+                    bool moved = false;
+                    if (neighbourhoods.relocate)
+                    {
+                        // u right in front of or right behind v
+                        moved = trySegmentSwap(routeU, positionU, 1, routeV, positionV, 0) || trySegmentSwap(routeU, positionU, 1, routeV, positionV + 1, 0);
+                    }
+                    if (!moved && neighbourhoods.exchange)
+                    {
+                        // u takes the place of the patient in front of or behind v
+                        moved = (positionV > 0 && trySegmentSwap(routeU, positionU, 1, routeV, positionV - 1, 1)) || (positionV + 1 < lengthV && trySegmentSwap(routeU, positionU, 1, routeV, positionV + 1, 1));
+                    }
+                    if (!moved && neighbourhoods.twoOptStar)
+                    {
+                        // the journey of u continues with v and the rest of its journey
+                        moved = tryTailSwap(routeU, positionU, routeV, positionV - 1);
+                    }
+                    if (!moved && neighbourhoods.crossExchange)
+                    {
+                        // the segment behind u is swapped with a segment starting at v
+                        const int lengthU = static_cast<int>(genome[routeU].size());
+                        for (int segmentA = 1; !moved && segmentA <= neighbourhoods.maxSegmentLength && positionU + 1 + segmentA <= lengthU; segmentA++)
+                        {
+                            for (int segmentB = 1; !moved && segmentB <= neighbourhoods.maxSegmentLength && positionV + segmentB <= lengthV; segmentB++)
+                            {
+                                moved = trySegmentSwap(routeU, positionU + 1, segmentA, routeV, positionV, segmentB);
+                            }
+                        }
+                    }
+                    if (moved)
+                    {
+                        changed = true;
+                        // the position of u is stale, continue with the next patient
+                        break;
+                    }
+                }
+            }
+            return changed;
+        }
+
+        // Runs one sweep over all route pairs, applying every improving move found. Returns true if anything changed.
+        auto sweep(const InterRouteNeighbourhoods &neighbourhoods) -> bool
+        {
+            bool changed = false;
+            const int numberOfRoutes = static_cast<int>(genome.size());
+            for (int routeA = 0; routeA < numberOfRoutes; routeA++)
+            {
+                for (int routeB = 0; routeB < numberOfRoutes; routeB++)
+                {
+                    if (routeA == routeB)
+                    {
+                        continue;
+                    }
+                    if (neighbourhoods.relocate)
+                    {
+                        for (int positionA = 0; positionA < static_cast<int>(genome[routeA].size()); positionA++)
+                        {
+                            for (int positionB = 0; positionB <= static_cast<int>(genome[routeB].size()); positionB++)
+                            {
+                                if (trySegmentSwap(routeA, positionA, 1, routeB, positionB, 0))
+                                {
+                                    changed = true;
+                                    break;
+                                }
+                            }
+                        }
+                    }
+                    // the remaining neighbourhoods are symmetric
+                    if (routeB < routeA)
+                    {
+                        continue;
+                    }
+                    if (neighbourhoods.exchange)
+                    {
+                        for (int positionA = 0; positionA < static_cast<int>(genome[routeA].size()); positionA++)
+                        {
+                            for (int positionB = 0; positionB < static_cast<int>(genome[routeB].size()); positionB++)
+                            {
+                                changed = trySegmentSwap(routeA, positionA, 1, routeB, positionB, 1) || changed;
+                            }
+                        }
+                    }
+                    if (neighbourhoods.twoOptStar)
+                    {
+                        for (int lastA = -1; lastA < static_cast<int>(genome[routeA].size()); lastA++)
+                        {
+                            for (int lastB = -1; lastB < static_cast<int>(genome[routeB].size()); lastB++)
+                            {
+                                if (lastA + 1 < static_cast<int>(genome[routeA].size()) || lastB + 1 < static_cast<int>(genome[routeB].size()))
+                                {
+                                    changed = tryTailSwap(routeA, lastA, routeB, lastB) || changed;
+                                }
+                            }
+                        }
+                    }
+                    if (neighbourhoods.crossExchange)
+                    {
+                        for (int lengthA = 1; lengthA <= neighbourhoods.maxSegmentLength; lengthA++)
+                        {
+                            for (int lengthB = 1; lengthB <= neighbourhoods.maxSegmentLength; lengthB++)
+                            {
+                                // single patient swaps are covered by the exchange neighbourhood
+                                if (lengthA == 1 && lengthB == 1)
+                                {
+                                    continue;
+                                }
+                                for (int positionA = 0; positionA + lengthA <= static_cast<int>(genome[routeA].size()); positionA++)
+                                {
+                                    for (int positionB = 0; positionB + lengthB <= static_cast<int>(genome[routeB].size()); positionB++)
+                                    {
+                                        changed = trySegmentSwap(routeA, positionA, lengthA, routeB, positionB, lengthB) || changed;
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+            return changed;
+        }
+    };
+}
+
+auto interRouteSearch(Genome &genome, const ProblemInstance &problemInstance, const InterRouteNeighbourhoods &neighbourhoods) -> bool
+{
+    if (genome.size() < 2)
+    {
+        return false;
+    }
+    InterRouteSearch search(genome, problemInstance);
+    const bool granular = neighbourhoods.useNeighbourLists && !problemInstance.neighbours.empty();
+    bool changed = false;
+    while (granular ? search.granularSweep(neighbourhoods) : search.sweep(neighbourhoods))
+    {
+        changed = true;
+    }
+    return changed;
+}
+
+auto orOptSearch(Genome &genome, const ProblemInstance &problemInstance, int maxSegmentLength, bool useNeighbourLists) -> bool
+{
+    InterRouteSearch search(genome, problemInstance);
+    const bool granular = useNeighbourLists && !problemInstance.neighbours.empty();
+    bool changed = false;
+    while (search.orOptSweep(maxSegmentLength, granular))
+    {
+        changed = true;
+    }
+    return changed;
+}
+
+auto isInsertionFeasible(const Journey &journey, const RouteSchedule &schedule, int position, int patientId, const ProblemInstance &problemInstance) -> bool
+{
+    return schedule.load + problemInstance.patientTable[patientId].demand <= problemInstance.nurseCapacity &&
+           isJoinFeasible(journey, schedule, position - 1, &patientId, 1, journey, schedule, position, problemInstance);
+}
@@ -0,0 +1,95 @@
+#include "logging.h"
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <spdlog/spdlog.h>
+#include <spdlog/async.h>
+#include <spdlog/sinks/basic_file_sink.h>
+
+namespace {
+std::shared_ptr<spdlog::logger> mainLoggerHandle;
+std::shared_ptr<spdlog::logger> statisticsLoggerHandle;
+} // namespace
+
+auto initLogger(const LoggingConfig &loggingConfig) -> void
+{
+    std::string main_log_file_path = "logfile.txt";
+    std::string statistics_log_file_path = "statistics.txt";
+
+    // Check if log files exist, and if so, remove them
+    if (std::filesystem::exists(main_log_file_path)) {
+        std::filesystem::remove(main_log_file_path);
+    }
+
+    if (std::filesystem::exists(statistics_log_file_path)) {
+        std::filesystem::remove(statistics_log_file_path);
+    }
+
+    // Create a basic file sink
+    auto main_file_sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(main_log_file_path);
+    auto statistics_file_sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(statistics_log_file_path);
+
+    // Create the loggers. In async mode both share one background thread that owns the disk I/O,
+    // so the optimizer only pays for formatting the record and pushing it into the queue.
+    std::shared_ptr<spdlog::logger> logger;
+    std::shared_ptr<spdlog::logger> statistics_logger;
+    if (loggingConfig.async)
+    {
+        spdlog::init_thread_pool(loggingConfig.queueSize, 1);
+        spdlog::async_overflow_policy overflowPolicy = loggingConfig.dropMainRecordsWhenQueueFull ? spdlog::async_overflow_policy::overrun_oldest : spdlog::async_overflow_policy::block;
+        logger = std::make_shared<spdlog::async_logger>("main_logger", main_file_sink, spdlog::thread_pool(), overflowPolicy);
+        statistics_logger = std::make_shared<spdlog::async_logger>("statistics_logger", statistics_file_sink, spdlog::thread_pool(), spdlog::async_overflow_policy::block);
+    }
+    else
+    {
+        logger = std::make_shared<spdlog::logger>("main_logger", main_file_sink);
+        statistics_logger = std::make_shared<spdlog::logger>("statistics_logger", statistics_file_sink);
+    }
+
+    // Set the logging pattern with the thread id
+    logger->set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%t] [%l] %v");
+    statistics_logger->set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%t] [%l] %v");
+
+
+    #if defined(PRODUCTION)
+        logger->set_level(spdlog::level::debug);
+        statistics_logger->set_level(spdlog::level::debug);
+    #else
+        logger->set_level(spdlog::level::trace);
+        statistics_logger->set_level(spdlog::level::trace);
+    #endif
+
+    // Flush policy: warnings and errors are written out right away, everything else periodically
+    logger->flush_on(loggingConfig.flushLevel);
+    statistics_logger->flush_on(loggingConfig.flushLevel);
+
+    // Register the logger
+    spdlog::register_logger(logger);
+    spdlog::register_logger(statistics_logger);
+    mainLoggerHandle = logger;
+    statisticsLoggerHandle = statistics_logger;
+
+    if (loggingConfig.flushIntervalSeconds > 0)
+    {
+        spdlog::flush_every(std::chrono::seconds(loggingConfig.flushIntervalSeconds));
+    }
+}
+
+auto mainLogger() -> spdlog::logger &
+{
+    return *mainLoggerHandle;
+}
+
+auto statisticsLogger() -> spdlog::logger &
+{
+    return *statisticsLoggerHandle;
+}
+
+auto shutdownLogger() -> void
+{
+    // drains the async queue, flushes every sink and joins the background threads
+    spdlog::shutdown();
+    mainLoggerHandle.reset();
+    statisticsLoggerHandle.reset();
+}
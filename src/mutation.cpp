@@ -1,8 +1,13 @@
 #include "mutation.h"
 #include "RandomGenerator.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <spdlog/spdlog.h>
 #include "utils.h"
+#include "logging.h"
+#include "localSearch.h"
+#include "ruinAndRecreate.h"
 
 auto reassignOnePatient(Genome &genome, const FunctionParameters &parameters) -> Genome
 {
@@ -70,8 +75,8 @@ auto swapBetweenJourneys(Genome &genome, const FunctionParameters &parameters) -
 
 auto insertWithinJourney(Genome &genome, const FunctionParameters &parameters) -> Genome
 {
-    auto logger = spdlog::get("main_logger");
-    logger->trace("Starting insertWithinJourney mutation");
+    spdlog::logger &logger = mainLogger();
+    LOG_TRACE(logger, "Starting insertWithinJourney mutation");
     RandomGenerator& rng = RandomGenerator::getInstance();
     int nurse;
     do {
@@ -83,20 +88,60 @@ auto insertWithinJourney(Genome &genome, const FunctionParameters &parameters) -
     do{
         insertionPoint = rng.generateRandomInt(0, genome[nurse].size() - 1);
     }while(insertionPoint == patientIndex);
-    logger->trace("Inserting patient {} from index {} at index {} in nurse {}", patient, patientIndex, insertionPoint, nurse);
-    logger->trace("Trip before mutation: {}", fmt::join(genome[nurse], ", "));
+    LOG_TRACE(logger, "Inserting patient {} from index {} at index {} in nurse {}", patient, patientIndex, insertionPoint, nurse);
+    LOG_TRACE(logger, "Trip before mutation: {}", fmt::join(genome[nurse], ", "));
     // insert patient at insertion point
     genome[nurse].erase(genome[nurse].begin() + patientIndex);
     genome[nurse].insert(genome[nurse].begin() + insertionPoint, patient);
-    logger->trace("Trip after mutation: {}", fmt::join(genome[nurse], ", "));
+    LOG_TRACE(logger, "Trip after mutation: {}", fmt::join(genome[nurse], ", "));
+    return genome;
+}
+
+auto moveToNeighbour(Genome &genome, const FunctionParameters &parameters) -> Genome
+{
+    spdlog::logger &logger = mainLogger();
+    LOG_TRACE(logger, "Starting moveToNeighbour mutation");
+    const ProblemInstance &instance = std::get<ProblemInstance>(parameters.at("problem_instance"));
+    RandomGenerator& rng = RandomGenerator::getInstance();
+    int sourceNurse;
+    do {
+        sourceNurse = rng.generateRandomInt(0, genome.size() - 1);
+    } while (genome[sourceNurse].empty());
+    int patientIndex = rng.generateRandomInt(0, genome[sourceNurse].size() - 1);
+    int patient = genome[sourceNurse][patientIndex];
+    if (patient >= static_cast<int>(instance.neighbours.size()) || instance.neighbours[patient].empty())
+    {
+        LOG_TRACE(logger, "Patient {} has no neighbours --> returning original genome", patient);
+        return genome;
+    }
+    const std::vector<int> &neighbours = instance.neighbours[patient];
+    int neighbour = neighbours[rng.generateRandomInt(0, neighbours.size() - 1)];
+    bool insertBehind = rng.generateRandomInt(0, 1) == 1;
+    genome[sourceNurse].erase(genome[sourceNurse].begin() + patientIndex);
+    for (Journey &journey : genome)
+    {
+        auto position = std::find(journey.begin(), journey.end(), neighbour);
+        if (position != journey.end())
+        {
+            journey.insert(insertBehind ? position + 1 : position, patient);
+            return genome;
+        }
+    }
+    // the neighbour is not part of the genome, put the patient back
+    genome[sourceNurse].insert(genome[sourceNurse].begin() + patientIndex, patient);
     return genome;
 }
 
 auto twoOpt(Genome &genome, const FunctionParameters &parameters) -> Genome
 {
-    auto logger = spdlog::get("main_logger");
-    logger->info("Starting 2-opt mutation");
-    const ProblemInstance instance = std::get<ProblemInstance>(parameters.at("problem_instance"));
+    spdlog::logger &logger = mainLogger();
+    LOG_TRACE(logger, "Starting 2-opt mutation");
+    const ProblemInstance &instance = std::get<ProblemInstance>(parameters.at("problem_instance"));
+    ImprovementStrategy strategy = ImprovementStrategy::FirstImprovement;
+    if (parameters.find("improvement_strategy") != parameters.end())
+    {
+        strategy = parseImprovementStrategy(std::get<std::string>(parameters.at("improvement_strategy")));
+    }
     RandomGenerator& rng = RandomGenerator::getInstance();
     int nurse;
     std::vector<int> nursesWithMoreThanFourPatients;
@@ -106,49 +151,97 @@ auto twoOpt(Genome &genome, const FunctionParameters &parameters) -> Genome
         }
     }
     if (nursesWithMoreThanFourPatients.empty()) {
-        logger->warn("No nurse with more than 4 patients found --> no 2-opt possible --> returning original genome");
+        logger.warn("No nurse with more than 4 patients found --> no 2-opt possible --> returning original genome");
         return genome;
     }
 
     nurse = nursesWithMoreThanFourPatients[rng.generateRandomInt(0, nursesWithMoreThanFourPatients.size() - 1)];
-    bool foundImprovement;
-    do{
-        foundImprovement = false;
-        
-        for (int i = -1; i <= static_cast<int>(genome[nurse].size() - 2); i++){
-            for (int j = i+1; j < genome[nurse].size(); j++){
-                Journey journey = genome[nurse];
-                double oldCost; 
-                double newCost;
-                if (i == -1) {
-                    if (j == genome[nurse].size() - 1) {
-                        oldCost = instance.travelTime[0][journey[i+1]] + instance.travelTime[journey[j]][0];
-                        newCost = instance.travelTime[0][journey[j]] + instance.travelTime[journey[i+1]][0];
-                    } else {
-                        oldCost = instance.travelTime[0][journey[i+1]] + instance.travelTime[journey[j]][journey[j+1]];
-                        newCost = instance.travelTime[0][journey[j]] + instance.travelTime[journey[i+1]][journey[j+1]];
-                    }
-                } else if (j == genome[nurse].size() - 1) {
-                    oldCost = instance.travelTime[journey[i]][journey[i+1]] + instance.travelTime[journey[j]][0];
-                    newCost = instance.travelTime[journey[i]][journey[j]] + instance.travelTime[journey[i+1]][0];
-                } else {
-                    oldCost = instance.travelTime[journey[i]][journey[i+1]] + instance.travelTime[journey[j]][journey[j+1]];
-                    newCost = instance.travelTime[journey[i]][journey[j]] + instance.travelTime[journey[i+1]][journey[j+1]];
-                }     
-                if (newCost < oldCost) {
-                    foundImprovement = true;
-                    std::reverse(journey.begin() + i + 1, journey.begin() + j + 1);
-                    genome[nurse] = journey;
-                }           
-            }
-        }
-    }while(foundImprovement);
+    twoOptJourney(genome[nurse], instance, strategy);
+    return genome;
+}
+
+auto interRouteLocalSearch(Genome &genome, const FunctionParameters &parameters) -> Genome
+{
+    if (parameters.find("problem_instance") == parameters.end())
+    {
+        throw std::invalid_argument("interRouteLocalSearch requires 'problem_instance'");
+    }
+    const ProblemInstance &instance = std::get<ProblemInstance>(parameters.at("problem_instance"));
+    // every neighbourhood is used unless it is switched off explicitly
+    auto isEnabled = [&parameters](const std::string &name)
+    {
+        return parameters.find(name) == parameters.end() || std::get<bool>(parameters.at(name));
+    };
+    InterRouteNeighbourhoods neighbourhoods;
+    neighbourhoods.relocate = isEnabled("relocate");
+    neighbourhoods.exchange = isEnabled("exchange");
+    neighbourhoods.twoOptStar = isEnabled("two_opt_star");
+    neighbourhoods.crossExchange = isEnabled("cross_exchange");
+    if (parameters.find("max_segment_length") != parameters.end())
+    {
+        neighbourhoods.maxSegmentLength = std::get<int>(parameters.at("max_segment_length"));
+    }
+    interRouteSearch(genome, instance, neighbourhoods);
+    return genome;
+}
+
+auto orOpt(Genome &genome, const FunctionParameters &parameters) -> Genome
+{
+    if (parameters.find("problem_instance") == parameters.end())
+    {
+        throw std::invalid_argument("orOpt requires 'problem_instance'");
+    }
+    const ProblemInstance &instance = std::get<ProblemInstance>(parameters.at("problem_instance"));
+    int maxSegmentLength = 3;
+    if (parameters.find("max_segment_length") != parameters.end())
+    {
+        maxSegmentLength = std::get<int>(parameters.at("max_segment_length"));
+    }
+    orOptSearch(genome, instance, maxSegmentLength);
+    return genome;
+}
+
+auto ruinAndRecreate(Genome &genome, const FunctionParameters &parameters) -> Genome
+{
+    if (parameters.find("problem_instance") == parameters.end())
+    {
+        throw std::invalid_argument("ruinAndRecreate requires 'problem_instance'");
+    }
+    const ProblemInstance &instance = std::get<ProblemInstance>(parameters.at("problem_instance"));
+    double removalFraction = 0.15;
+    if (parameters.find("removal_fraction") != parameters.end())
+    {
+        removalFraction = std::get<double>(parameters.at("removal_fraction"));
+    }
+    int regret = 2;
+    if (parameters.find("regret") != parameters.end())
+    {
+        regret = std::get<int>(parameters.at("regret"));
+    }
+    std::string strategyName = "mixed";
+    if (parameters.find("removal_strategy") != parameters.end())
+    {
+        strategyName = std::get<std::string>(parameters.at("removal_strategy"));
+    }
+    RemovalStrategy strategy;
+    if (strategyName == "mixed")
+    {
+        const RemovalStrategy strategies[] = {RemovalStrategy::Random, RemovalStrategy::Related, RemovalStrategy::Worst, RemovalStrategy::Route};
+        strategy = strategies[RandomGenerator::getInstance().generateRandomInt(0, 3)];
+    }
+    else
+    {
+        strategy = parseRemovalStrategy(strategyName);
+    }
+    const int numberOfPatients = std::max(1, static_cast<int>(std::lround(removalFraction * instance.patients.size())));
+    std::vector<int> removed = removePatients(genome, instance, strategy, numberOfPatients);
+    regretInsertion(genome, removed, instance, regret);
     return genome;
 }
 
 auto inverseJourney(Genome &genome, const FunctionParameters &parameters) -> Genome{
-    auto logger = spdlog::get("main_logger");
-    logger->trace("Starting inverseJourney mutation");
+    spdlog::logger &logger = mainLogger();
+    LOG_TRACE(logger, "Starting inverseJourney mutation");
     RandomGenerator& rng = RandomGenerator::getInstance();
     int nurse;
     do{
@@ -164,8 +257,8 @@ auto inverseJourney(Genome &genome, const FunctionParameters &parameters) -> Gen
 }
 
 auto splitJourney(Genome &genome, const FunctionParameters &parameters) -> Genome{
-    auto logger = spdlog::get("main_logger");
-    logger->trace("Starting splitJourney mutation");
+    spdlog::logger &logger = mainLogger();
+    LOG_TRACE(logger, "Starting splitJourney mutation");
     RandomGenerator& rng = RandomGenerator::getInstance();
     int destinationNurse = -1;
     for (int i = 0; i < genome.size(); i++){
@@ -175,7 +268,7 @@ auto splitJourney(Genome &genome, const FunctionParameters &parameters) -> Genom
         }
     }
     if (destinationNurse == -1){
-        logger->info("No nurse with 0 patients found --> returning original genome");
+        logger.info("No nurse with 0 patients found --> returning original genome");
         return genome;
     }
     int sourceNurse;
@@ -265,9 +358,8 @@ auto insertionHeuristic(Genome& genome, const FunctionParameters &parameters) ->
             }
         }
         if(minDetour == UINT_MAX || minDetourIndex == UINT_MAX || nurseID == UINT_MAX){
-            auto main_logger = spdlog::get("main_logger");
             // TODO: better logging
-            main_logger->warn("No valid insert found returning original genome");
+            mainLogger().warn("No valid insert found returning original genome");
             return genome;
         }
         // insert patient at selected position
@@ -0,0 +1,119 @@
+#include "operatorSelection.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+AdaptiveOperatorSelection::AdaptiveOperatorSelection(const std::vector<double> &rates, double minimumProbability, double adaptationRate)
+    : minimumProbability(minimumProbability), adaptationRate(adaptationRate), qualities(rates), improvements(rates.size(), 0.0), seconds(rates.size(), 0.0), applications(rates.size(), 0)
+{
+    if (rates.empty())
+    {
+        throw std::invalid_argument("Adaptive operator selection needs at least one operator");
+    }
+    if (minimumProbability < 0.0 || minimumProbability * static_cast<double>(rates.size()) >= 1.0)
+    {
+        throw std::invalid_argument("The minimum operator probability must be in [0, 1 / number of operators)");
+    }
+    if (adaptationRate <= 0.0 || adaptationRate > 1.0)
+    {
+        throw std::invalid_argument("The operator adaptation rate must be in (0, 1]");
+    }
+    double totalRate = 0.0;
+    for (double rate : rates)
+    {
+        if (rate < 0.0)
+        {
+            throw std::invalid_argument("Operator rates must not be negative");
+        }
+        totalRate += rate;
+    }
+    if (totalRate <= 0.0)
+    {
+        throw std::invalid_argument("At least one operator rate must be positive");
+    }
+    for (double &quality : qualities)
+    {
+        quality /= totalRate;
+    }
+    updateProbabilities();
+}
+
+void AdaptiveOperatorSelection::updateProbabilities()
+{
+    const double sharedProbability = 1.0 - minimumProbability * static_cast<double>(qualities.size());
+    probabilities.resize(qualities.size());
+    for (std::size_t operatorIndex = 0; operatorIndex < qualities.size(); operatorIndex++)
+    {
+        probabilities[operatorIndex] = minimumProbability + sharedProbability * qualities[operatorIndex];
+    }
+}
+
+auto AdaptiveOperatorSelection::selectOperator(double randomValue) const -> std::size_t
+{
+    double cumulativeProbability = 0.0;
+    for (std::size_t operatorIndex = 0; operatorIndex < probabilities.size(); operatorIndex++)
+    {
+        cumulativeProbability += probabilities[operatorIndex];
+        if (randomValue < cumulativeProbability)
+        {
+            return operatorIndex;
+        }
+    }
+    // rounding can leave the sum slightly below 1
+    return probabilities.size() - 1;
+}
+
+void AdaptiveOperatorSelection::recordApplication(std::size_t operatorIndex, double seconds)
+{
+    applications[operatorIndex]++;
+    this->seconds[operatorIndex] += seconds;
+}
+
+void AdaptiveOperatorSelection::recordImprovement(std::size_t operatorIndex, double improvement)
+{
+    improvements[operatorIndex] += improvement;
+}
+
+void AdaptiveOperatorSelection::endGeneration()
+{
+    // the applied operators share the quality they had before, split by their improvement per second
+    double appliedQuality = 0.0;
+    double totalReward = 0.0;
+    std::vector<double> rewards(qualities.size(), 0.0);
+    for (std::size_t operatorIndex = 0; operatorIndex < qualities.size(); operatorIndex++)
+    {
+        if (applications[operatorIndex] == 0)
+        {
+            continue;
+        }
+        appliedQuality += qualities[operatorIndex];
+        // very fast operators are measured with at least a microsecond per application
+        rewards[operatorIndex] = improvements[operatorIndex] / std::max(seconds[operatorIndex], applications[operatorIndex] * 1e-6);
+        totalReward += rewards[operatorIndex];
+    }
+    if (totalReward > 0.0)
+    {
+        for (std::size_t operatorIndex = 0; operatorIndex < qualities.size(); operatorIndex++)
+        {
+            if (applications[operatorIndex] > 0)
+            {
+                const double target = appliedQuality * rewards[operatorIndex] / totalReward;
+                qualities[operatorIndex] += adaptationRate * (target - qualities[operatorIndex]);
+            }
+        }
+        updateProbabilities();
+    }
+    std::fill(improvements.begin(), improvements.end(), 0.0);
+    std::fill(seconds.begin(), seconds.end(), 0.0);
+    std::fill(applications.begin(), applications.end(), 0);
+}
+
+void AdaptiveOperatorSelection::setQualities(const std::vector<double> &qualities)
+{
+    if (qualities.size() != this->qualities.size())
+    {
+        throw std::invalid_argument("Expected " + std::to_string(this->qualities.size()) + " operator qualities but got " + std::to_string(qualities.size()));
+    }
+    this->qualities = qualities;
+    updateProbabilities();
+}
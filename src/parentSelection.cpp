@@ -6,6 +6,7 @@
 #include <iostream>
 #include <stdexcept>
 #include <spdlog/spdlog.h>
+#include "logging.h"
 
 
 auto rouletteWheelSelection(const Population &population, const FunctionParameters &parameters, const int populationSize) -> Population
@@ -57,7 +58,7 @@ auto rouletteWheelSelection(const Population &population, const FunctionParamete
 
 auto tournamentSelection(const Population &population, const FunctionParameters &parameters, const int populationSize) -> Population
 {
-    auto mainLogger = spdlog::get("main_logger");
+    spdlog::logger &logger = mainLogger();
     // check that the parameters are present
     if (parameters.find("tournamentSize") == parameters.end() || parameters.find("tournamentProbability") == parameters.end())
     {
@@ -66,8 +67,8 @@ auto tournamentSelection(const Population &population, const FunctionParameters
 
     int tournamentSize = std::get<int>(parameters.at("tournamentSize"));
     double tournamentProbability = std::get<double>(parameters.at("tournamentProbability"));
-    mainLogger->trace("TournamentSize {}", tournamentSize);
-    mainLogger->trace("TournamentProbability {}", tournamentProbability);
+    LOG_TRACE(logger, "TournamentSize {}", tournamentSize);
+    LOG_TRACE(logger, "TournamentProbability {}", tournamentProbability);
     Population parents;
     RandomGenerator &rng = RandomGenerator::getInstance();
     for (int i = 0; i < populationSize; i++)
@@ -0,0 +1,311 @@
+#include "populationExport.h"
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include "nlohmann/json.hpp"
+
+using json = nlohmann::json;
+
+namespace {
+    constexpr char POPULATION_MAGIC[8] = {'B', 'I', 'O', 'A', 'I', 'P', 'O', 'P'};
+    constexpr std::uint32_t POPULATION_VERSION = 1;
+
+    // the values are written in the byte order of the machine, the format promises little endian
+    static_assert(std::endian::native == std::endian::little);
+
+    template <typename T>
+    auto writeValue(std::ostream &stream, const T &value) -> void
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        stream.write(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    auto readValue(std::istream &stream) -> T
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        T value;
+        if (!stream.read(reinterpret_cast<char *>(&value), sizeof(T)))
+        {
+            throw std::runtime_error("Population export is truncated");
+        }
+        return value;
+    }
+
+    // Reads a count and checks that the rest of the file can hold that many elements of at least elementSize bytes,
+    // so a corrupt count is reported instead of being used to allocate
+    auto readCount(std::istream &stream, std::uint64_t fileSize, std::uint64_t elementSize) -> std::size_t
+    {
+        const auto count = readValue<std::uint32_t>(stream);
+        const auto remaining = fileSize - static_cast<std::uint64_t>(stream.tellg());
+        if (count > remaining / elementSize)
+        {
+            throw std::runtime_error("Population export is truncated");
+        }
+        return count;
+    }
+
+    // an individual without journeys still holds its fitness, travel time, valid and the number of journeys
+    constexpr std::uint64_t MINIMUM_INDIVIDUAL_SIZE = 2 * sizeof(double) + sizeof(std::uint8_t) + sizeof(std::uint16_t);
+
+    auto narrow(long long value, const char *what) -> std::uint16_t
+    {
+        if (value < 0 || value > std::numeric_limits<std::uint16_t>::max())
+        {
+            throw std::runtime_error(std::string("The binary population export can not store ") + what + " " + std::to_string(value));
+        }
+        return static_cast<std::uint16_t>(value);
+    }
+
+    // shortest representation that reads back as the same double
+    auto appendNumber(std::string &line, double value) -> void
+    {
+        char buffer[32];
+        const auto result = std::to_chars(std::begin(buffer), std::end(buffer), value);
+        line.append(buffer, result.ptr);
+    }
+
+    auto appendNumber(std::string &line, int value) -> void
+    {
+        char buffer[16];
+        const auto result = std::to_chars(std::begin(buffer), std::end(buffer), value);
+        line.append(buffer, result.ptr);
+    }
+
+    auto readBinary(std::istream &stream, std::uint64_t fileSize) -> PopulationExport
+    {
+        if (readValue<std::uint32_t>(stream) != POPULATION_VERSION)
+        {
+            throw std::runtime_error("Population export was written by an incompatible build");
+        }
+        PopulationExport populationExport;
+        populationExport.instanceName.resize(readCount(stream, fileSize, 1));
+        if (!stream.read(populationExport.instanceName.data(), static_cast<std::streamsize>(populationExport.instanceName.size())))
+        {
+            throw std::runtime_error("Population export is truncated");
+        }
+        // a snapshot starts with its generation, the end of the file may only come before one
+        while (stream.peek() != std::char_traits<char>::eof())
+        {
+            PopulationSnapshot &snapshot = populationExport.snapshots.emplace_back();
+            snapshot.generation = readValue<std::int32_t>(stream);
+            snapshot.population.resize(readCount(stream, fileSize, MINIMUM_INDIVIDUAL_SIZE));
+            for (Individual &individual : snapshot.population)
+            {
+                individual.fitness = readValue<double>(stream);
+                individual.travelTime = readValue<double>(stream);
+                individual.valid = readValue<std::uint8_t>(stream) != 0;
+                individual.genome.resize(readValue<std::uint16_t>(stream));
+                for (Journey &journey : individual.genome)
+                {
+                    journey.resize(readValue<std::uint16_t>(stream));
+                    for (int &patientId : journey)
+                    {
+                        patientId = readValue<std::uint16_t>(stream);
+                    }
+                }
+            }
+        }
+        return populationExport;
+    }
+
+    auto readJsonLines(std::istream &stream) -> PopulationExport
+    {
+        PopulationExport populationExport;
+        std::string line;
+        while (std::getline(stream, line))
+        {
+            if (line.empty())
+            {
+                continue;
+            }
+            try
+            {
+                const json snapshotJson = json::parse(line);
+                populationExport.instanceName = snapshotJson.at("instance").get<std::string>();
+                PopulationSnapshot &snapshot = populationExport.snapshots.emplace_back();
+                snapshot.generation = snapshotJson.at("generation").get<int>();
+                for (const json &individualJson : snapshotJson.at("individuals"))
+                {
+                    Individual &individual = snapshot.population.emplace_back();
+                    individual.fitness = individualJson.at("fitness").get<double>();
+                    individual.travelTime = individualJson.at("travelTime").get<double>();
+                    individual.valid = individualJson.at("valid").get<bool>();
+                    individual.genome = individualJson.at("genome").get<Genome>();
+                }
+            }
+            catch (const json::exception &exception)
+            {
+                throw std::runtime_error(std::string("Population export has an invalid line: ") + exception.what());
+            }
+        }
+        return populationExport;
+    }
+}
+
+auto PopulationWriter::snapshotsToKeep(const std::string &path, PopulationExportFormat format, const std::string &instanceName, int resumedGeneration) -> std::vector<PopulationSnapshot>
+{
+    {
+        std::ifstream stream(path, std::ios::binary);
+        if (!stream || stream.peek() == std::char_traits<char>::eof())
+        {
+            // nothing was exported before the checkpoint
+            return {};
+        }
+        char magic[sizeof(POPULATION_MAGIC)];
+        const bool binary = stream.read(magic, sizeof(magic)) && std::equal(std::begin(magic), std::end(magic), std::begin(POPULATION_MAGIC));
+        if (binary != (format == PopulationExportFormat::Binary))
+        {
+            throw std::runtime_error(path + " was exported in another format");
+        }
+    }
+    PopulationExport populationExport = readPopulationExport(path);
+    if (!populationExport.snapshots.empty() && populationExport.instanceName != instanceName)
+    {
+        throw std::runtime_error(path + " is the export of instance " + populationExport.instanceName);
+    }
+    // snapshots written after the checkpoint are written again by the resumed run
+    std::vector<PopulationSnapshot> &snapshots = populationExport.snapshots;
+    snapshots.erase(std::remove_if(snapshots.begin(), snapshots.end(), [resumedGeneration](const PopulationSnapshot &snapshot) { return snapshot.generation > resumedGeneration; }), snapshots.end());
+    return std::move(snapshots);
+}
+
+PopulationWriter::PopulationWriter(const std::string &path, PopulationExportFormat format, const std::string &instanceName, int resumedGeneration)
+    : PopulationWriter(path, format, instanceName, snapshotsToKeep(path, format, instanceName, resumedGeneration))
+{
+}
+
+PopulationWriter::PopulationWriter(const std::string &path, PopulationExportFormat format, const std::string &instanceName, const std::vector<PopulationSnapshot> &snapshots)
+    : PopulationWriter(path, format, instanceName)
+{
+    for (const PopulationSnapshot &snapshot : snapshots)
+    {
+        writeSnapshot(snapshot.generation, snapshot.population);
+    }
+}
+
+PopulationWriter::PopulationWriter(const std::string &path, PopulationExportFormat format, const std::string &instanceName)
+    : stream(path, std::ios::binary | std::ios::trunc), format(format), instanceName(instanceName)
+{
+    if (!stream)
+    {
+        throw std::runtime_error("Could not open " + path + " for writing");
+    }
+    if (format == PopulationExportFormat::Binary)
+    {
+        stream.write(POPULATION_MAGIC, sizeof(POPULATION_MAGIC));
+        writeValue(stream, POPULATION_VERSION);
+        writeValue<std::uint32_t>(stream, static_cast<std::uint32_t>(instanceName.size()));
+        stream.write(instanceName.data(), static_cast<std::streamsize>(instanceName.size()));
+    }
+    else
+    {
+        // the name is escaped once and then copied into every line
+        this->instanceName = json(instanceName).dump();
+    }
+}
+
+void PopulationWriter::writeSnapshot(int generation, const Population &population)
+{
+    if (format == PopulationExportFormat::Binary)
+    {
+        writeBinarySnapshot(generation, population);
+    }
+    else
+    {
+        writeJsonLinesSnapshot(generation, population);
+    }
+    stream.flush();
+    if (!stream)
+    {
+        throw std::runtime_error("Could not write the population of generation " + std::to_string(generation));
+    }
+}
+
+void PopulationWriter::writeBinarySnapshot(int generation, const Population &population)
+{
+    writeValue<std::int32_t>(stream, generation);
+    writeValue<std::uint32_t>(stream, static_cast<std::uint32_t>(population.size()));
+    std::vector<std::uint16_t> patientIds;
+    for (const Individual &individual : population)
+    {
+        writeValue(stream, individual.fitness);
+        writeValue(stream, individual.travelTime);
+        writeValue<std::uint8_t>(stream, individual.valid);
+        writeValue(stream, narrow(static_cast<long long>(individual.genome.size()), "the number of journeys"));
+        for (const Journey &journey : individual.genome)
+        {
+            patientIds.clear();
+            patientIds.push_back(narrow(static_cast<long long>(journey.size()), "the journey length"));
+            for (int patientId : journey)
+            {
+                patientIds.push_back(narrow(patientId, "the patient id"));
+            }
+            stream.write(reinterpret_cast<const char *>(patientIds.data()), static_cast<std::streamsize>(patientIds.size() * sizeof(std::uint16_t)));
+        }
+    }
+}
+
+void PopulationWriter::writeJsonLinesSnapshot(int generation, const Population &population)
+{
+    // the line is written one individual at a time, so only one individual is ever held as text
+    std::string text = "{\"instance\":" + instanceName + ",\"generation\":";
+    appendNumber(text, generation);
+    text += ",\"individuals\":[";
+    stream << text;
+    for (std::size_t index = 0; index < population.size(); index++)
+    {
+        const Individual &individual = population[index];
+        text.assign(index == 0 ? "{\"fitness\":" : ",{\"fitness\":");
+        appendNumber(text, individual.fitness);
+        text += ",\"travelTime\":";
+        appendNumber(text, individual.travelTime);
+        text += individual.valid ? ",\"valid\":true,\"genome\":[" : ",\"valid\":false,\"genome\":[";
+        for (std::size_t journey = 0; journey < individual.genome.size(); journey++)
+        {
+            text += journey == 0 ? "[" : ",[";
+            for (std::size_t patient = 0; patient < individual.genome[journey].size(); patient++)
+            {
+                if (patient > 0)
+                {
+                    text += ',';
+                }
+                appendNumber(text, individual.genome[journey][patient]);
+            }
+            text += ']';
+        }
+        text += "]}";
+        stream << text;
+    }
+    stream << "]}\n";
+}
+
+auto readPopulationExport(const std::string &path) -> PopulationExport
+{
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream)
+    {
+        throw std::runtime_error("Could not open " + path);
+    }
+    char magic[sizeof(POPULATION_MAGIC)];
+    if (stream.read(magic, sizeof(magic)) && std::equal(std::begin(magic), std::end(magic), std::begin(POPULATION_MAGIC)))
+    {
+        // the counts in the file are checked against its size before anything is allocated for them
+        stream.seekg(0, std::ios::end);
+        const auto fileSize = static_cast<std::uint64_t>(stream.tellg());
+        stream.seekg(sizeof(POPULATION_MAGIC));
+        return readBinary(stream, fileSize);
+    }
+    stream.clear();
+    stream.seekg(0);
+    if (stream.peek() != '{')
+    {
+        throw std::runtime_error(path + " is not a population export");
+    }
+    return readJsonLines(stream);
+}
@@ -0,0 +1,224 @@
+#include "profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include "nlohmann/json.hpp"
+
+using json = nlohmann::json;
+
+namespace {
+thread_local std::uint64_t allocationCounter = 0;
+
+auto histogramBucket(double seconds) -> int
+{
+    double microseconds = seconds * 1e6;
+    if (microseconds < 1.0)
+    {
+        return 0;
+    }
+    int bucket = static_cast<int>(std::log2(microseconds)) + 1;
+    return std::min(bucket, PROFILER_HISTOGRAM_BUCKETS - 1);
+}
+
+auto merge(SectionStatistics &target, const SectionStatistics &source) -> void
+{
+    target.calls += source.calls;
+    target.totalSeconds += source.totalSeconds;
+    target.maxSeconds = std::max(target.maxSeconds, source.maxSeconds);
+    target.allocations += source.allocations;
+    for (int i = 0; i < PROFILER_HISTOGRAM_BUCKETS; i++)
+    {
+        target.histogram[i] += source.histogram[i];
+    }
+}
+
+auto sectionToJson(const SectionStatistics &statistics, bool withHistogram) -> json
+{
+    json sectionJson;
+    sectionJson["calls"] = statistics.calls;
+    sectionJson["totalSeconds"] = statistics.totalSeconds;
+    sectionJson["maxSeconds"] = statistics.maxSeconds;
+    sectionJson["allocations"] = statistics.allocations;
+    if (withHistogram)
+    {
+        sectionJson["histogramMicrosecondsLog2"] = statistics.histogram;
+    }
+    return sectionJson;
+}
+} // namespace
+
+#if defined(PROFILE_ALLOCATIONS)
+// Replace the global allocation functions to count allocations per thread
+auto operator new(std::size_t size) -> void *
+{
+    allocationCounter++;
+    if (void *pointer = std::malloc(size == 0 ? 1 : size))
+    {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+auto operator new[](std::size_t size) -> void *
+{
+    return operator new(size);
+}
+
+void operator delete(void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+#endif
+
+auto threadAllocationCount() -> std::uint64_t
+{
+    return allocationCounter;
+}
+
+auto Profiler::getInstance() -> Profiler &
+{
+    static Profiler instance;
+    return instance;
+}
+
+void Profiler::setEnabled(bool enabled)
+{
+    this->enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void Profiler::reset()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    evaluations = 0;
+    currentGeneration.clear();
+    totals.clear();
+    generations.clear();
+    generationHistogram.fill(0);
+    generationStart = std::chrono::steady_clock::now();
+}
+
+void Profiler::record(const std::string &section, double seconds, std::uint64_t allocations)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    SectionStatistics &statistics = currentGeneration[section];
+    statistics.calls++;
+    statistics.totalSeconds += seconds;
+    statistics.maxSeconds = std::max(statistics.maxSeconds, seconds);
+    statistics.allocations += allocations;
+    statistics.histogram[histogramBucket(seconds)]++;
+}
+
+void Profiler::endGeneration(int generation)
+{
+    if (!isEnabled())
+    {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    GenerationProfile profile;
+    profile.generation = generation;
+    profile.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - generationStart).count();
+    profile.evaluations = evaluations.exchange(0, std::memory_order_relaxed);
+    for (const auto &[section, statistics] : currentGeneration)
+    {
+        merge(totals[section], statistics);
+    }
+    profile.sections = std::move(currentGeneration);
+    currentGeneration.clear();
+    generationHistogram[histogramBucket(profile.wallSeconds)]++;
+    generations.push_back(std::move(profile));
+    generationStart = std::chrono::steady_clock::now();
+}
+
+void Profiler::exportJson(const std::string &path) const
+{
+    json profileJson;
+    std::uint64_t totalEvaluations = 0;
+    double totalSeconds = 0.0;
+    json generationsJson = json::array();
+    for (const GenerationProfile &profile : generations)
+    {
+        totalEvaluations += profile.evaluations;
+        totalSeconds += profile.wallSeconds;
+        json generationJson;
+        generationJson["generation"] = profile.generation;
+        generationJson["wallSeconds"] = profile.wallSeconds;
+        generationJson["evaluations"] = profile.evaluations;
+        for (const auto &[section, statistics] : profile.sections)
+        {
+            generationJson["sections"][section] = sectionToJson(statistics, false);
+        }
+        generationsJson.push_back(generationJson);
+    }
+    profileJson["generations"] = generationsJson;
+    profileJson["totalWallSeconds"] = totalSeconds;
+    profileJson["totalEvaluations"] = totalEvaluations;
+    profileJson["generationHistogramMicrosecondsLog2"] = generationHistogram;
+    for (const auto &[section, statistics] : totals)
+    {
+        profileJson["sections"][section] = sectionToJson(statistics, true);
+    }
+    std::ofstream outputFileStream(path);
+    outputFileStream << profileJson.dump();
+}
+
+void Profiler::exportCsv(const std::string &path) const
+{
+    std::ofstream outputFileStream(path);
+    outputFileStream << "generation,wall_seconds,evaluations,section,calls,total_seconds,max_seconds,allocations\n";
+    for (const GenerationProfile &profile : generations)
+    {
+        for (const auto &[section, statistics] : profile.sections)
+        {
+            outputFileStream << profile.generation << ',' << profile.wallSeconds << ',' << profile.evaluations << ','
+                             << section << ',' << statistics.calls << ',' << statistics.totalSeconds << ','
+                             << statistics.maxSeconds << ',' << statistics.allocations << '\n';
+        }
+    }
+}
+
+ScopedTimer::ScopedTimer(const char *section) : active(Profiler::getInstance().isEnabled())
+{
+    if (active)
+    {
+        this->section = section;
+        allocationsAtStart = threadAllocationCount();
+        start = std::chrono::steady_clock::now();
+    }
+}
+
+ScopedTimer::ScopedTimer(const std::string &section) : active(Profiler::getInstance().isEnabled())
+{
+    if (active)
+    {
+        this->section = section;
+        allocationsAtStart = threadAllocationCount();
+        start = std::chrono::steady_clock::now();
+    }
+}
+
+ScopedTimer::~ScopedTimer()
+{
+    if (active)
+    {
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        Profiler::getInstance().record(section, seconds, threadAllocationCount() - allocationsAtStart);
+    }
+}
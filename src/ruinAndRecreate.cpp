@@ -0,0 +1,320 @@
+#include "ruinAndRecreate.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+#include "localSearch.h"
+#include "RandomGenerator.h"
+
+namespace {
+    // removal picks the element at position y^removalDeterminism of a ranked list, y uniform in [0, 1)
+    constexpr double removalDeterminism = 6.0;
+
+    auto pickRanked(std::size_t size) -> std::size_t
+    {
+        const double y = RandomGenerator::getInstance().generateRandomDouble(0.0, 1.0);
+        return std::min(size - 1, static_cast<std::size_t>(std::pow(y, removalDeterminism) * size));
+    }
+
+    auto assignedPatients(const Genome &genome) -> std::vector<int>
+    {
+        std::vector<int> patients;
+        for (const Journey &journey : genome)
+        {
+            patients.insert(patients.end(), journey.begin(), journey.end());
+        }
+        return patients;
+    }
+
+    void eraseRemoved(Genome &genome, const std::vector<int> &removed, std::size_t numberOfLocations)
+    {
+        std::vector<char> isRemoved(numberOfLocations, 0);
+        for (int patient : removed)
+        {
+            isRemoved[patient] = 1;
+        }
+        for (Journey &journey : genome)
+        {
+            journey.erase(std::remove_if(journey.begin(), journey.end(), [&isRemoved](int patient)
+                                         { return isRemoved[patient] != 0; }),
+                          journey.end());
+        }
+    }
+
+    // smaller is more related: normalised travel time plus normalised difference of the time windows
+    auto relatedness(int a, int b, const ProblemInstance &problemInstance, double maxTravelTime, double horizon) -> double
+    {
+        const Patient &patientA = problemInstance.patientTable[a];
+        const Patient &patientB = problemInstance.patientTable[b];
+        const double timeWindowDifference = std::abs(patientA.startTime - patientB.startTime) + std::abs(patientA.endTime - patientB.endTime);
+        return problemInstance.travelTime[a][b] / maxTravelTime + timeWindowDifference / horizon;
+    }
+
+    auto removeRelated(const Genome &genome, const ProblemInstance &problemInstance, int numberOfPatients) -> std::vector<int>
+    {
+        RandomGenerator &rng = RandomGenerator::getInstance();
+        std::vector<int> remaining = assignedPatients(genome);
+        double maxTravelTime = 1.0;
+        for (const auto &row : problemInstance.travelTime)
+        {
+            maxTravelTime = std::max(maxTravelTime, *std::max_element(row.begin(), row.end()));
+        }
+        const double horizon = std::max(1, problemInstance.depot.returnTime);
+
+        std::vector<int> removed;
+        std::size_t seedIndex = rng.generateRandomInt(0, remaining.size() - 1);
+        removed.push_back(remaining[seedIndex]);
+        remaining.erase(remaining.begin() + seedIndex);
+        while (static_cast<int>(removed.size()) < numberOfPatients && !remaining.empty())
+        {
+            const int reference = removed[rng.generateRandomInt(0, removed.size() - 1)];
+            std::sort(remaining.begin(), remaining.end(), [&](int a, int b)
+                      { return relatedness(reference, a, problemInstance, maxTravelTime, horizon) < relatedness(reference, b, problemInstance, maxTravelTime, horizon); });
+            const std::size_t picked = pickRanked(remaining.size());
+            removed.push_back(remaining[picked]);
+            remaining.erase(remaining.begin() + picked);
+        }
+        return removed;
+    }
+
+    auto removeWorst(Genome &genome, const ProblemInstance &problemInstance, int numberOfPatients) -> std::vector<int>
+    {
+        const auto &travelTime = problemInstance.travelTime;
+        std::vector<int> removed;
+        // travel time saved by removing a patient, the patient and its position
+        std::vector<std::tuple<double, int, int>> savings;
+        while (static_cast<int>(removed.size()) < numberOfPatients)
+        {
+            savings.clear();
+            for (int nurse = 0; nurse < static_cast<int>(genome.size()); nurse++)
+            {
+                const Journey &journey = genome[nurse];
+                for (int position = 0; position < static_cast<int>(journey.size()); position++)
+                {
+                    const int before = position > 0 ? journey[position - 1] : 0;
+                    const int after = position + 1 < static_cast<int>(journey.size()) ? journey[position + 1] : 0;
+                    const double saving = travelTime[before][journey[position]] + travelTime[journey[position]][after] - travelTime[before][after];
+                    savings.emplace_back(saving, nurse, position);
+                }
+            }
+            if (savings.empty())
+            {
+                break;
+            }
+            std::sort(savings.begin(), savings.end(), [](const auto &a, const auto &b)
+                      { return std::get<0>(a) > std::get<0>(b); });
+            const auto &[saving, nurse, position] = savings[pickRanked(savings.size())];
+            removed.push_back(genome[nurse][position]);
+            genome[nurse].erase(genome[nurse].begin() + position);
+        }
+        return removed;
+    }
+
+    auto removeRoutes(Genome &genome, int numberOfPatients) -> std::vector<int>
+    {
+        RandomGenerator &rng = RandomGenerator::getInstance();
+        std::vector<int> removed;
+        std::vector<int> nonEmptyNurses;
+        for (int nurse = 0; nurse < static_cast<int>(genome.size()); nurse++)
+        {
+            if (!genome[nurse].empty())
+            {
+                nonEmptyNurses.push_back(nurse);
+            }
+        }
+        rng.shuffle(nonEmptyNurses);
+        for (int nurse : nonEmptyNurses)
+        {
+            if (static_cast<int>(removed.size()) >= numberOfPatients)
+            {
+                break;
+            }
+            removed.insert(removed.end(), genome[nurse].begin(), genome[nurse].end());
+            genome[nurse].clear();
+        }
+        return removed;
+    }
+}
+
+auto parseRemovalStrategy(const std::string &strategy) -> RemovalStrategy
+{
+    if (strategy == "random")
+    {
+        return RemovalStrategy::Random;
+    }
+    if (strategy == "related")
+    {
+        return RemovalStrategy::Related;
+    }
+    if (strategy == "worst")
+    {
+        return RemovalStrategy::Worst;
+    }
+    if (strategy == "route")
+    {
+        return RemovalStrategy::Route;
+    }
+    throw std::invalid_argument("Unknown removal strategy: " + strategy);
+}
+
+auto removePatients(Genome &genome, const ProblemInstance &problemInstance, RemovalStrategy strategy, int numberOfPatients) -> std::vector<int>
+{
+    std::vector<int> removed;
+    if (numberOfPatients <= 0 || assignedPatients(genome).empty())
+    {
+        return removed;
+    }
+    switch (strategy)
+    {
+    case RemovalStrategy::Random:
+    {
+        removed = assignedPatients(genome);
+        RandomGenerator::getInstance().shuffle(removed);
+        removed.resize(std::min<std::size_t>(removed.size(), numberOfPatients));
+        eraseRemoved(genome, removed, problemInstance.patientTable.size());
+        break;
+    }
+    case RemovalStrategy::Related:
+        removed = removeRelated(genome, problemInstance, numberOfPatients);
+        eraseRemoved(genome, removed, problemInstance.patientTable.size());
+        break;
+    case RemovalStrategy::Worst:
+        removed = removeWorst(genome, problemInstance, numberOfPatients);
+        break;
+    case RemovalStrategy::Route:
+        removed = removeRoutes(genome, numberOfPatients);
+        break;
+    }
+    return removed;
+}
+
+auto regretInsertion(Genome &genome, const std::vector<int> &patients, const ProblemInstance &problemInstance, int regret) -> void
+{
+    constexpr double infeasible = std::numeric_limits<double>::infinity();
+    // stands in for the cost of a missing alternative, so that patients with few options are inserted first
+    constexpr double missingAlternativePenalty = 1e9;
+    const auto &travelTime = problemInstance.travelTime;
+    const int numberOfRoutes = static_cast<int>(genome.size());
+    if (numberOfRoutes == 0)
+    {
+        return;
+    }
+    std::vector<RouteSchedule> schedules(numberOfRoutes);
+    for (int route = 0; route < numberOfRoutes; route++)
+    {
+        buildRouteSchedule(genome[route], problemInstance, schedules[route]);
+    }
+
+    std::vector<int> pending = patients;
+    // cheapest feasible insertion cost and position of every pending patient in every route
+    std::vector<std::vector<double>> bestCost(pending.size(), std::vector<double>(numberOfRoutes, infeasible));
+    std::vector<std::vector<int>> bestPosition(pending.size(), std::vector<int>(numberOfRoutes, -1));
+    auto rateRoute = [&](std::size_t index, int route)
+    {
+        const int patient = pending[index];
+        const Journey &journey = genome[route];
+        bestCost[index][route] = infeasible;
+        bestPosition[index][route] = -1;
+        for (int position = 0; position <= static_cast<int>(journey.size()); position++)
+        {
+            const int before = position > 0 ? journey[position - 1] : 0;
+            const int after = position < static_cast<int>(journey.size()) ? journey[position] : 0;
+            const double cost = travelTime[before][patient] + travelTime[patient][after] - travelTime[before][after];
+            if (cost < bestCost[index][route] && isInsertionFeasible(journey, schedules[route], position, patient, problemInstance))
+            {
+                bestCost[index][route] = cost;
+                bestPosition[index][route] = position;
+            }
+        }
+    };
+    for (std::size_t index = 0; index < pending.size(); index++)
+    {
+        for (int route = 0; route < numberOfRoutes; route++)
+        {
+            rateRoute(index, route);
+        }
+    }
+
+    std::vector<double> costs;
+    std::vector<int> unplaceable;
+    while (!pending.empty())
+    {
+        std::size_t chosen = 0;
+        int chosenRoute = -1;
+        double chosenScore = -infeasible;
+        double chosenCost = infeasible;
+        for (std::size_t index = 0; index < pending.size(); index++)
+        {
+            costs.assign(bestCost[index].begin(), bestCost[index].end());
+            const std::size_t considered = std::min<std::size_t>(std::max(regret, 1), costs.size());
+            std::partial_sort(costs.begin(), costs.begin() + considered, costs.end());
+            if (costs.empty() || costs[0] == infeasible)
+            {
+                continue;
+            }
+            double score = 0;
+            if (regret <= 1)
+            {
+                score = -costs[0];
+            }
+            else
+            {
+                for (std::size_t alternative = 1; alternative < considered; alternative++)
+                {
+                    score += costs[alternative] == infeasible ? missingAlternativePenalty : costs[alternative] - costs[0];
+                }
+            }
+            if (score > chosenScore || (score == chosenScore && costs[0] < chosenCost))
+            {
+                chosen = index;
+                chosenScore = score;
+                chosenCost = costs[0];
+                chosenRoute = static_cast<int>(std::min_element(bestCost[index].begin(), bestCost[index].end()) - bestCost[index].begin());
+            }
+        }
+        if (chosenRoute < 0)
+        {
+            // nobody fits anywhere anymore
+            unplaceable.insert(unplaceable.end(), pending.begin(), pending.end());
+            break;
+        }
+
+        const int patient = pending[chosen];
+        genome[chosenRoute].insert(genome[chosenRoute].begin() + bestPosition[chosen][chosenRoute], patient);
+        buildRouteSchedule(genome[chosenRoute], problemInstance, schedules[chosenRoute]);
+        pending.erase(pending.begin() + chosen);
+        bestCost.erase(bestCost.begin() + chosen);
+        bestPosition.erase(bestPosition.begin() + chosen);
+        // only the changed route has to be rated again
+        for (std::size_t index = 0; index < pending.size(); index++)
+        {
+            rateRoute(index, chosenRoute);
+        }
+    }
+
+    // cheapest insertion regardless of feasibility for the rest
+    for (int patient : unplaceable)
+    {
+        double cheapest = infeasible;
+        int cheapestRoute = 0;
+        int cheapestPosition = 0;
+        for (int route = 0; route < numberOfRoutes; route++)
+        {
+            const Journey &journey = genome[route];
+            for (int position = 0; position <= static_cast<int>(journey.size()); position++)
+            {
+                const int before = position > 0 ? journey[position - 1] : 0;
+                const int after = position < static_cast<int>(journey.size()) ? journey[position] : 0;
+                const double cost = travelTime[before][patient] + travelTime[patient][after] - travelTime[before][after];
+                if (cost < cheapest)
+                {
+                    cheapest = cost;
+                    cheapestRoute = route;
+                    cheapestPosition = position;
+                }
+            }
+        }
+        genome[cheapestRoute].insert(genome[cheapestRoute].begin() + cheapestPosition, patient);
+    }
+}
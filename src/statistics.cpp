@@ -0,0 +1,161 @@
+#include "statistics.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include "utils.h"
+#include "diversity.h"
+#include "genomeHash.h"
+
+namespace {
+// Running mean and variance (Welford) together with the position of the minimum and maximum
+struct RunningStatistics
+{
+    std::size_t count = 0;
+    double mean = 0.0;
+    double squaredDistanceSum = 0.0;
+    double minimum = 0.0;
+    double maximum = 0.0;
+    std::size_t minimumIndex = 0;
+    std::size_t maximumIndex = 0;
+
+    void add(double value, std::size_t index)
+    {
+        if (count == 0 || value < minimum)
+        {
+            minimum = value;
+            minimumIndex = index;
+        }
+        if (count == 0 || value > maximum)
+        {
+            maximum = value;
+            maximumIndex = index;
+        }
+        count++;
+        double delta = value - mean;
+        mean += delta / count;
+        squaredDistanceSum += delta * (value - mean);
+    }
+
+    // Chan et al. parallel combination of two partial results
+    void merge(const RunningStatistics &other)
+    {
+        if (other.count == 0)
+        {
+            return;
+        }
+        if (count == 0)
+        {
+            *this = other;
+            return;
+        }
+        if (other.minimum < minimum)
+        {
+            minimum = other.minimum;
+            minimumIndex = other.minimumIndex;
+        }
+        if (other.maximum > maximum)
+        {
+            maximum = other.maximum;
+            maximumIndex = other.maximumIndex;
+        }
+        std::size_t combinedCount = count + other.count;
+        double delta = other.mean - mean;
+        mean += delta * other.count / combinedCount;
+        squaredDistanceSum += other.squaredDistanceSum + delta * delta * count * other.count / combinedCount;
+        count = combinedCount;
+    }
+
+    auto standardDeviation() const -> double
+    {
+        return count == 0 ? 0.0 : std::sqrt(squaredDistanceSum / count);
+    }
+};
+
+struct PartialStatistics
+{
+    int validSolutions = 0;
+    RunningStatistics fitness;
+    RunningStatistics travelTime;
+};
+
+auto processChunk(const Population &population, std::size_t begin, std::size_t end, PartialStatistics &partial, std::vector<std::uint64_t> &genomeHashes) -> void
+{
+    for (std::size_t i = begin; i < end; i++)
+    {
+        const Individual &individual = population[i];
+        if (individual.valid)
+        {
+            partial.validSolutions++;
+        }
+        partial.fitness.add(individual.fitness, i);
+        partial.travelTime.add(individual.travelTime, i);
+        genomeHashes[i] = hashGenome(individual.genome);
+    }
+}
+} // namespace
+
+auto computeGenerationStatistics(const Population &population, int numberOfThreads) -> GenerationStatistics
+{
+    GenerationStatistics statistics;
+    statistics.populationSize = population.size();
+    if (population.empty())
+    {
+        return statistics;
+    }
+
+    std::size_t numberOfChunks = std::clamp<std::size_t>(numberOfThreads, 1, population.size());
+    std::vector<PartialStatistics> partials(numberOfChunks);
+    std::vector<std::uint64_t> genomeHashes(population.size());
+    std::size_t chunkSize = (population.size() + numberOfChunks - 1) / numberOfChunks;
+    if (numberOfChunks == 1)
+    {
+        processChunk(population, 0, population.size(), partials[0], genomeHashes);
+    }
+    else
+    {
+        std::vector<std::thread> threads;
+        threads.reserve(numberOfChunks);
+        for (std::size_t chunk = 0; chunk < numberOfChunks; chunk++)
+        {
+            std::size_t begin = std::min(chunk * chunkSize, population.size());
+            std::size_t end = std::min(begin + chunkSize, population.size());
+            threads.emplace_back(processChunk, std::cref(population), begin, end, std::ref(partials[chunk]), std::ref(genomeHashes));
+        }
+        for (std::thread &thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    PartialStatistics combined;
+    for (const PartialStatistics &partial : partials)
+    {
+        combined.validSolutions += partial.validSolutions;
+        combined.fitness.merge(partial.fitness);
+        combined.travelTime.merge(partial.travelTime);
+    }
+
+    statistics.validSolutions = combined.validSolutions;
+    statistics.percentageValid = (combined.validSolutions / static_cast<double>(population.size())) * 100;
+    // higher fitness is better, lower travel time is better
+    statistics.bestFitness = combined.fitness.maximum;
+    statistics.worstFitness = combined.fitness.minimum;
+    statistics.averageFitness = combined.fitness.mean;
+    statistics.fitnessStandardDeviation = combined.fitness.standardDeviation();
+    statistics.fittestIndex = combined.fitness.maximumIndex;
+    statistics.bestTravelTime = combined.travelTime.minimum;
+    statistics.worstTravelTime = combined.travelTime.maximum;
+    statistics.averageTravelTime = combined.travelTime.mean;
+    statistics.travelTimeStandardDeviation = combined.travelTime.standardDeviation();
+    statistics.fastestIndex = combined.travelTime.minimumIndex;
+
+    std::unordered_set<std::uint64_t> distinctGenomes(genomeHashes.begin(), genomeHashes.end());
+    statistics.uniqueGenomes = distinctGenomes.size();
+    statistics.uniqueGenomeRatio = statistics.uniqueGenomes / static_cast<double>(population.size());
+    statistics.averageDistanceToFittest = averageDistanceTo(population, statistics.fittestIndex);
+    return statistics;
+}
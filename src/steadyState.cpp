@@ -0,0 +1,287 @@
+#include "steadyState.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+#include <optional>
+#include <string>
+#include "diversity.h"
+#include "evaluation.h"
+#include "profiler.h"
+#include "RandomGenerator.h"
+
+namespace {
+    // Index of the rate the value falls into when the rates are laid out one after the other
+    auto rouletteIndex(const std::vector<double> &rates, double value) -> std::size_t
+    {
+        double cumulativeRate = 0.0;
+        for (std::size_t index = 0; index < rates.size(); index++)
+        {
+            cumulativeRate += rates[index];
+            if (value < cumulativeRate)
+            {
+                return index;
+            }
+        }
+        return rates.size() - 1;
+    }
+
+    auto secondsSince(std::chrono::steady_clock::time_point start) -> double
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    auto fittestIndex(const Population &population) -> std::size_t
+    {
+        return static_cast<std::size_t>(std::max_element(population.begin(), population.end(), [](const Individual &individualA, const Individual &individualB)
+                                                         { return individualA.fitness < individualB.fitness; }) -
+                                        population.begin());
+    }
+
+    auto leastFitIndex(const Population &population) -> std::size_t
+    {
+        return static_cast<std::size_t>(std::min_element(population.begin(), population.end(), [](const Individual &individualA, const Individual &individualB)
+                                                         { return individualA.fitness < individualB.fitness; }) -
+                                        population.begin());
+    }
+
+    // Returns true if an individual of the population has the genome of the child up to the order of the journeys, only
+    // individuals with the same fitness are hashed
+    auto isDuplicate(const Population &population, const Individual &child) -> bool
+    {
+        std::uint64_t childHash = 0;
+        bool childHashed = false;
+        for (const Individual &individual : population)
+        {
+            if (individual.fitness != child.fitness)
+            {
+                continue;
+            }
+            if (!childHashed)
+            {
+                childHash = canonicalGenomeHash(child.genome);
+                childHashed = true;
+            }
+            if (canonicalGenomeHash(individual.genome) == childHash)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+auto replaceIfFitter(Population &population, std::size_t index, const Individual &child) -> int
+{
+    if (child.fitness < population[index].fitness || isDuplicate(population, child))
+    {
+        return 0;
+    }
+    population[index] = child;
+    return 1;
+}
+
+auto tournamentIndex(const Population &population, int tournamentSize) -> std::size_t
+{
+    RandomGenerator &rng = RandomGenerator::getInstance();
+    std::size_t winner = rng.generateRandomInt(0, population.size() - 1);
+    for (int contestant = 1; contestant < tournamentSize; contestant++)
+    {
+        const std::size_t index = rng.generateRandomInt(0, population.size() - 1);
+        if (population[index].fitness > population[winner].fitness)
+        {
+            winner = index;
+        }
+    }
+    return winner;
+}
+
+auto selectParentPair(const Population &population, int tournamentSize) -> std::pair<std::size_t, std::size_t>
+{
+    const std::size_t parent1 = tournamentIndex(population, tournamentSize);
+    std::size_t parent2 = tournamentIndex(population, tournamentSize);
+    // a dominating individual can win most tournaments, so the retries are bounded
+    for (int attempt = 0; attempt < 10 && parent2 == parent1 && population.size() > 1; attempt++)
+    {
+        parent2 = tournamentIndex(population, tournamentSize);
+    }
+    return {parent1, parent2};
+}
+
+auto breedOffspring(const Population &population, std::size_t parent1, std::size_t parent2, Config &config, const ProblemInstance &problemInstance,
+                    AdaptiveOperatorSelection *crossoverSelection, AdaptiveOperatorSelection *mutationSelection) -> Offspring
+{
+    RandomGenerator &rng = RandomGenerator::getInstance();
+    Offspring offspring;
+    // crossover and mutations applied to every child, only tracked for the adaptive selection
+    std::vector<std::vector<std::size_t>> crossoversApplied;
+    std::vector<std::vector<std::size_t>> mutationsApplied;
+
+    std::vector<double> crossoverRates;
+    for (const auto &[function, rate] : config.crossover)
+    {
+        crossoverRates.push_back(rate);
+    }
+    const double totalCrossoverRate = std::accumulate(crossoverRates.begin(), crossoverRates.end(), 0.0);
+    bool crossed = false;
+    if (!crossoverRates.empty() && rng.generateRandomDouble(0.0, 1.0) < std::min(1.0, totalCrossoverRate))
+    {
+        const double value = rng.generateRandomDouble(0.0, 1.0);
+        const std::size_t operatorIndex = crossoverSelection != nullptr ? crossoverSelection->selectOperator(value) : rouletteIndex(crossoverRates, value * totalCrossoverRate);
+        std::pair<Genome, std::optional<Genome>> childrenGenomes;
+        const auto start = std::chrono::steady_clock::now();
+        {
+            ScopedTimer timer("crossover[" + std::to_string(operatorIndex) + "]");
+            childrenGenomes = config.crossover[operatorIndex].first(population[parent1].genome, population[parent2].genome);
+        }
+        offspring.children.push_back(Individual{std::move(childrenGenomes.first)});
+        offspring.parents.push_back(parent1);
+        if (childrenGenomes.second.has_value())
+        {
+            offspring.children.push_back(Individual{std::move(childrenGenomes.second.value())});
+            offspring.parents.push_back(parent2);
+        }
+        if (crossoverSelection != nullptr)
+        {
+            crossoverSelection->recordApplication(operatorIndex, secondsSince(start));
+            crossoversApplied.assign(offspring.children.size(), {operatorIndex});
+        }
+        crossed = true;
+    }
+    else
+    {
+        offspring.children = {Individual{population[parent1].genome}, Individual{population[parent2].genome}};
+        offspring.parents = {parent1, parent2};
+    }
+    crossoversApplied.resize(offspring.children.size());
+    mutationsApplied.resize(offspring.children.size());
+
+    std::vector<bool> changed(offspring.children.size(), crossed);
+    for (std::size_t child = 0; child < offspring.children.size(); child++)
+    {
+        for (std::size_t slot = 0; slot < config.mutation.size(); slot++)
+        {
+            // the rate is the expected number of applications, e.g. 1.5 applies once and a second time half of the time
+            const double rate = std::get<2>(config.mutation[slot]);
+            int applications = static_cast<int>(std::floor(rate));
+            if (rate > applications && rng.generateRandomDouble(0.0, 1.0) < rate - applications)
+            {
+                applications++;
+            }
+            for (int application = 0; application < applications; application++)
+            {
+                const std::size_t operatorIndex = mutationSelection != nullptr ? mutationSelection->selectOperator(rng.generateRandomDouble(0.0, 1.0)) : slot;
+                const auto start = std::chrono::steady_clock::now();
+                {
+                    ScopedTimer timer("mutation[" + std::to_string(operatorIndex) + "]");
+                    offspring.children[child].genome = std::get<0>(config.mutation[operatorIndex])(offspring.children[child].genome, std::get<1>(config.mutation[operatorIndex]));
+                }
+                changed[child] = true;
+                if (mutationSelection != nullptr)
+                {
+                    mutationSelection->recordApplication(operatorIndex, secondsSince(start));
+                    mutationsApplied[child].push_back(operatorIndex);
+                }
+            }
+        }
+    }
+
+    // copies of a parent are not worth an evaluation
+    Offspring changedOffspring;
+    for (std::size_t child = 0; child < offspring.children.size(); child++)
+    {
+        if (!changed[child])
+        {
+            continue;
+        }
+        Individual &individual = offspring.children[child];
+        evaluateIndividual(&individual, problemInstance);
+        const std::size_t operators = crossoversApplied[child].size() + mutationsApplied[child].size();
+        if (operators > 0)
+        {
+            const double share = std::max(0.0, individual.fitness - population[offspring.parents[child]].fitness) / static_cast<double>(operators);
+            for (std::size_t operatorIndex : crossoversApplied[child])
+            {
+                crossoverSelection->recordImprovement(operatorIndex, share);
+            }
+            for (std::size_t operatorIndex : mutationsApplied[child])
+            {
+                mutationSelection->recordImprovement(operatorIndex, share);
+            }
+        }
+        changedOffspring.children.push_back(std::move(individual));
+        changedOffspring.parents.push_back(offspring.parents[child]);
+    }
+    return changedOffspring;
+}
+
+auto crowdingParents(const Genome &parentA, const Genome &parentB, const Offspring &offspring) -> std::vector<std::size_t>
+{
+    std::vector<std::size_t> parents = offspring.parents;
+    const double keptPairs = brokenPairsDistance(parentA, offspring.children[0].genome) + brokenPairsDistance(parentB, offspring.children[1].genome);
+    const double swappedPairs = brokenPairsDistance(parentA, offspring.children[1].genome) + brokenPairsDistance(parentB, offspring.children[0].genome);
+    if (swappedPairs < keptPairs)
+    {
+        std::swap(parents[0], parents[1]);
+    }
+    return parents;
+}
+
+auto insertOffspring(Population &population, const Offspring &offspring, ReplacementStrategy strategy) -> int
+{
+    int inserted = 0;
+    if (strategy == ReplacementStrategy::Crowding)
+    {
+        std::vector<std::size_t> parents = offspring.parents;
+        if (offspring.children.size() == 2 && parents[0] != parents[1])
+        {
+            parents = crowdingParents(population[parents[0]].genome, population[parents[1]].genome, offspring);
+        }
+        for (std::size_t child = 0; child < offspring.children.size(); child++)
+        {
+            inserted += replaceIfFitter(population, parents[child], offspring.children[child]);
+        }
+        return inserted;
+    }
+    RandomGenerator &rng = RandomGenerator::getInstance();
+    for (const Individual &child : offspring.children)
+    {
+        if (strategy == ReplacementStrategy::Random && population.size() > 1)
+        {
+            // every index but the fittest one
+            const std::size_t fittest = fittestIndex(population);
+            std::size_t index = rng.generateRandomInt(0, population.size() - 2);
+            if (index >= fittest)
+            {
+                index++;
+            }
+            population[index] = child;
+            inserted++;
+        }
+        else
+        {
+            inserted += replaceIfFitter(population, leastFitIndex(population), child);
+        }
+    }
+    return inserted;
+}
+
+auto evolveSteadyState(Population &population, Config &config, const ProblemInstance &problemInstance,
+                       AdaptiveOperatorSelection *crossoverSelection, AdaptiveOperatorSelection *mutationSelection) -> void
+{
+    // every step breeds two children
+    for (int bred = 0; bred < config.populationSize; bred += 2)
+    {
+        const auto [parent1, parent2] = selectParentPair(population, config.steadyStateTournamentSize);
+        Offspring offspring = breedOffspring(population, parent1, parent2, config, problemInstance, crossoverSelection, mutationSelection);
+        ScopedTimer timer("replacement");
+        insertOffspring(population, offspring, config.steadyStateReplacement);
+    }
+    for (AdaptiveOperatorSelection *selection : {crossoverSelection, mutationSelection})
+    {
+        if (selection != nullptr)
+        {
+            selection->endGeneration();
+        }
+    }
+}
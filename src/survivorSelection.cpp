@@ -4,7 +4,9 @@
 #include <stdexcept>
 #include <cassert> 
 #include "utils.h"
+#include "diversity.h"
 #include <cmath>
+#include <numeric>
 
 auto fullReplacement(const Population &parents, const Population &children, const FunctionParameters &parameters, const  int populationSize) -> Population
 {   
@@ -56,3 +58,111 @@ auto elitismWithFill(const Population &parents, const Population &children, cons
     assert(survivors.size() == populationSize);
     return survivors;
 }
+
+auto biasedFitnessReplacement(const Population &parents, const Population &children, const FunctionParameters &parameters, const int populationSize) -> Population
+{
+    auto intParameter = [&parameters](const std::string &name, int fallback)
+    {
+        auto parameter = parameters.find(name);
+        return parameter == parameters.end() ? fallback : std::get<int>(parameter->second);
+    };
+    const int numberOfClosest = std::max(intParameter("number_of_closest", 5), 1);
+    const int numberOfElites = intParameter("number_of_elites", populationSize / 10);
+    const int comparisonWindow = intParameter("comparison_window", 50);
+    if (populationSize <= 0)
+    {
+        return {};
+    }
+
+    Population candidates = parents;
+    candidates.insert(candidates.end(), children.begin(), children.end());
+    // the fittest copy of every genome is kept
+    std::stable_sort(candidates.begin(), candidates.end(), [](const Individual &individualA, const Individual &individualB)
+                     { return individualA.fitness > individualB.fitness; });
+    Population duplicates = removeDuplicates(candidates);
+    if (static_cast<int>(candidates.size()) <= populationSize)
+    {
+        candidates.insert(candidates.end(), duplicates.begin(), duplicates.begin() + std::min<std::size_t>(duplicates.size(), populationSize - candidates.size()));
+        return candidates;
+    }
+
+    const std::size_t size = candidates.size();
+    int numberOfLocations = 0;
+    for (const Individual &individual : candidates)
+    {
+        for (const Journey &journey : individual.genome)
+        {
+            for (int patientId : journey)
+            {
+                numberOfLocations = std::max(numberOfLocations, patientId + 1);
+            }
+        }
+    }
+    std::vector<GenomeAdjacency> adjacencies;
+    adjacencies.reserve(size);
+    for (const Individual &individual : candidates)
+    {
+        adjacencies.push_back(buildAdjacency(individual.genome, numberOfLocations));
+    }
+    // every pair within the comparison window is rated once, each individual keeps a max heap of the distances to its
+    // closest individuals
+    const std::size_t closest = std::min<std::size_t>(numberOfClosest, size - 1);
+    std::vector<std::vector<double>> closestDistances(size);
+    auto offer = [&closestDistances, closest](std::size_t index, double distance)
+    {
+        std::vector<double> &heap = closestDistances[index];
+        if (heap.size() < closest)
+        {
+            heap.push_back(distance);
+            std::push_heap(heap.begin(), heap.end());
+        }
+        else if (distance < heap.front())
+        {
+            std::pop_heap(heap.begin(), heap.end());
+            heap.back() = distance;
+            std::push_heap(heap.begin(), heap.end());
+        }
+    };
+    const std::size_t window = comparisonWindow > 0 ? std::min<std::size_t>(comparisonWindow, size - 1) : size - 1;
+    for (std::size_t i = 0; i < size; i++)
+    {
+        for (std::size_t j = i + 1; j < std::min(i + window + 1, size); j++)
+        {
+            const double distance = brokenPairsDistance(adjacencies[i], adjacencies[j]);
+            offer(i, distance);
+            offer(j, distance);
+        }
+    }
+    std::vector<double> diversityContribution(size);
+    for (std::size_t i = 0; i < size; i++)
+    {
+        diversityContribution[i] = std::accumulate(closestDistances[i].begin(), closestDistances[i].end(), 0.0) / closestDistances[i].size();
+    }
+
+    // candidates are sorted by fitness, so the fitness rank is the index. A larger contribution is a better diversity rank.
+    std::vector<std::size_t> byDiversity(size);
+    std::iota(byDiversity.begin(), byDiversity.end(), 0);
+    std::stable_sort(byDiversity.begin(), byDiversity.end(), [&diversityContribution](std::size_t a, std::size_t b)
+                     { return diversityContribution[a] > diversityContribution[b]; });
+    const double diversityWeight = 1.0 - std::clamp(numberOfElites, 0, static_cast<int>(size)) / static_cast<double>(size);
+    std::vector<double> biasedFitness(size);
+    for (std::size_t rank = 0; rank < size; rank++)
+    {
+        biasedFitness[rank] += rank / static_cast<double>(size - 1);
+        biasedFitness[byDiversity[rank]] += diversityWeight * rank / static_cast<double>(size - 1);
+    }
+    // the fittest individual is at index 0 and survives in any case
+    std::vector<std::size_t> order(size - 1);
+    std::iota(order.begin(), order.end(), 1);
+    std::stable_sort(order.begin(), order.end(), [&biasedFitness](std::size_t a, std::size_t b)
+                     { return biasedFitness[a] < biasedFitness[b]; });
+
+    Population survivors;
+    survivors.reserve(populationSize);
+    survivors.push_back(candidates[0]);
+    for (std::size_t index = 0; static_cast<int>(survivors.size()) < populationSize; index++)
+    {
+        survivors.push_back(candidates[order[index]]);
+    }
+    return survivors;
+}
@@ -0,0 +1,527 @@
+#include "tuner.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include "logging.h"
+#include "RandomGenerator.h"
+#include "SGA.h"
+#include "utils.h"
+
+using json = nlohmann::json;
+
+namespace {
+    auto pointerOf(const std::string &path) -> json::json_pointer
+    {
+        try
+        {
+            return json::json_pointer(path);
+        }
+        catch (const json::exception &error)
+        {
+            throw std::invalid_argument("Invalid parameter path " + path + ": " + error.what());
+        }
+    }
+
+    auto readPositive(const json &settings, const std::string &key, int fallback) -> int
+    {
+        if (!settings.contains(key))
+        {
+            return fallback;
+        }
+        if (!settings.at(key).is_number_integer() || settings.at(key).get<int>() < 1)
+        {
+            throw std::invalid_argument(key + " must be a positive integer");
+        }
+        return settings.at(key).get<int>();
+    }
+
+    auto readTunedParameter(const json &parameter, const json &baseConfiguration) -> TunedParameter
+    {
+        if (!parameter.is_object() || !parameter.contains("path") || !parameter.contains("type") || !parameter.contains("min") || !parameter.contains("max"))
+        {
+            throw std::invalid_argument("A tuned parameter needs path, type, min and max");
+        }
+        TunedParameter tuned;
+        if (!parameter.at("path").is_string() || !parameter.at("type").is_string() || !parameter.at("min").is_number() || !parameter.at("max").is_number())
+        {
+            throw std::invalid_argument("A tuned parameter needs a string path and type and numbers as min and max");
+        }
+        tuned.path = parameter.at("path").get<std::string>();
+        if (!baseConfiguration.contains(pointerOf(tuned.path)))
+        {
+            throw std::invalid_argument("The base configuration has no value at " + tuned.path);
+        }
+        const std::string type = parameter.at("type").get<std::string>();
+        if (type != "int" && type != "double")
+        {
+            throw std::invalid_argument("The type of " + tuned.path + " must be int or double");
+        }
+        tuned.type = type == "int" ? ParameterType::Int : ParameterType::Double;
+        tuned.minimum = parameter.at("min").get<double>();
+        tuned.maximum = parameter.at("max").get<double>();
+        if (tuned.minimum > tuned.maximum || (tuned.type == ParameterType::Int && std::ceil(tuned.minimum) > std::floor(tuned.maximum)))
+        {
+            throw std::invalid_argument("The range of " + tuned.path + " is empty");
+        }
+        return tuned;
+    }
+
+    // Ranks of the given candidates in every block, one row per block
+    auto rankCandidates(const std::vector<std::vector<double>> &fitness, const std::vector<std::size_t> &candidates) -> std::vector<std::vector<double>>
+    {
+        std::vector<std::vector<double>> ranks;
+        ranks.reserve(fitness.size());
+        for (const std::vector<double> &blockFitness : fitness)
+        {
+            std::vector<double> candidateFitness;
+            candidateFitness.reserve(candidates.size());
+            for (std::size_t candidate : candidates)
+            {
+                candidateFitness.push_back(blockFitness[candidate]);
+            }
+            ranks.push_back(rankBlock(candidateFitness));
+        }
+        return ranks;
+    }
+
+    auto meanRanksOf(const std::vector<std::vector<double>> &ranks, std::size_t numberOfCandidates) -> std::vector<double>
+    {
+        std::vector<double> means(numberOfCandidates, 0.0);
+        for (const std::vector<double> &blockRanks : ranks)
+        {
+            for (std::size_t candidate = 0; candidate < numberOfCandidates; candidate++)
+            {
+                means[candidate] += blockRanks[candidate] / static_cast<double>(ranks.size());
+            }
+        }
+        return means;
+    }
+
+    auto aliveCandidatesOf(const std::vector<bool> &alive) -> std::vector<std::size_t>
+    {
+        std::vector<std::size_t> candidates;
+        for (std::size_t candidate = 0; candidate < alive.size(); candidate++)
+        {
+            if (alive[candidate])
+            {
+                candidates.push_back(candidate);
+            }
+        }
+        return candidates;
+    }
+
+    // Loaded instances by file and number of neighbours, every run gets a copy
+    struct InstanceCache
+    {
+        std::mutex mutex;
+        std::map<std::pair<std::string, int>, ProblemInstance> instances;
+
+        auto get(const std::string &instanceFile, int numberOfNeighbours) -> ProblemInstance
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto instance = instances.find({instanceFile, numberOfNeighbours});
+            if (instance == instances.end())
+            {
+                instance = instances.emplace(std::make_pair(instanceFile, numberOfNeighbours), loadInstance(instanceFile, numberOfNeighbours)).first;
+            }
+            return instance->second;
+        }
+    };
+
+    // the settings of a run that must not differ between candidates or touch state shared by parallel runs
+    auto isolatedRunConfiguration(const json &configuration, const std::string &instanceFile, unsigned int seed) -> json
+    {
+        json runConfiguration = configuration;
+        runConfiguration["instance"] = instanceFile;
+        runConfiguration["seed"] = seed;
+        runConfiguration["enableProfiling"] = false;
+        runConfiguration["enableFitnessCache"] = false;
+        runConfiguration["enableJourneyCache"] = false;
+        runConfiguration["checkpointInterval"] = 0;
+        runConfiguration["resumeFromCheckpoint"] = false;
+        return runConfiguration;
+    }
+} // namespace
+
+auto readTuningSettings(const json &settings) -> TuningSettings
+{
+    if (!settings.is_object())
+    {
+        throw std::invalid_argument("The tuning settings must be an object");
+    }
+    const std::set<std::string> allowedKeys = {"baseConfiguration", "instances", "seeds", "parameters", "numberOfCandidates", "firstTest", "budget", "numberOfThreads", "samplingSeed", "output"};
+    for (const auto &[key, value] : settings.items())
+    {
+        if (allowedKeys.count(key) == 0)
+        {
+            throw std::invalid_argument("Unknown key " + key + " in the tuning settings");
+        }
+    }
+    for (const char *key : {"baseConfiguration", "instances", "seeds", "parameters"})
+    {
+        if (!settings.contains(key))
+        {
+            throw std::invalid_argument("The tuning settings need " + std::string(key));
+        }
+    }
+    TuningSettings tuning;
+    const json &base = settings.at("baseConfiguration");
+    tuning.baseConfiguration = base.is_string() ? readConfigurationFile(base.get<std::string>()) : base;
+    if (!tuning.baseConfiguration.is_object())
+    {
+        throw std::invalid_argument("baseConfiguration must be a configuration or the path of one");
+    }
+    for (const json &instance : settings.at("instances"))
+    {
+        if (!instance.is_string())
+        {
+            throw std::invalid_argument("instances must be a list of instance files");
+        }
+        tuning.instances.push_back(instance.get<std::string>());
+    }
+    for (const json &seed : settings.at("seeds"))
+    {
+        if (!seed.is_number_unsigned())
+        {
+            throw std::invalid_argument("seeds must be a list of non-negative integers");
+        }
+        tuning.seeds.push_back(seed.get<unsigned int>());
+    }
+    if (tuning.instances.empty() || tuning.seeds.empty())
+    {
+        throw std::invalid_argument("The tuning settings need at least one instance and one seed");
+    }
+    for (const json &parameter : settings.at("parameters"))
+    {
+        tuning.parameters.push_back(readTunedParameter(parameter, tuning.baseConfiguration));
+    }
+    tuning.numberOfCandidates = readPositive(settings, "numberOfCandidates", tuning.numberOfCandidates);
+    tuning.firstTest = readPositive(settings, "firstTest", tuning.firstTest);
+    tuning.budget = readPositive(settings, "budget", tuning.budget);
+    tuning.numberOfThreads = readPositive(settings, "numberOfThreads", tuning.numberOfThreads);
+    if (settings.contains("samplingSeed"))
+    {
+        if (!settings.at("samplingSeed").is_number_unsigned())
+        {
+            throw std::invalid_argument("samplingSeed must be a non-negative integer");
+        }
+        tuning.samplingSeed = settings.at("samplingSeed").get<unsigned int>();
+    }
+    if (settings.contains("output"))
+    {
+        if (!settings.at("output").is_string())
+        {
+            throw std::invalid_argument("output must be a path");
+        }
+        tuning.outputPath = settings.at("output").get<std::string>();
+    }
+    return tuning;
+}
+
+auto sampleCandidates(const TuningSettings &settings, std::mt19937_64 &engine) -> std::vector<json>
+{
+    std::vector<json> candidates = {settings.baseConfiguration};
+    for (int candidate = 1; candidate < settings.numberOfCandidates; candidate++)
+    {
+        json configuration = settings.baseConfiguration;
+        for (const TunedParameter &parameter : settings.parameters)
+        {
+            if (parameter.type == ParameterType::Int)
+            {
+                std::uniform_int_distribution<long long> distribution(static_cast<long long>(std::ceil(parameter.minimum)), static_cast<long long>(std::floor(parameter.maximum)));
+                configuration[json::json_pointer(parameter.path)] = distribution(engine);
+            }
+            else
+            {
+                std::uniform_real_distribution<double> distribution(parameter.minimum, parameter.maximum);
+                configuration[json::json_pointer(parameter.path)] = distribution(engine);
+            }
+        }
+        candidates.push_back(std::move(configuration));
+    }
+    return candidates;
+}
+
+auto rankBlock(const std::vector<double> &fitness) -> std::vector<double>
+{
+    std::vector<std::size_t> order(fitness.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&fitness](std::size_t candidateA, std::size_t candidateB)
+              { return fitness[candidateA] > fitness[candidateB]; });
+    std::vector<double> ranks(fitness.size());
+    std::size_t begin = 0;
+    while (begin < order.size())
+    {
+        std::size_t end = begin + 1;
+        while (end < order.size() && fitness[order[end]] == fitness[order[begin]])
+        {
+            end++;
+        }
+        // ranks begin + 1 to end are shared
+        const double sharedRank = (static_cast<double>(begin + 1) + static_cast<double>(end)) / 2.0;
+        for (std::size_t position = begin; position < end; position++)
+        {
+            ranks[order[position]] = sharedRank;
+        }
+        begin = end;
+    }
+    return ranks;
+}
+
+auto friedmanSurvivors(const std::vector<std::vector<double>> &ranks, double significance) -> std::vector<bool>
+{
+    const std::size_t numberOfCandidates = ranks.empty() ? 0 : ranks[0].size();
+    std::vector<bool> survivors(numberOfCandidates, true);
+    const double blocks = static_cast<double>(ranks.size());
+    const double candidates = static_cast<double>(numberOfCandidates);
+    if (ranks.size() < 2 || numberOfCandidates < 2)
+    {
+        return survivors;
+    }
+    std::vector<double> rankSums(numberOfCandidates, 0.0);
+    double sumOfSquaredRanks = 0.0;
+    for (const std::vector<double> &blockRanks : ranks)
+    {
+        for (std::size_t candidate = 0; candidate < numberOfCandidates; candidate++)
+        {
+            rankSums[candidate] += blockRanks[candidate];
+            sumOfSquaredRanks += blockRanks[candidate] * blockRanks[candidate];
+        }
+    }
+    const double correction = blocks * candidates * (candidates + 1) * (candidates + 1) / 4.0;
+    // every block is one big tie
+    if (sumOfSquaredRanks - correction < 1e-9)
+    {
+        return survivors;
+    }
+    double deviation = 0.0;
+    double sumOfSquaredRankSums = 0.0;
+    for (double rankSum : rankSums)
+    {
+        deviation += (rankSum - blocks * (candidates + 1) / 2.0) * (rankSum - blocks * (candidates + 1) / 2.0);
+        sumOfSquaredRankSums += rankSum * rankSum;
+    }
+    const double statistic = (candidates - 1) * deviation / (sumOfSquaredRanks - correction);
+    if (statistic <= chiSquareQuantile(1.0 - significance, static_cast<int>(numberOfCandidates) - 1))
+    {
+        return survivors;
+    }
+    // Conover: two candidates differ if their rank sums differ by more than the critical difference
+    const int degreesOfFreedom = static_cast<int>((ranks.size() - 1) * (numberOfCandidates - 1));
+    const double criticalDifference = studentTQuantile(1.0 - significance / 2.0, degreesOfFreedom) *
+                                      std::sqrt(2.0 * blocks * (sumOfSquaredRanks - sumOfSquaredRankSums / blocks) / degreesOfFreedom);
+    const double bestRankSum = *std::min_element(rankSums.begin(), rankSums.end());
+    for (std::size_t candidate = 0; candidate < numberOfCandidates; candidate++)
+    {
+        survivors[candidate] = rankSums[candidate] - bestRankSum <= criticalDifference;
+    }
+    return survivors;
+}
+
+auto normalQuantile(double probability) -> double
+{
+    if (!(probability > 0.0 && probability < 1.0))
+    {
+        throw std::invalid_argument("The probability of a quantile must be in (0, 1)");
+    }
+    // bisection on the distribution function, the quantiles of doubles in (0, 1) lie in [-40, 40]
+    double lower = -40.0;
+    double upper = 40.0;
+    for (int iteration = 0; iteration < 100; iteration++)
+    {
+        const double middle = (lower + upper) / 2.0;
+        if (0.5 * std::erfc(-middle / std::sqrt(2.0)) < probability)
+        {
+            lower = middle;
+        }
+        else
+        {
+            upper = middle;
+        }
+    }
+    return (lower + upper) / 2.0;
+}
+
+auto chiSquareQuantile(double probability, int degreesOfFreedom) -> double
+{
+    const double z = normalQuantile(probability);
+    const double h = 2.0 / (9.0 * degreesOfFreedom);
+    return std::max(0.0, degreesOfFreedom * std::pow(1.0 - h + z * std::sqrt(h), 3));
+}
+
+auto studentTQuantile(double probability, int degreesOfFreedom) -> double
+{
+    const double z = normalQuantile(probability);
+    const double v = degreesOfFreedom;
+    const double z3 = z * z * z;
+    const double z5 = z3 * z * z;
+    const double z7 = z5 * z * z;
+    return z + (z3 + z) / (4.0 * v) + (5.0 * z5 + 16.0 * z3 + 3.0 * z) / (96.0 * v * v) +
+           (3.0 * z7 + 19.0 * z5 + 17.0 * z3 - 15.0 * z) / (384.0 * v * v * v);
+}
+
+auto race(const TuningSettings &settings, const std::vector<json> &candidates, const RunEvaluator &evaluate) -> RaceResult
+{
+    spdlog::logger &logger = mainLogger();
+    RaceResult result;
+    result.candidates = candidates;
+    result.alive.assign(candidates.size(), true);
+    result.meanRanks.assign(candidates.size(), 1.0);
+    // fitness[block][candidate], NaN for candidates that were already eliminated
+    std::vector<std::vector<double>> fitness;
+    const std::size_t numberOfBlocks = settings.instances.size() * settings.seeds.size();
+    for (std::size_t block = 0; block < numberOfBlocks; block++)
+    {
+        const std::vector<std::size_t> aliveCandidates = aliveCandidatesOf(result.alive);
+        if (aliveCandidates.size() <= 1 || result.runs + static_cast<int>(aliveCandidates.size()) > settings.budget)
+        {
+            break;
+        }
+        // the blocks go through all instances before the next seed is used
+        const std::string &instanceFile = settings.instances[block % settings.instances.size()];
+        const unsigned int seed = settings.seeds[block / settings.instances.size()];
+
+        std::vector<double> blockFitness(candidates.size(), std::numeric_limits<double>::quiet_NaN());
+        std::atomic<std::size_t> nextRun{0};
+        std::mutex errorMutex;
+        std::exception_ptr error;
+        auto runCandidates = [&]()
+        {
+            for (std::size_t run = nextRun++; run < aliveCandidates.size(); run = nextRun++)
+            {
+                try
+                {
+                    blockFitness[aliveCandidates[run]] = evaluate(candidates[aliveCandidates[run]], instanceFile, seed);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    if (!error)
+                    {
+                        error = std::current_exception();
+                    }
+                }
+            }
+        };
+        const std::size_t numberOfThreads = std::min<std::size_t>(settings.numberOfThreads, aliveCandidates.size());
+        std::vector<std::thread> threads;
+        threads.reserve(numberOfThreads);
+        for (std::size_t thread = 0; thread < numberOfThreads; thread++)
+        {
+            threads.emplace_back(runCandidates);
+        }
+        for (std::thread &thread : threads)
+        {
+            thread.join();
+        }
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+        fitness.push_back(std::move(blockFitness));
+        result.runs += static_cast<int>(aliveCandidates.size());
+        result.blocks++;
+
+        std::vector<std::vector<double>> ranks = rankCandidates(fitness, aliveCandidates);
+        std::vector<double> meanRanks = meanRanksOf(ranks, aliveCandidates.size());
+        std::vector<bool> survivors = result.blocks >= settings.firstTest ? friedmanSurvivors(ranks) : std::vector<bool>(aliveCandidates.size(), true);
+        for (std::size_t index = 0; index < aliveCandidates.size(); index++)
+        {
+            result.meanRanks[aliveCandidates[index]] = meanRanks[index];
+            result.alive[aliveCandidates[index]] = survivors[index];
+        }
+        const std::size_t eliminated = static_cast<std::size_t>(std::count(survivors.begin(), survivors.end(), false));
+        logger.info("Tuning block {} ({} seed {}): {} candidates run, {} eliminated", result.blocks, instanceFile, seed, aliveCandidates.size(), eliminated);
+        std::cout << "Tuning block " << result.blocks << " (" << instanceFile << " seed " << seed << "): candidates left: " << aliveCandidates.size() - eliminated << '\n';
+    }
+
+    // the candidate with the best mean rank among the survivors wins, ties go to the earlier candidate
+    const std::vector<std::size_t> aliveCandidates = aliveCandidatesOf(result.alive);
+    if (!fitness.empty())
+    {
+        std::vector<double> meanRanks = meanRanksOf(rankCandidates(fitness, aliveCandidates), aliveCandidates.size());
+        for (std::size_t index = 0; index < aliveCandidates.size(); index++)
+        {
+            result.meanRanks[aliveCandidates[index]] = meanRanks[index];
+        }
+    }
+    result.bestCandidate = *std::min_element(aliveCandidates.begin(), aliveCandidates.end(), [&result](std::size_t candidateA, std::size_t candidateB)
+                                             { return result.meanRanks[candidateA] < result.meanRanks[candidateB]; });
+    return result;
+}
+
+auto makeSGAEvaluator() -> RunEvaluator
+{
+    auto instanceCache = std::make_shared<InstanceCache>();
+    return [instanceCache](const json &configuration, const std::string &instanceFile, unsigned int seed) -> double
+    {
+        RunConfiguration run = loadRunConfiguration(isolatedRunConfiguration(configuration, instanceFile, seed), [&instanceCache](const std::string &file, int numberOfNeighbours)
+                                                    { return instanceCache->get(file, numberOfNeighbours); });
+        run.config->printProgress = false;
+        double fitness = 0.0;
+        std::exception_ptr error;
+        // the random generator is thread local, a new thread starts with an unseeded one
+        std::thread runThread([&]()
+                              {
+            try
+            {
+                RandomGenerator::getInstance().setSeed(seed);
+                fitness = SGA(*run.problemInstance, *run.config).fitness;
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            } });
+        runThread.join();
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+        return fitness;
+    };
+}
+
+auto tune(const TuningSettings &settings) -> RaceResult
+{
+    spdlog::logger &logger = mainLogger();
+    std::mt19937_64 engine(settings.samplingSeed);
+    const std::vector<json> candidates = sampleCandidates(settings, engine);
+    RunEvaluator evaluate = makeSGAEvaluator();
+    // the loader checks the range of every value, so a sampled value out of the range of its operator stops the tuning
+    // here instead of in the middle of the race
+    InstanceCache validationInstances;
+    for (std::size_t candidate = 0; candidate < candidates.size(); candidate++)
+    {
+        try
+        {
+            loadRunConfiguration(isolatedRunConfiguration(candidates[candidate], settings.instances.front(), settings.seeds.front()), [&validationInstances](const std::string &file, int numberOfNeighbours)
+                                 { return validationInstances.get(file, numberOfNeighbours); });
+        }
+        catch (const std::invalid_argument &error)
+        {
+            throw std::invalid_argument("Candidate " + std::to_string(candidate) + " is invalid: " + error.what());
+        }
+    }
+    logger.info("Racing {} candidates on {} instances and {} seeds", candidates.size(), settings.instances.size(), settings.seeds.size());
+
+    RaceResult result = race(settings, candidates, evaluate);
+    std::ofstream outputFileStream(settings.outputPath);
+    if (!outputFileStream.is_open())
+    {
+        throw std::runtime_error("Could not write the tuned configuration to " + settings.outputPath);
+    }
+    outputFileStream << result.candidates[result.bestCandidate].dump(4) << '\n';
+    logger.info("Candidate {} won after {} runs on {} blocks with mean rank {}, written to {}", result.bestCandidate, result.runs, result.blocks, result.meanRanks[result.bestCandidate], settings.outputPath);
+    return result;
+}
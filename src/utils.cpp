@@ -1,33 +1,123 @@
+#include "utils.h"
 #include "structures.h"
 #include <algorithm>
+#include <cstdint>
 #include <iostream>
 #include "nlohmann/json.hpp"
 #include <fstream> 
 #include <spdlog/spdlog.h>
-#include <spdlog/sinks/basic_file_sink.h> 
+#include "logging.h"
 
 
 
 using json = nlohmann::json;
 
 
-auto getTotalTravelTime(const Genome &genome, const ProblemInstance &problemInstance) -> double
+auto loadInstance(const std::string &filename, int numberOfNeighbours) -> ProblemInstance
 {
-    double totalTravelTime = 0;
-    for (Journey nurseJourney : genome)
+    spdlog::logger &logger = mainLogger();
+    std::ifstream inputFileStream("./../train/" + filename);
+    json data = json::parse(inputFileStream);
+    const std::string instanceName = data["instance_name"];
+    logger.info("Loading instance: {}", instanceName);
+    // load the depot
+    Depot depot = {
+        data["depot"]["x_coord"],
+        data["depot"]["y_coord"],
+        data["depot"]["return_time"]};
+    // load the patients
+    const int numberOfPatients = data["patients"].size();
+    logger.info("Number of patients: {}", numberOfPatients);
+    std::unordered_map<int, Patient> patients;
+    patients.reserve(numberOfPatients);
+    for (const auto &entry : data["patients"].items())
+    {
+        const auto &patientData = entry.value();
+        patients.insert({std::stoi(entry.key()), {std::stoi(entry.key()), patientData["demand"], patientData["start_time"], patientData["end_time"], patientData["care_time"], patientData["x_coord"], patientData["y_coord"]}});
+    }
+    // load the travel time matrix
+    const int numberOfNurses = data["nbr_nurses"];
+    const int nurseCapacity = data["capacity_nurse"];
+    const float benchmark = data["benchmark"];
+    logger.info("Number of nurses: {}", numberOfNurses);
+    logger.info("Nurse capacity: {}", nurseCapacity);
+    logger.info("Benchmark: {}", benchmark);
+    std::vector<std::vector<double>> travelTimeMatrix;
+    travelTimeMatrix.reserve(numberOfPatients + 1);
+    for (const auto &row : data["travel_times"])
+    {
+        std::vector<double> helper;
+        helper.reserve(numberOfPatients + 1);
+        for (const auto &travelTime : row)
+        {
+            helper.push_back(travelTime);
+        }
+        travelTimeMatrix.push_back(helper);
+    }
+
+    ProblemInstance problemInstance = {
+        instanceName,
+        numberOfNurses,
+        nurseCapacity,
+        benchmark,
+        depot,
+        patients,
+        travelTimeMatrix};
+    buildNeighbourLists(problemInstance, numberOfNeighbours);
+    logger.info("Instance loaded");
+    return problemInstance;
+}
+
+auto buildNeighbourLists(ProblemInstance &problemInstance, int numberOfNeighbours, bool timeWindowCompatibleOnly) -> void
+{
+    const auto &travelTime = problemInstance.travelTime;
+    const int numberOfLocations = static_cast<int>(travelTime.size());
+    problemInstance.neighbours.assign(numberOfLocations, {});
+    std::vector<int> candidates;
+    for (int from = 0; from < numberOfLocations; from++)
     {
-        for (int i = 0; i < nurseJourney.size(); i++)
+        // the depot can be left at time 0, a patient at the earliest end of its care
+        double earliestDeparture = 0;
+        if (from != 0)
         {
-            int patientId = nurseJourney[i];
-            int previousPatientId = nurseJourney[i - 1];
-            if (i == 0)
+            if (!problemInstance.isPatient(from))
             {
-                totalTravelTime += problemInstance.travelTime[0][patientId];
+                continue;
             }
-            else
+            const Patient &patient = problemInstance.patientTable[from];
+            earliestDeparture = patient.startTime + patient.careTime;
+        }
+        candidates.clear();
+        for (int to = 1; to < numberOfLocations; to++)
+        {
+            if (to == from || !problemInstance.isPatient(to))
+            {
+                continue;
+            }
+            const Patient &patient = problemInstance.patientTable[to];
+            if (timeWindowCompatibleOnly && std::max(earliestDeparture + travelTime[from][to], static_cast<double>(patient.startTime)) + patient.careTime > patient.endTime)
             {
-                totalTravelTime += problemInstance.travelTime[previousPatientId][patientId];
+                continue;
             }
+            candidates.push_back(to);
+        }
+        const std::size_t listLength = std::min<std::size_t>(candidates.size(), std::max(numberOfNeighbours, 0));
+        std::partial_sort(candidates.begin(), candidates.begin() + listLength, candidates.end(), [&travelTime, from](int a, int b)
+                          { return travelTime[from][a] < travelTime[from][b] || (travelTime[from][a] == travelTime[from][b] && a < b); });
+        problemInstance.neighbours[from].assign(candidates.begin(), candidates.begin() + listLength);
+    }
+}
+
+auto getTotalTravelTime(const Genome &genome, const ProblemInstance &problemInstance) -> double
+{
+    double totalTravelTime = 0;
+    for (const Journey &nurseJourney : genome)
+    {
+        int previousPatientId = 0;
+        for (int patientId : nurseJourney)
+        {
+            totalTravelTime += problemInstance.travelTime[previousPatientId][patientId];
+            previousPatientId = patientId;
         }
         // add the driving time from the last patient to the depot if there is at least one patient
         if (!nurseJourney.empty())
@@ -67,7 +157,12 @@ auto sortPopulationByTravelTime(Population& population, bool ascending, const Pr
 }
 
 auto logGenome(const Genome& genome, const std::string& IndividualName, const int generation) -> void {
-    auto logger = spdlog::get("statistics_logger");
+    spdlog::logger &logger = statisticsLogger();
+    // building the string is far more expensive than logging it, so skip it if debug is disabled
+    if (!logger.should_log(spdlog::level::debug))
+    {
+        return;
+    }
     std::string genomeString = "Genome: Name: " + IndividualName + " Generation: " + std::to_string(generation) + " Genome: [";
     for (int i = 0; i < genome.size(); i++) {
         genomeString += "[";
@@ -78,7 +173,7 @@ auto logGenome(const Genome& genome, const std::string& IndividualName, const in
         genomeString += "], ";
     }
     genomeString += "]";
-    logger->debug(genomeString);
+    logger.debug(genomeString);
 
 }
 
@@ -128,131 +223,117 @@ auto exportIndividual(const Individual& individual, const std::string& path) ->
 
 auto isJourneyValid(const Journey &nurseJourney, const ProblemInstance &problemInstance) -> bool
 {
-    auto logger = spdlog::get("main_logger");
     if (nurseJourney.empty())
     {
         return true;
     }
+    spdlog::logger &logger = mainLogger();
+    const auto &travelTime = problemInstance.travelTime;
     double totalTimeSpent = 0.0;
     int totalDemand = 0;
-    for (int j = 0; j < nurseJourney.size(); j++)
+    int previousPatientId = 0;
+    for (int patientId : nurseJourney)
     {
-        int patientId = nurseJourney[j];
-        int previousPatientId = nurseJourney[j - 1];
-        if (j == 0)
-        {
-            totalTimeSpent += problemInstance.travelTime[0][patientId];
-        }
-        else
+        const Patient &patient = problemInstance.patientTable[patientId];
+        totalTimeSpent += travelTime[previousPatientId][patientId];
+        if (totalTimeSpent < patient.startTime)
         {
-            totalTimeSpent += problemInstance.travelTime[previousPatientId][patientId];
+            totalTimeSpent = patient.startTime;
         }
-        if (totalTimeSpent < problemInstance.patients.at(patientId).startTime)
+        totalTimeSpent += patient.careTime;
+        if (totalTimeSpent > patient.endTime)
         {
-            totalTimeSpent = problemInstance.patients.at(patientId).startTime;
-        }
-        totalTimeSpent += problemInstance.patients.at(patientId).careTime;
-        if (totalTimeSpent > problemInstance.patients.at(patientId).endTime)
-        {
-            logger->trace("Patient {} treatment finishes too late", patientId);
+            LOG_TRACE(logger, "Patient {} treatment finishes too late", patientId);
             return false;
         }
-        totalDemand += problemInstance.patients.at(patientId).demand;
+        totalDemand += patient.demand;
         if (totalDemand > problemInstance.nurseCapacity)
         {
-            logger->trace("Nurse exceeds the capacity");
+            LOG_TRACE(logger, "Nurse exceeds the capacity");
             return false;
         }
+        previousPatientId = patientId;
     }
-    // add the driving time from the last patient to the depot if there is at least one patient
-    if (nurseJourney.empty())
-    {
-        totalTimeSpent += problemInstance.travelTime[nurseJourney[nurseJourney.size() - 1]][0];
-    }
+    // add the driving time from the last patient to the depot
+    totalTimeSpent += travelTime[previousPatientId][0];
     if (totalTimeSpent > problemInstance.depot.returnTime)
     {
-        logger->trace("Nurse exceeds the return time");
+        LOG_TRACE(logger, "Nurse exceeds the return time");
         return false;
     }
     return true;
 }
 
-auto isSolutionValid(const Genome &genome, const ProblemInstance &problemInstance) -> bool
+auto countPatientVisits(const Genome &genome, const ProblemInstance &problemInstance, SolutionValidation &validation) -> void
 {
-    auto logger = spdlog::get("main_logger");
+    // one bit per patient id, reused by all calls of this thread so validating does not allocate
+    thread_local std::vector<std::uint64_t> visitedPatients;
+    const std::size_t numberOfWords = (problemInstance.patientTable.size() + 63) / 64;
+    if (visitedPatients.size() < numberOfWords)
+    {
+        visitedPatients.resize(numberOfWords);
+    }
+    std::fill(visitedPatients.begin(), visitedPatients.begin() + numberOfWords, 0);
+
     // validate that every patient is visited exactly once
-    std::map<int, bool> visitedPatients;
+    int visitedCount = 0;
     for (const Journey &nurseJourney : genome)
     {
         for (int patientId : nurseJourney)
         {
-            if (visitedPatients[patientId])
+            if (!problemInstance.isPatient(patientId))
             {
-                logger->warn("Patient {} is visited more than once", patientId);
-                return false;
+                validation.unknownPatients++;
+                continue;
+            }
+            std::uint64_t &word = visitedPatients[patientId / 64];
+            const std::uint64_t bit = std::uint64_t{1} << (patientId % 64);
+            if (word & bit)
+            {
+                validation.duplicateVisits++;
+            }
+            else
+            {
+                word |= bit;
+                visitedCount++;
             }
-            visitedPatients[patientId] = true;
-        }
-    }
-    // validate that every patient is visited
-    for (const auto &[id, patient] : problemInstance.patients)
-    {
-        if (!visitedPatients[id])
-        {
-            logger->warn("Patient {} is not visited", id);
-            return false;
         }
     }
+    // every visited patient is distinct and known, so the missing ones are the difference
+    validation.missingPatients = static_cast<int>(problemInstance.patients.size()) - visitedCount;
+}
+
+auto validateSolution(const Genome &genome, const ProblemInstance &problemInstance) -> SolutionValidation
+{
+    SolutionValidation validation;
+    countPatientVisits(genome, problemInstance, validation);
 
-    for (int nurseId = 0; nurseId < genome.size(); nurseId++)
+    // the time window check reads the patient table, so it is only safe if all ids are known
+    if (validation.unknownPatients == 0)
     {
-        const Journey &nurseJourney = genome[nurseId];
-        if (!isJourneyValid(nurseJourney, problemInstance))
+        for (int nurseId = 0; nurseId < static_cast<int>(genome.size()); nurseId++)
         {
-            logger->trace("Journey of nurse {} is invalid", nurseId);
-            return false;
+            if (!isJourneyValid(genome[nurseId], problemInstance))
+            {
+                validation.invalidJourneys++;
+                if (validation.firstInvalidJourney == -1)
+                {
+                    validation.firstInvalidJourney = nurseId;
+                }
+            }
         }
     }
-    return true;
+    validation.valid = validation.duplicateVisits == 0 && validation.missingPatients == 0 && validation.unknownPatients == 0 && validation.invalidJourneys == 0;
+    return validation;
 }
 
-auto initLogger() -> void
+auto isSolutionValid(const Genome &genome, const ProblemInstance &problemInstance) -> bool
 {
-        std::string main_log_file_path = "logfile.txt";
-    std::string statistics_log_file_path = "statistics.txt";
-
-    // Check if log files exist, and if so, remove them
-    if (std::filesystem::exists(main_log_file_path)) {
-        std::filesystem::remove(main_log_file_path);
-    }
-
-    if (std::filesystem::exists(statistics_log_file_path)) {
-        std::filesystem::remove(statistics_log_file_path);
+    SolutionValidation validation = validateSolution(genome, problemInstance);
+    if (!validation.valid)
+    {
+        LOG_TRACE(mainLogger(), "Invalid solution: {} duplicate visits, {} missing patients, {} unknown patients, {} invalid journeys (first: nurse {})",
+                  validation.duplicateVisits, validation.missingPatients, validation.unknownPatients, validation.invalidJourneys, validation.firstInvalidJourney);
     }
-
-    // Create a basic file sink
-    auto main_file_sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(main_log_file_path);
-    auto statistics_file_sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(statistics_log_file_path);
-
-
-    // Create a logger with the basic file sink
-    auto logger = std::make_shared<spdlog::logger>("main_logger", main_file_sink);
-    auto statistics_logger = std::make_shared<spdlog::logger>("statistics_logger", statistics_file_sink);
-
-    // Set the logging pattern with the thread id
-    logger->set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%t] [%l] %v");
-    statistics_logger->set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%t] [%l] %v");
-
-
-    #if defined(PRODUCTION)
-        logger->set_level(spdlog::level::debug);
-        statistics_logger->set_level(spdlog::level::debug);
-    #else
-        logger->set_level(spdlog::level::trace);
-        statistics_logger->set_level(spdlog::level::trace);
-    #endif
-
-    // Register the logger
-    spdlog::register_logger(logger);
-    spdlog::register_logger(statistics_logger);
-}
\ No newline at end of file
+    return validation.valid;
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include <cmath>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "structures.h"
+
+// Instance with the patients on random points of a 40 x 40 grid, the depot in its middle at (20, 20) and euclidean
+// travel times. Every patient has a demand of 1 and a care time of 5. Its time window is windowLength long and starts
+// at 0, or at a random time up to latestStart if that is positive.
+inline auto makeGridInstance(const std::string &instanceName, unsigned seed, int numberOfPatients, int numberOfNurses, int nurseCapacity,
+                             int windowLength, int latestStart = 0) -> ProblemInstance
+{
+    std::mt19937 engine(seed);
+    std::uniform_int_distribution<int> coordinate(0, 40);
+    std::uniform_int_distribution<int> start(0, latestStart);
+    std::vector<std::pair<int, int>> points = {{20, 20}};
+    std::unordered_map<int, Patient> patients;
+    for (int id = 1; id <= numberOfPatients; id++)
+    {
+        points.push_back({coordinate(engine), coordinate(engine)});
+        const int startTime = latestStart > 0 ? start(engine) : 0;
+        patients[id] = {id, 1, startTime, startTime + windowLength, 5, points.back().first, points.back().second};
+    }
+    std::vector<std::vector<double>> travelTime(points.size(), std::vector<double>(points.size()));
+    for (std::size_t from = 0; from < points.size(); from++)
+    {
+        for (std::size_t to = 0; to < points.size(); to++)
+        {
+            travelTime[from][to] = std::hypot(points[from].first - points[to].first, points[from].second - points[to].second);
+        }
+    }
+    return {instanceName, numberOfNurses, nurseCapacity, 0.0, {20, 20, 1000}, patients, travelTime};
+}
@@ -5,5 +5,7 @@ auto main(int argc, char **argv) -> int
 {
   initLogger();
   ::testing::InitGoogleTest(&argc, argv);
-  return RUN_ALL_TESTS();
+  int result = RUN_ALL_TESTS();
+  shutdownLogger();
+  return result;
 }
\ No newline at end of file
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <thread>
+#include "asynchronousEvolution.h"
+#include "crossover.h"
+#include "GridInstance.h"
+#include "mutation.h"
+#include "parentSelection.h"
+#include "RandomGenerator.h"
+#include "SGA.h"
+#include "spscQueue.h"
+#include "structures.h"
+#include "survivorSelection.h"
+
+namespace {
+class AsynchronousEvolutionTestFixture : public ::testing::Test {
+protected:
+    FunctionParameters emptyParams;
+    FunctionParameters tournamentParams = {{"tournamentSize", 3}, {"tournamentProbability", 0.8}};
+    FunctionParameters elitismParams = {{"elitism_percentage", 0.2}, {"fillFunction", "rouletteWheel"}};
+
+    void SetUp() override {
+        RandomGenerator::resetInstance();
+        RandomGenerator::getInstance().setSeed(13);
+    }
+
+    void TearDown() override {
+        RandomGenerator::resetInstance();
+    }
+
+    // 20 patients on a grid with wide time windows
+    static auto createGridInstance() -> ProblemInstance {
+        return makeGridInstance("grid", 5, 20, 4, 10, 600);
+    }
+
+    auto createConfig(int generations) -> Config {
+        Config config(20, generations, false, {tournamentSelection, tournamentParams}, {{order1Crossover, 0.5}},
+                      {{reassignOnePatient, emptyParams, 0.2}, {swapBetweenJourneys, emptyParams, 0.2}}, {elitismWithFill, elitismParams});
+        config.numberOfThreads = 3;
+        config.printProgress = false;
+        return config;
+    }
+
+    static auto bestFitness(const Population &population) -> double {
+        return std::max_element(population.begin(), population.end(), [](const Individual &a, const Individual &b) { return a.fitness < b.fitness; })->fitness;
+    }
+};
+
+TEST_F(AsynchronousEvolutionTestFixture, SpscQueue_keepsOrderBetweenThreads) {
+    SpscQueue<int> queue(3);
+    EXPECT_EQ(queue.capacity(), 4);
+    for (int value = 0; value < 4; value++) {
+        EXPECT_TRUE(queue.push(int(value)));
+    }
+    EXPECT_FALSE(queue.push(4));
+    int value = -1;
+    for (int expected = 0; expected < 4; expected++) {
+        ASSERT_TRUE(queue.pop(value));
+        EXPECT_EQ(value, expected);
+    }
+    EXPECT_FALSE(queue.pop(value));
+
+    constexpr int count = 100000;
+    std::thread producer([&queue] {
+        for (int next = 0; next < count; next++) {
+            while (!queue.push(int(next))) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    int expected = 0;
+    while (expected < count) {
+        if (queue.pop(value)) {
+            ASSERT_EQ(value, expected);
+            expected++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    EXPECT_FALSE(queue.pop(value));
+}
+
+TEST_F(AsynchronousEvolutionTestFixture, evolveGeneration_keepsSizeAndBest) {
+    ProblemInstance instance = createGridInstance();
+    Config config = createConfig(0);
+    Population population = initializeFeasiblePopulation(instance, config);
+    double best = bestFitness(population);
+    AsynchronousEvolution evolution(config, instance, config.numberOfThreads);
+    for (int generation = 0; generation < 5; generation++) {
+        evolution.evolveGeneration(population);
+        ASSERT_EQ(population.size(), 20);
+        // replace worst never removes the fittest individual
+        EXPECT_GE(bestFitness(population), best);
+        best = bestFitness(population);
+    }
+}
+
+TEST_F(AsynchronousEvolutionTestFixture, evolveGeneration_crowdingOnlyImprovesSlots) {
+    ProblemInstance instance = createGridInstance();
+    Config config = createConfig(0);
+    config.steadyStateReplacement = ReplacementStrategy::Crowding;
+    Population population = initializeFeasiblePopulation(instance, config);
+    AsynchronousEvolution evolution(config, instance, config.numberOfThreads);
+    for (int generation = 0; generation < 5; generation++) {
+        const Population before = population;
+        evolution.evolveGeneration(population);
+        ASSERT_EQ(population.size(), before.size());
+        // a child only takes the slot of its own parent and only if it is at least as fit
+        for (std::size_t slot = 0; slot < population.size(); slot++) {
+            EXPECT_GE(population[slot].fitness, before[slot].fitness);
+        }
+    }
+}
+
+TEST_F(AsynchronousEvolutionTestFixture, SGA_asynchronousEvolution) {
+    ProblemInstance instance = createGridInstance();
+    Config initialConfig = createConfig(0);
+    Population initial = initializeFeasiblePopulation(instance, initialConfig);
+
+    RandomGenerator::resetInstance();
+    RandomGenerator::getInstance().setSeed(13);
+    Config config = createConfig(10);
+    config.asynchronousEvolution = true;
+    Individual best = SGA(instance, config);
+    EXPECT_GE(best.fitness, bestFitness(initial));
+    EXPECT_TRUE(best.valid);
+
+    config.adaptiveOperatorSelection = true;
+    EXPECT_THROW(SGA(instance, config), std::invalid_argument);
+}
+} // namespace
@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include "checkpoint.h"
+#include "crossover.h"
+#include "GridInstance.h"
+#include "mutation.h"
+#include "parentSelection.h"
+#include "RandomGenerator.h"
+#include "SGA.h"
+#include "structures.h"
+#include "survivorSelection.h"
+
+namespace {
+class CheckpointTestFixture : public ::testing::Test {
+protected:
+    const std::string path = "test_checkpoint.bin";
+
+    void SetUp() override {
+        RandomGenerator::resetInstance();
+    }
+
+    void TearDown() override {
+        std::remove(path.c_str());
+        RandomGenerator::resetInstance();
+    }
+
+    // 20 patients on a grid with wide time windows
+    static auto createInstance() -> ProblemInstance {
+        return makeGridInstance("checkpoint", 5, 20, 4, 10, 600);
+    }
+
+    static auto makeIndividual(Genome genome, double fitness) -> Individual {
+        Individual individual = {genome};
+        individual.fitness = fitness;
+        individual.travelTime = -fitness;
+        individual.journeyValid = std::vector<bool>(genome.size(), true);
+        individual.valid = true;
+        return individual;
+    }
+};
+
+TEST_F(CheckpointTestFixture, randomGenerator_stateRoundTrip) {
+    RandomGenerator &rng = RandomGenerator::getInstance();
+    rng.setSeed(3);
+    rng.generateRandomInt(0, 100);
+    const std::string state = rng.getState();
+    std::vector<int> expected;
+    for (int i = 0; i < 5; i++) {
+        expected.push_back(rng.generateRandomInt(0, 1000));
+    }
+    rng.setState(state);
+    for (int i = 0; i < 5; i++) {
+        EXPECT_EQ(rng.generateRandomInt(0, 1000), expected[i]);
+    }
+    EXPECT_THROW(rng.setState("not a state"), std::invalid_argument);
+}
+
+TEST_F(CheckpointTestFixture, writeAndReadCheckpoint_roundTrip) {
+    Checkpoint checkpoint;
+    checkpoint.instanceName = "train_0";
+    checkpoint.generation = 17;
+    checkpoint.randomState = "1 2 3";
+    checkpoint.population = {makeIndividual({{1, 2}, {}, {3}}, -12.5), makeIndividual({{3, 2, 1}}, -7.25)};
+    checkpoint.population[1].journeyValid = {false};
+    checkpoint.population[1].valid = false;
+    GenerationStatistics statistics;
+    statistics.bestFitness = -7.25;
+    statistics.uniqueGenomes = 2;
+    checkpoint.statistics = {statistics, statistics};
+    checkpoint.mutationQualities = {0.25, 0.75};
+
+    writeCheckpoint(checkpoint, path);
+    Checkpoint restored = readCheckpoint(path);
+    EXPECT_EQ(restored.instanceName, checkpoint.instanceName);
+    EXPECT_EQ(restored.generation, 17);
+    EXPECT_EQ(restored.randomState, checkpoint.randomState);
+    ASSERT_EQ(restored.population.size(), 2);
+    for (std::size_t i = 0; i < 2; i++) {
+        EXPECT_EQ(restored.population[i].genome, checkpoint.population[i].genome);
+        EXPECT_EQ(restored.population[i].fitness, checkpoint.population[i].fitness);
+        EXPECT_EQ(restored.population[i].travelTime, checkpoint.population[i].travelTime);
+        EXPECT_EQ(restored.population[i].journeyValid, checkpoint.population[i].journeyValid);
+        EXPECT_EQ(restored.population[i].valid, checkpoint.population[i].valid);
+    }
+    ASSERT_EQ(restored.statistics.size(), 2);
+    EXPECT_EQ(restored.statistics[1].bestFitness, -7.25);
+    EXPECT_EQ(restored.statistics[1].uniqueGenomes, 2);
+    EXPECT_TRUE(restored.crossoverQualities.empty());
+    EXPECT_EQ(restored.mutationQualities, checkpoint.mutationQualities);
+}
+
+TEST_F(CheckpointTestFixture, readCheckpoint_rejectsBrokenFiles) {
+    EXPECT_THROW(readCheckpoint("does_not_exist.bin"), std::runtime_error);
+    {
+        std::ofstream stream(path, std::ios::binary);
+        stream << "not a checkpoint";
+    }
+    EXPECT_THROW(readCheckpoint(path), std::runtime_error);
+
+    Checkpoint checkpoint;
+    checkpoint.population = {makeIndividual({{1, 2}}, -1.0)};
+    writeCheckpoint(checkpoint, path);
+    std::string content;
+    {
+        std::ifstream stream(path, std::ios::binary);
+        content.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+        stream.write(content.data(), static_cast<std::streamsize>(content.size() - 10));
+    }
+    EXPECT_THROW(readCheckpoint(path), std::runtime_error);
+}
+
+TEST_F(CheckpointTestFixture, readCheckpoint_rejectsCorruptCounts) {
+    Checkpoint checkpoint;
+    checkpoint.population = {makeIndividual({{1, 2}}, -1.0)};
+    writeCheckpoint(checkpoint, path);
+    std::string content;
+    {
+        std::ifstream stream(path, std::ios::binary);
+        content.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    }
+    // the length of the instance name, the population size and the number of journeys of the individual
+    for (std::size_t offset : {16, 36, 44}) {
+        std::string corrupt = content;
+        const std::uint64_t count = 1ULL << 60;
+        corrupt.replace(offset, sizeof(count), reinterpret_cast<const char *>(&count), sizeof(count));
+        {
+            std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+            stream.write(corrupt.data(), static_cast<std::streamsize>(corrupt.size()));
+        }
+        EXPECT_THROW(readCheckpoint(path), std::runtime_error) << "count at offset " << offset;
+    }
+}
+
+TEST_F(CheckpointTestFixture, SGA_resumedRunMatchesUninterruptedRun) {
+    ProblemInstance instance = createInstance();
+    FunctionParameters emptyParams;
+    FunctionParameters tournamentParams = {{"tournamentSize", 3}, {"tournamentProbability", 0.8}};
+    FunctionParameters elitismParams = {{"elitism_percentage", 0.2}, {"fillFunction", "rouletteWheel"}};
+    auto createConfig = [&](int numberOfGenerations) {
+        Config config(20, numberOfGenerations, false, {tournamentSelection, tournamentParams},
+                      {{order1Crossover, 0.5}}, {{reassignOnePatient, emptyParams, 0.2}, {swapBetweenJourneys, emptyParams, 0.2}},
+                      {elitismWithFill, elitismParams});
+        config.checkpointPath = path;
+        return config;
+    };
+
+    RandomGenerator::getInstance().setSeed(11);
+    Individual uninterrupted = SGA(instance, createConfig(6));
+
+    // first run stops after 3 generations, the second continues it up to 6
+    RandomGenerator::resetInstance();
+    RandomGenerator::getInstance().setSeed(11);
+    Config firstPart = createConfig(3);
+    firstPart.checkpointInterval = 2;
+    SGA(instance, firstPart);
+    EXPECT_EQ(readCheckpoint(path).generation, 3);
+    EXPECT_EQ(readCheckpoint(path).statistics.size(), 3);
+
+    RandomGenerator::resetInstance();
+    Config secondPart = createConfig(6);
+    secondPart.resumeFromCheckpoint = true;
+    Individual resumed = SGA(instance, secondPart);
+    EXPECT_EQ(resumed.genome, uninterrupted.genome);
+    EXPECT_EQ(resumed.fitness, uninterrupted.fitness);
+
+    ProblemInstance otherInstance = createInstance();
+    otherInstance.instanceName = "other";
+    EXPECT_THROW(SGA(otherInstance, secondPart), std::runtime_error);
+}
+} // namespace
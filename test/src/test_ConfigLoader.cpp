@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include "configLoader.h"
+#include "crossover.h"
+#include "mutation.h"
+#include "parentSelection.h"
+#include "structures.h"
+#include "survivorSelection.h"
+
+using json = nlohmann::json;
+
+namespace {
+class ConfigLoaderTestFixture : public ::testing::Test {
+protected:
+    std::string loadedInstance;
+    int loadedNeighbours = 0;
+    InstanceLoader instanceLoader = [this](const std::string &instanceFile, int numberOfNeighbours) -> ProblemInstance {
+        loadedInstance = instanceFile;
+        loadedNeighbours = numberOfNeighbours;
+        return {instanceFile, 2, 10, 0.0, {0, 0, 100}, {{1, {1, 1, 0, 100, 0, 1, 0}}}, {{0, 1}, {1, 0}}};
+    };
+
+    json configuration = json::parse(R"({
+        "instance": "train_1.json",
+        "seed": 42,
+        "populationSize": 50,
+        "generations": 20,
+        "parentSelection": {"name": "tournamentSelection", "tournamentSize": 3, "tournamentProbability": 1},
+        "crossovers": [{"name": "edgeRecombination", "probability": 0.5}],
+        "mutations": [{"name": "2opt", "probability": 0.1, "improvement_strategy": "best"},
+                      {"name": "reassignOnePatient", "probability": 0.2}],
+        "survivorSelection": {"name": "elitismWithFill", "elitism_percentage": 0.1, "fillFunction": "rouletteWheel"},
+        "numberOfThreads": 4,
+        "seedingProportions": {"savings": 0.25},
+        "checkpointInterval": 5
+    })");
+};
+
+TEST_F(ConfigLoaderTestFixture, loadRunConfiguration_buildsConfig) {
+    RunConfiguration run = loadRunConfiguration(configuration, instanceLoader);
+    EXPECT_EQ(run.instanceFile, "train_1.json");
+    EXPECT_EQ(loadedInstance, "train_1.json");
+    EXPECT_EQ(loadedNeighbours, 20);
+    EXPECT_EQ(run.seed, 42);
+    ASSERT_NE(run.config, nullptr);
+    const Config &config = *run.config;
+    EXPECT_EQ(config.populationSize, 50);
+    EXPECT_EQ(config.numberOfGenerations, 20);
+    EXPECT_EQ(config.parentSelection.first, tournamentSelection);
+    EXPECT_EQ(std::get<int>(config.parentSelection.second.at("tournamentSize")), 3);
+    EXPECT_DOUBLE_EQ(std::get<double>(config.parentSelection.second.at("tournamentProbability")), 1.0);
+    ASSERT_EQ(config.crossover.size(), 1);
+    EXPECT_EQ(config.crossover[0].first, edgeRecombination);
+    EXPECT_DOUBLE_EQ(config.crossover[0].second, 0.5);
+    ASSERT_EQ(config.mutation.size(), 2);
+    EXPECT_EQ(std::get<0>(config.mutation[0]), twoOpt);
+    EXPECT_EQ(std::get<std::string>(std::get<1>(config.mutation[0]).at("improvement_strategy")), "best");
+    EXPECT_EQ(std::get<ProblemInstance>(std::get<1>(config.mutation[0]).at("problem_instance")).instanceName, "train_1.json");
+    EXPECT_DOUBLE_EQ(std::get<2>(config.mutation[0]), 0.1);
+    EXPECT_EQ(std::get<0>(config.mutation[1]), reassignOnePatient);
+    EXPECT_TRUE(std::get<1>(config.mutation[1]).empty());
+    EXPECT_EQ(config.survivorSelection.first, elitismWithFill);
+    EXPECT_EQ(config.numberOfThreads, 4);
+    EXPECT_DOUBLE_EQ(config.seedingProportions.savings, 0.25);
+    EXPECT_DOUBLE_EQ(config.seedingProportions.sweep, 0.0);
+    EXPECT_EQ(config.checkpointInterval, 5);
+    EXPECT_FALSE(config.resumeFromCheckpoint);
+    EXPECT_FALSE(config.steadyState);
+    EXPECT_EQ(config.steadyStateReplacement, ReplacementStrategy::Worst);
+    EXPECT_FALSE(config.asynchronousEvolution);
+    EXPECT_EQ(config.populationExportInterval, 0);
+    EXPECT_EQ(config.populationExportFormat, PopulationExportFormat::Binary);
+
+    // the references into the run stay valid when the run is moved
+    RunConfiguration moved = std::move(run);
+    EXPECT_EQ(std::get<int>(moved.config->parentSelection.second.at("tournamentSize")), 3);
+}
+
+TEST_F(ConfigLoaderTestFixture, loadRunConfiguration_rejectsInvalidConfigurations) {
+    auto expectRejected = [this](const json &patch) {
+        json invalid = configuration;
+        invalid.merge_patch(patch);
+        EXPECT_THROW(loadRunConfiguration(invalid, instanceLoader), std::invalid_argument) << patch.dump();
+    };
+    expectRejected({{"unknownKey", 1}});
+    expectRejected({{"populationSize", "many"}});
+    expectRejected({{"populationSize", 1}});
+    expectRejected({{"parentSelection", {{"name", "bestSelection"}}}});
+    // merge_patch removes keys that are set to null
+    expectRejected({{"parentSelection", {{"tournamentProbability", nullptr}}}});
+    expectRejected({{"parentSelection", {{"name", "tournamentSelection"}, {"tournamentSize", 2.5}, {"tournamentProbability", 0.8}}}});
+    expectRejected({{"crossovers", {{{"name", "edgeRecombination"}}}}});
+    expectRejected({{"crossovers", {{{"name", "edgeRecombination"}, {"probability", 1.5}}}}});
+    expectRejected({{"mutations", {{{"name", "2opt"}, {"probability", 0.1}, {"improvement", "best"}}}}});
+    expectRejected({{"mutations", {{{"name", "orOpt"}, {"probability", 0.1}, {"max_segment_length", true}}}}});
+    expectRejected({{"seedingProportions", {{"random", 0.5}}}});
+    expectRejected({{"numberOfThreads", 0}});
+    expectRejected({{"steadyStateReplacement", "oldest"}});
+    expectRejected({{"steadyStateTournamentSize", 0}});
+    expectRejected({{"asynchronousEvolution", true}, {"adaptiveOperatorSelection", true}});
+    expectRejected({{"populationExportFormat", "csv"}});
+    expectRejected({{"populationExportInterval", -1}});
+    // values of the right type but outside their allowed range
+    expectRejected({{"survivorSelection", {{"elitism_percentage", 1.5}}}});
+    expectRejected({{"survivorSelection", {{"fillFunction", "foo"}}}});
+    expectRejected({{"parentSelection", {{"tournamentProbability", -3}}}});
+    expectRejected({{"parentSelection", {{"tournamentSize", 3000000000LL}}}});
+    expectRejected({{"mutations", {{{"name", "2opt"}, {"probability", 0.1}, {"improvement_strategy", "bets"}}}}});
+    expectRejected({{"mutations", {{{"name", "ruinAndRecreate"}, {"probability", 0.1}, {"removal_strategy", "randm"}}}}});
+    expectRejected({{"mutations", {{{"name", "ruinAndRecreate"}, {"probability", 0.1}, {"regret", 1}}}}});
+    expectRejected({{"mutations", {{{"name", "ruinAndRecreate"}, {"probability", 0.1}, {"removal_fraction", 0}}}}});
+    expectRejected({{"mutations", {{{"name", "ruinAndRecreate"}, {"probability", 0.1}, {"removal_fraction", 1.5}}}}});
+    expectRejected({{"fitnessCacheCapacity", -1}});
+    expectRejected({{"seed", -1}});
+    expectRejected({{"seedingProportions", {{"savings", 0.75}, {"sweep", 0.5}}}});
+    expectRejected({{"adaptiveOperatorSelection", true}, {"minimumOperatorProbability", 0.5}});
+    expectRejected({{"operatorAdaptationRate", 0}});
+}
+
+TEST_F(ConfigLoaderTestFixture, loadRunConfiguration_acceptsRepositoryConfiguration) {
+    json repositoryConfiguration = readConfigurationFile("./../config.json");
+    RunConfiguration run = loadRunConfiguration(repositoryConfiguration, instanceLoader);
+    EXPECT_FALSE(run.config->mutation.empty());
+}
+
+TEST_F(ConfigLoaderTestFixture, registries_containEveryOperatorOnce) {
+    EXPECT_EQ(parentSelectionRegistry().size(), 2);
+    EXPECT_EQ(crossoverRegistry().size(), 3);
+    EXPECT_TRUE(mutationRegistry().count("ruinAndRecreate"));
+    EXPECT_TRUE(mutationRegistry().at("insertionHeuristic").needsProblemInstance);
+    EXPECT_FALSE(mutationRegistry().at("swapWithinJourney").needsProblemInstance);
+    EXPECT_TRUE(survivorSelectionRegistry().count("biasedFitnessReplacement"));
+}
+
+TEST_F(ConfigLoaderTestFixture, parseCommandLine_overrides) {
+    CommandLineOptions options = parseCommandLine({"--config", "sweep.json", "--instance", "train_3.json", "--seed", "7",
+                                                   "--threads", "8", "--population", "200", "--generations", "50", "--resume"});
+    EXPECT_EQ(options.configurationPath, "sweep.json");
+    configuration.merge_patch(options.overrides);
+    RunConfiguration run = loadRunConfiguration(configuration, instanceLoader);
+    EXPECT_EQ(run.instanceFile, "train_3.json");
+    EXPECT_EQ(run.seed, 7);
+    EXPECT_EQ(run.config->numberOfThreads, 8);
+    EXPECT_EQ(run.config->populationSize, 200);
+    EXPECT_EQ(run.config->numberOfGenerations, 50);
+    EXPECT_TRUE(run.config->resumeFromCheckpoint);
+
+    EXPECT_EQ(parseCommandLine({}).configurationPath, "./../config.json");
+    EXPECT_THROW(parseCommandLine({"--verbose"}), std::invalid_argument);
+    EXPECT_THROW(parseCommandLine({"--seed"}), std::invalid_argument);
+    EXPECT_THROW(parseCommandLine({"--seed", "7x"}), std::invalid_argument);
+}
+} // namespace
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include "construction.h"
+#include "GridInstance.h"
+#include "structures.h"
+#include "utils.h"
+
+namespace {
+class ConstructionTestFixture : public ::testing::Test {
+protected:
+    // 30 patients on a grid, every time window is 300 long and starts somewhere in [0, 300]
+    static auto createInstance(int nurseCapacity, int numberOfNurses) -> ProblemInstance {
+        return makeGridInstance("test", 3, 30, numberOfNurses, nurseCapacity, 300, 300);
+    }
+
+    static auto sortedPatients(const Genome &genome) -> std::vector<int> {
+        std::vector<int> patients = flattenGenome(genome);
+        std::sort(patients.begin(), patients.end());
+        return patients;
+    }
+
+    std::vector<int> allPatients = [] {
+        std::vector<int> patients(30);
+        for (int id = 1; id <= 30; id++) {
+            patients[id - 1] = id;
+        }
+        return patients;
+    }();
+};
+
+TEST_F(ConstructionTestFixture, groupPatientsByEndTime_ascendingEndTimes) {
+    ProblemInstance instance = createInstance(10, 5);
+    EndTimeGroups groups = groupPatientsByEndTime(instance);
+    int previousEndTime = -1;
+    std::size_t numberOfPatients = 0;
+    for (const std::vector<int> &group : groups) {
+        ASSERT_FALSE(group.empty());
+        const int endTime = instance.patientTable[group.front()].endTime;
+        EXPECT_GT(endTime, previousEndTime);
+        for (int patient : group) {
+            EXPECT_EQ(instance.patientTable[patient].endTime, endTime);
+        }
+        previousEndTime = endTime;
+        numberOfPatients += group.size();
+    }
+    EXPECT_EQ(numberOfPatients, 30);
+}
+
+TEST_F(ConstructionTestFixture, constructPopulation_buildsFeasibleIndividuals) {
+    ProblemInstance instance = createInstance(10, 5);
+    Population population = constructPopulation(instance, {1, 2, 3, 4, 5, 6, 7, 8}, 1, 10);
+    ASSERT_EQ(population.size(), 8);
+    for (const Individual &individual : population) {
+        EXPECT_EQ(individual.genome.size(), 5);
+        EXPECT_EQ(sortedPatients(individual.genome), allPatients);
+        EXPECT_TRUE(isSolutionValid(individual.genome, instance));
+    }
+}
+
+TEST_F(ConstructionTestFixture, constructPopulation_independentOfThreads) {
+    ProblemInstance instance = createInstance(10, 5);
+    std::vector<std::uint64_t> seeds = {11, 12, 13, 14, 15, 16, 17};
+    Population sequential = constructPopulation(instance, seeds, 1, 10);
+    Population parallel = constructPopulation(instance, seeds, 3, 10);
+    ASSERT_EQ(sequential.size(), parallel.size());
+    for (std::size_t i = 0; i < sequential.size(); i++) {
+        EXPECT_EQ(sequential[i].genome, parallel[i].genome);
+    }
+}
+
+TEST_F(ConstructionTestFixture, constructGenome_repairsWhenNothingFits) {
+    // 3 nurses with a capacity of 5 can not take 30 patients, the repair still places all of them
+    ProblemInstance instance = createInstance(5, 3);
+    std::mt19937_64 engine(1);
+    Genome genome = constructGenome(instance, groupPatientsByEndTime(instance), engine, 3);
+    EXPECT_EQ(genome.size(), 3);
+    EXPECT_EQ(sortedPatients(genome), allPatients);
+}
+
+TEST_F(ConstructionTestFixture, seedingHeuristics_buildFeasibleGenomes) {
+    ProblemInstance instance = createInstance(10, 5);
+    for (auto heuristic : {savingsGenome, solomonI1Genome, sweepGenome}) {
+        for (std::uint64_t seed = 1; seed <= 5; seed++) {
+            std::mt19937_64 engine(seed);
+            Genome genome = heuristic(instance, engine);
+            EXPECT_EQ(genome.size(), 5);
+            EXPECT_EQ(sortedPatients(genome), allPatients);
+            EXPECT_TRUE(isSolutionValid(genome, instance));
+        }
+    }
+}
+
+TEST_F(ConstructionTestFixture, seedingHeuristics_keepAllPatientsWhenNothingFits) {
+    ProblemInstance instance = createInstance(5, 3);
+    for (auto heuristic : {savingsGenome, solomonI1Genome, sweepGenome}) {
+        std::mt19937_64 engine(7);
+        Genome genome = heuristic(instance, engine);
+        EXPECT_EQ(genome.size(), 3);
+        EXPECT_EQ(sortedPatients(genome), allPatients);
+    }
+}
+
+TEST_F(ConstructionTestFixture, assignSeedingHeuristics_roundsDownAndFillsWithEndTime) {
+    std::vector<SeedingHeuristic> heuristics = assignSeedingHeuristics(10, {0.25, 0.1, 0.3});
+    ASSERT_EQ(heuristics.size(), 10);
+    EXPECT_EQ(std::count(heuristics.begin(), heuristics.end(), SeedingHeuristic::Savings), 2);
+    EXPECT_EQ(std::count(heuristics.begin(), heuristics.end(), SeedingHeuristic::SolomonI1), 1);
+    EXPECT_EQ(std::count(heuristics.begin(), heuristics.end(), SeedingHeuristic::Sweep), 3);
+    EXPECT_EQ(std::count(heuristics.begin(), heuristics.end(), SeedingHeuristic::EndTime), 4);
+    EXPECT_THROW(assignSeedingHeuristics(10, {0.5, 0.5, 0.5}), std::invalid_argument);
+    EXPECT_THROW(assignSeedingHeuristics(10, {-0.1, 0.0, 0.0}), std::invalid_argument);
+}
+
+TEST_F(ConstructionTestFixture, constructPopulation_mixedHeuristicsIndependentOfThreads) {
+    ProblemInstance instance = createInstance(10, 5);
+    std::vector<std::uint64_t> seeds = {21, 22, 23, 24, 25, 26, 27, 28};
+    std::vector<SeedingHeuristic> heuristics = assignSeedingHeuristics(8, {0.25, 0.25, 0.25});
+    Population sequential = constructPopulation(instance, seeds, heuristics, 1, 10);
+    Population parallel = constructPopulation(instance, seeds, heuristics, 4, 10);
+    ASSERT_EQ(sequential.size(), 8);
+    for (std::size_t i = 0; i < sequential.size(); i++) {
+        EXPECT_EQ(sequential[i].genome, parallel[i].genome);
+        EXPECT_EQ(sortedPatients(sequential[i].genome), allPatients);
+    }
+}
+} // namespace
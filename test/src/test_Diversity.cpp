@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include "diversity.h"
+#include "structures.h"
+#include "survivorSelection.h"
+
+namespace {
+class DiversityTestFixture : public ::testing::Test {
+protected:
+    static auto makeIndividual(Genome genome, double fitness) -> Individual {
+        Individual individual = {genome};
+        individual.fitness = fitness;
+        return individual;
+    }
+
+    static auto contains(const Population &population, const Genome &genome) -> bool {
+        return std::any_of(population.begin(), population.end(), [&genome](const Individual &individual) {
+            return individual.genome == genome;
+        });
+    }
+};
+
+TEST_F(DiversityTestFixture, brokenPairsDistance_sameJourneys) {
+    EXPECT_DOUBLE_EQ(brokenPairsDistance(Genome{{1, 2}, {3, 4}}, Genome{{1, 2}, {3, 4}}), 0.0);
+    // the nurse and the direction of a journey do not matter
+    EXPECT_DOUBLE_EQ(brokenPairsDistance(Genome{{1, 2}, {3, 4}}, Genome{{}, {4, 3}, {1, 2}}), 0.0);
+    EXPECT_DOUBLE_EQ(brokenPairsDistance(Genome{{1, 2, 3}}, Genome{{3, 2, 1}}), 0.0);
+}
+
+TEST_F(DiversityTestFixture, brokenPairsDistance_countsBrokenEdges) {
+    // 1 -> 2 and 3 -> 4 are broken, the depot edges 2 -> 0 and 4 -> 0 are kept
+    EXPECT_DOUBLE_EQ(brokenPairsDistance(Genome{{1, 2}, {3, 4}}, Genome{{1, 3}, {2, 4}}), 0.5);
+    // 1 -> 2 and 3 -> 0 are broken
+    EXPECT_DOUBLE_EQ(brokenPairsDistance(Genome{{1, 2, 3}}, Genome{{1, 3, 2}}), 2.0 / 3.0);
+    // the journey start 1 lies inside the journey of b
+    EXPECT_DOUBLE_EQ(brokenPairsDistance(Genome{{1}, {2, 3}}, Genome{{2, 1, 3}}), 1.0);
+}
+
+TEST_F(DiversityTestFixture, canonicalGenomeHash_ignoresJourneyOrder) {
+    EXPECT_EQ(canonicalGenomeHash({{1, 2}, {3}, {}}), canonicalGenomeHash({{}, {3}, {1, 2}}));
+    EXPECT_NE(canonicalGenomeHash({{1, 2}, {3}}), canonicalGenomeHash({{2, 1}, {3}}));
+    EXPECT_NE(canonicalGenomeHash({{1, 2}, {3}}), canonicalGenomeHash({{1}, {2, 3}}));
+}
+
+TEST_F(DiversityTestFixture, removeDuplicates_keepsFirstOccurrence) {
+    Population population = {makeIndividual({{1, 2}, {3}}, -1.0),
+                             makeIndividual({{3}, {1, 2}}, -2.0),
+                             makeIndividual({{1}, {2, 3}}, -3.0),
+                             makeIndividual({{1, 2}, {3}}, -4.0)};
+    Population duplicates = removeDuplicates(population);
+    ASSERT_EQ(population.size(), 2);
+    EXPECT_DOUBLE_EQ(population[0].fitness, -1.0);
+    EXPECT_DOUBLE_EQ(population[1].fitness, -3.0);
+    ASSERT_EQ(duplicates.size(), 2);
+    EXPECT_DOUBLE_EQ(duplicates[0].fitness, -2.0);
+    EXPECT_DOUBLE_EQ(duplicates[1].fitness, -4.0);
+}
+
+TEST_F(DiversityTestFixture, averageDistanceTo_standardCase) {
+    Population population = {makeIndividual({{1, 2}, {3, 4}}, 0.0),
+                             makeIndividual({{1, 2}, {3, 4}}, 0.0),
+                             makeIndividual({{1, 3}, {2, 4}}, 0.0)};
+    EXPECT_DOUBLE_EQ(averageDistanceTo(population, 0), 0.25);
+    EXPECT_DOUBLE_EQ(averageDistanceTo({population[0]}, 0), 0.0);
+}
+
+TEST_F(DiversityTestFixture, biasedFitnessReplacement_removesDuplicates) {
+    Genome a = {{1, 2, 3, 4}};
+    Population parents = {makeIndividual(a, -10.0), makeIndividual(a, -10.0), makeIndividual({{1, 3, 2, 4}}, -20.0)};
+    Population children = {makeIndividual(a, -10.0), makeIndividual({{4, 1}, {2, 3}}, -30.0), makeIndividual({{1}, {2}, {3}, {4}}, -40.0)};
+    Population survivors = biasedFitnessReplacement(parents, children, {}, 3);
+    ASSERT_EQ(survivors.size(), 3);
+    EXPECT_TRUE(contains(survivors, a));
+    EXPECT_EQ(std::count_if(survivors.begin(), survivors.end(), [&a](const Individual &individual) { return individual.genome == a; }), 1);
+}
+
+TEST_F(DiversityTestFixture, biasedFitnessReplacement_fillsWithDuplicates) {
+    Genome a = {{1, 2, 3}};
+    Population survivors = biasedFitnessReplacement({makeIndividual(a, -1.0), makeIndividual(a, -1.0)},
+                                                    {makeIndividual(a, -1.0), makeIndividual({{3, 1, 2}}, -2.0)}, {}, 3);
+    ASSERT_EQ(survivors.size(), 3);
+    EXPECT_EQ(std::count_if(survivors.begin(), survivors.end(), [&a](const Individual &individual) { return individual.genome == a; }), 2);
+}
+
+TEST_F(DiversityTestFixture, biasedFitnessReplacement_prefersDiverseIndividual) {
+    Genome best = {{1, 2, 3, 4, 5, 6}};
+    Genome closeToBest = {{1, 2, 3, 4, 6, 5}};
+    Genome far = {{1, 3, 5}, {2, 4, 6}};
+    FunctionParameters parameters = {{"number_of_closest", 1}, {"number_of_elites", 0}};
+    Population survivors = biasedFitnessReplacement({makeIndividual(best, -1.0), makeIndividual(closeToBest, -2.0)},
+                                                    {makeIndividual(far, -3.0)}, parameters, 2);
+    ASSERT_EQ(survivors.size(), 2);
+    EXPECT_EQ(survivors[0].genome, best);
+    EXPECT_EQ(survivors[1].genome, far);
+}
+} // namespace
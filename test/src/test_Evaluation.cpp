@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include "evaluation.h"
+#include "utils.h"
+#include "structures.h"
+
+namespace {
+class EvaluationTestFixture : public ::testing::Test {
+protected:
+    // patient 3 has to be cared for until time 10, the nurse has to be back at time 20
+    ProblemInstance instance = {
+        "test", // instanceName
+        2, // numberOfNurses
+        3, // nurseCapacity
+        0.0, // benchmark
+        {0, 0, 20}, // depot
+        {{1, {1, 1, 0, 100, 1, 1, 0}},
+         {2, {2, 1, 0, 100, 1, 2, 0}},
+         {3, {3, 2, 0, 10, 1, 3, 0}}},
+        {{0, 1, 2, 3},
+         {1, 0, 1, 2},
+         {2, 1, 0, 1},
+         {3, 2, 1, 0}}
+    };
+};
+
+TEST_F(EvaluationTestFixture, evaluateJourney_standardCase) {
+    // depot -> 1 (1) -> 3 (2) -> depot (3)
+    JourneyEvaluation evaluation = evaluateJourney({1, 3}, instance);
+    EXPECT_DOUBLE_EQ(evaluation.travelTime, 6.0);
+    // two care times of 1 on top of the driving time
+    EXPECT_DOUBLE_EQ(evaluation.returnTime, 8.0);
+    EXPECT_EQ(evaluation.demand, 3);
+    EXPECT_TRUE(evaluation.valid);
+}
+
+TEST_F(EvaluationTestFixture, evaluateIndividual_validIndividual) {
+    Individual individual = {{{1, 3}, {2}}};
+    evaluateIndividual(&individual, instance);
+    EXPECT_DOUBLE_EQ(individual.travelTime, 10.0);
+    EXPECT_DOUBLE_EQ(individual.fitness, -10.0);
+    EXPECT_TRUE(individual.valid);
+    EXPECT_EQ(individual.journeyValid, std::vector<bool>({true, true}));
+    EXPECT_EQ(individual.valid, isSolutionValid(individual.genome, instance));
+}
+
+TEST_F(EvaluationTestFixture, evaluateIndividual_penalties) {
+    // demand 4 exceeds the capacity of 3, all time windows are met
+    Individual individual = {{{1, 2, 3}, {}}};
+    evaluateIndividual(&individual, instance);
+    EXPECT_DOUBLE_EQ(individual.capacityPenality, 1.0);
+    EXPECT_DOUBLE_EQ(individual.missingCareTimePenality, 0.0);
+    EXPECT_DOUBLE_EQ(individual.travelTime, 6.0);
+    EXPECT_DOUBLE_EQ(individual.fitness, -6.0 - 100000.0);
+    EXPECT_FALSE(individual.valid);
+    EXPECT_EQ(individual.journeyValid, std::vector<bool>({false, true}));
+    EXPECT_EQ(individual.valid, isSolutionValid(individual.genome, instance));
+}
+
+TEST_F(EvaluationTestFixture, evaluateIndividual_missingPatientIsInvalid) {
+    Individual individual = {{{1}, {2}}};
+    evaluateIndividual(&individual, instance);
+    EXPECT_EQ(individual.journeyValid, std::vector<bool>({true, true}));
+    EXPECT_FALSE(individual.valid);
+}
+TEST_F(EvaluationTestFixture, evaluateJourneys_matchesEvaluateJourney) {
+    // more journeys than one batch holds, with different lengths, empty journeys and every kind of violation
+    std::vector<Journey> journeys = {{1, 3}, {}, {1, 2, 3}, {3, 2, 1}, {2}, {3, 1}, {}, {2, 3}, {1}};
+    ProblemInstance lateReturn = instance;
+    lateReturn.depot.returnTime = 6;
+    for (const ProblemInstance &problemInstance : {instance, lateReturn}) {
+        std::vector<const Journey *> journeyPointers;
+        for (const Journey &journey : journeys) {
+            journeyPointers.push_back(&journey);
+        }
+        std::vector<JourneyEvaluation> evaluations;
+        evaluateJourneys(journeyPointers, problemInstance, evaluations);
+        ASSERT_EQ(evaluations.size(), journeys.size());
+        for (std::size_t i = 0; i < journeys.size(); i++) {
+            JourneyEvaluation expected = evaluateJourney(journeys[i], problemInstance);
+            EXPECT_EQ(evaluations[i].travelTime, expected.travelTime) << "journey " << i;
+            EXPECT_EQ(evaluations[i].returnTime, expected.returnTime) << "journey " << i;
+            EXPECT_EQ(evaluations[i].missingCareTime, expected.missingCareTime) << "journey " << i;
+            EXPECT_EQ(evaluations[i].capacityExcess, expected.capacityExcess) << "journey " << i;
+            EXPECT_EQ(evaluations[i].demand, expected.demand) << "journey " << i;
+            EXPECT_EQ(evaluations[i].valid, expected.valid) << "journey " << i;
+        }
+    }
+}
+
+TEST_F(EvaluationTestFixture, evaluatePopulation_matchesEvaluateIndividual) {
+    Population population = {{{{1, 3}, {2}}}, {{{1, 2, 3}, {}}}, {{{1}, {2}}}, {{{3, 2, 1}, {}}}, {{{}, {2, 3, 1}}}};
+    Population expected = population;
+    evaluatePopulation(population, instance);
+    for (std::size_t i = 0; i < population.size(); i++) {
+        evaluateIndividual(&expected[i], instance);
+        EXPECT_EQ(population[i].fitness, expected[i].fitness) << "individual " << i;
+        EXPECT_EQ(population[i].travelTime, expected[i].travelTime) << "individual " << i;
+        EXPECT_EQ(population[i].capacityPenality, expected[i].capacityPenality) << "individual " << i;
+        EXPECT_EQ(population[i].missingCareTimePenality, expected[i].missingCareTimePenality) << "individual " << i;
+        EXPECT_EQ(population[i].toLateToDepotPenality, expected[i].toLateToDepotPenality) << "individual " << i;
+        EXPECT_EQ(population[i].journeyValid, expected[i].journeyValid) << "individual " << i;
+        EXPECT_EQ(population[i].valid, expected[i].valid) << "individual " << i;
+    }
+}
+} // namespace
@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include "cache.h"
+#include "evaluation.h"
+#include "fitnessCache.h"
+#include "genomeHash.h"
+#include "structures.h"
+
+namespace {
+class FitnessCacheTestFixture : public ::testing::Test {
+protected:
+    ProblemInstance instance = {
+        "test", // instanceName
+        2, // numberOfNurses
+        3, // nurseCapacity
+        0.0, // benchmark
+        {0, 0, 20}, // depot
+        {{1, {1, 1, 0, 100, 1, 1, 0}},
+         {2, {2, 1, 0, 100, 1, 2, 0}},
+         {3, {3, 2, 0, 10, 1, 3, 0}}},
+        {{0, 1, 2, 3},
+         {1, 0, 1, 2},
+         {2, 1, 0, 1},
+         {3, 2, 1, 0}}
+    };
+
+    void TearDown() override {
+        FitnessCache::getInstance().configure(false, 1 << 16, "");
+        JourneyCache::getInstance().configure(false, 1 << 16, "");
+    }
+};
+
+TEST_F(FitnessCacheTestFixture, hashGenome_distinguishesOrderAndNurse) {
+    EXPECT_EQ(hashGenome({{1, 3}, {2}}), hashGenome({{1, 3}, {2}}));
+    EXPECT_NE(hashGenome({{1, 3}, {2}}), hashGenome({{3, 1}, {2}}));
+    EXPECT_NE(hashGenome({{1, 3}, {2}}), hashGenome({{2}, {1, 3}}));
+    EXPECT_NE(hashGenome({{1, 3}, {2}}), hashGenome({{1, 3}, {2}, {}}));
+    // repeated edges must not cancel out
+    EXPECT_NE(hashGenome({{1, 2, 1, 2}, {}}), hashGenome({{1, 2}, {}}));
+}
+
+TEST_F(FitnessCacheTestFixture, hashGenome_incrementalUpdate) {
+    // moving patient 2 behind patient 3 replaces the edges 1->2, 2->3, 3->0 by 1->3, 3->2, 2->0
+    std::uint64_t hash = hashGenome({{1, 2, 3}, {}});
+    hash = hash - edgeKey(0, 1, 2) - edgeKey(0, 2, 3) - edgeKey(0, 3, 0) + edgeKey(0, 1, 3) + edgeKey(0, 3, 2) + edgeKey(0, 2, 0);
+    EXPECT_EQ(hash, hashGenome({{1, 3, 2}, {}}));
+}
+
+TEST_F(FitnessCacheTestFixture, hashGenomeWithCheck_keyIsZobristHash) {
+    const HashWithCheck hash = hashGenomeWithCheck({{1, 2, 3}, {}});
+    EXPECT_EQ(hash.key, hashGenome({{1, 2, 3}, {}}));
+    EXPECT_EQ(hashJourneyWithCheck({1, 2, 3}).key, hashJourney({1, 2, 3}, 0));
+    EXPECT_NE(hash.check, hashGenomeWithCheck({{1, 3, 2}, {}}).check);
+    EXPECT_NE(hashGenomeWithCheck({{1, 2}, {3}}).check, hashGenomeWithCheck({{1}, {2, 3}}).check);
+    EXPECT_NE(hashGenomeWithCheck({{1, 2}, {}}).check, hashGenomeWithCheck({{1, 2}, {}, {}}).check);
+}
+
+TEST_F(FitnessCacheTestFixture, boundedCache_evictsOldestEntry) {
+    BoundedCache<int, 1> cache(2);
+    cache.insert(1, 10);
+    cache.insert(2, 20);
+    cache.insert(3, 30);
+    int value = 0;
+    EXPECT_FALSE(cache.find(1, value));
+    EXPECT_TRUE(cache.find(3, value));
+    EXPECT_EQ(value, 30);
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_EQ(cache.hits(), 1);
+    EXPECT_EQ(cache.misses(), 1);
+}
+
+TEST_F(FitnessCacheTestFixture, evaluateIndividual_reusesCachedEvaluation) {
+    FitnessCache &cache = FitnessCache::getInstance();
+    cache.configure(true, 1024, instance.instanceName);
+    Individual first = {{{1, 2, 3}, {}}};
+    evaluateIndividual(&first, instance);
+    EXPECT_EQ(cache.misses(), 1);
+    EXPECT_EQ(cache.hits(), 0);
+
+    Population population = {{{{1, 2, 3}, {}}}, {{{1, 3}, {2}}}};
+    evaluatePopulation(population, instance);
+    EXPECT_EQ(cache.hits(), 1);
+    EXPECT_EQ(cache.misses(), 2);
+    EXPECT_EQ(population[0].fitness, first.fitness);
+    EXPECT_EQ(population[0].capacityPenality, first.capacityPenality);
+    EXPECT_EQ(population[0].journeyValid, first.journeyValid);
+    EXPECT_EQ(population[0].valid, first.valid);
+    EXPECT_TRUE(population[1].valid);
+}
+TEST_F(FitnessCacheTestFixture, evaluateIndividual_ignoresEntryWithDifferentCheck) {
+    FitnessCache &cache = FitnessCache::getInstance();
+    cache.configure(true, 1024, instance.instanceName);
+    Individual expected = {{{1, 2, 3}, {}}};
+    evaluateIndividual(&expected, instance);
+
+    // an entry under the same key whose check differs stands for a key collision with another genome
+    cache.configure(true, 1024, instance.instanceName);
+    HashWithCheck key = cache.keyOf(expected.genome);
+    Individual colliding = expected;
+    colliding.fitness = 1e9;
+    cache.store({key.key, key.check ^ 1}, colliding);
+    Individual individual = {{{1, 2, 3}, {}}};
+    evaluateIndividual(&individual, instance);
+    EXPECT_EQ(individual.fitness, expected.fitness);
+    EXPECT_EQ(cache.hits(), 0);
+    EXPECT_EQ(cache.misses(), 1);
+
+    JourneyCache &journeyCache = JourneyCache::getInstance();
+    journeyCache.configure(true, 1024, instance.instanceName);
+    HashWithCheck journeyKey = journeyCache.keyOf({1, 2, 3});
+    journeyCache.store({journeyKey.key, journeyKey.check ^ 1}, {1e9, 1e9, 0.0, 0.0, 0, true});
+    JourneyEvaluation journeyEvaluation;
+    EXPECT_FALSE(journeyCache.find(journeyKey, journeyEvaluation));
+}
+
+TEST_F(FitnessCacheTestFixture, journeyCache_sharesJourneysBetweenIndividuals) {
+    JourneyCache &cache = JourneyCache::getInstance();
+    cache.configure(true, 1024, instance.instanceName);
+    // the journey {1, 3} is driven by different nurses in the two individuals
+    Individual first = {{{1, 3}, {2}}};
+    Individual second = {{{2}, {1, 3}}};
+    evaluateIndividual(&first, instance);
+    EXPECT_EQ(cache.hits(), 0);
+    EXPECT_EQ(cache.misses(), 2);
+    evaluateIndividual(&second, instance);
+    EXPECT_EQ(cache.hits(), 2);
+
+    Population population = {{{{1, 3}, {2}}}, {{{1, 2, 3}, {}}}};
+    Population expected = population;
+    evaluatePopulation(population, instance);
+    EXPECT_EQ(cache.hits(), 4);
+    EXPECT_EQ(cache.misses(), 3);
+    cache.configure(false, 1024, instance.instanceName);
+    for (std::size_t i = 0; i < expected.size(); i++) {
+        evaluateIndividual(&expected[i], instance);
+        EXPECT_EQ(population[i].fitness, expected[i].fitness);
+        EXPECT_EQ(population[i].journeyValid, expected[i].journeyValid);
+        EXPECT_EQ(population[i].valid, expected[i].valid);
+    }
+}
+} // namespace
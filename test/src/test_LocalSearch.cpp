@@ -0,0 +1,285 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include "localSearch.h"
+#include "structures.h"
+#include "utils.h"
+
+namespace {
+class LocalSearchTestFixture : public ::testing::Test {
+protected:
+    // five patients on a manhattan grid, the optimal tour is 1, 2, 3, 4, 5 with a travel time of 12
+    std::vector<std::vector<double>> travelTime = {
+        {0, 2, 4, 6, 4, 2},
+        {2, 0, 2, 4, 2, 4},
+        {4, 2, 0, 2, 4, 6},
+        {6, 4, 2, 0, 2, 4},
+        {4, 2, 4, 2, 0, 2},
+        {2, 4, 6, 4, 2, 0}
+    };
+
+    // all time windows are wide open, only patient 4 has to be done by time 4
+    auto createInstance(int endTimePatient4) -> ProblemInstance {
+        std::unordered_map<int, Patient> patients = {
+            {1, {1, 1, 0, 100, 0, 2, 0}},
+            {2, {2, 1, 0, 100, 0, 4, 0}},
+            {3, {3, 1, 0, 100, 0, 4, 2}},
+            {4, {4, 1, 0, endTimePatient4, 0, 2, 2}},
+            {5, {5, 1, 0, 100, 0, 0, 2}}
+        };
+        return {"test", 1, 10, 0.0, {0, 0, 100}, patients, travelTime};
+    }
+};
+
+TEST_F(LocalSearchTestFixture, buildRouteSchedule_standardCase) {
+    ProblemInstance instance = createInstance(4);
+    RouteSchedule schedule;
+    buildRouteSchedule({4, 3}, instance, schedule);
+    EXPECT_TRUE(schedule.timeFeasible);
+    EXPECT_EQ(schedule.departureTimes, std::vector<double>({4, 6}));
+    // patient 4 has to be reached by 4, patient 3 by 100 - 6 for the way back to the depot
+    EXPECT_EQ(schedule.latestArrivalTimes, std::vector<double>({4, 94}));
+
+    buildRouteSchedule({3, 4}, instance, schedule);
+    EXPECT_FALSE(schedule.timeFeasible);
+}
+
+TEST_F(LocalSearchTestFixture, twoOptJourney_firstImprovementFindsOptimum) {
+    ProblemInstance instance = createInstance(100);
+    Journey journey = {4, 3, 2, 1, 5};
+    EXPECT_TRUE(twoOptJourney(journey, instance, ImprovementStrategy::FirstImprovement));
+    EXPECT_DOUBLE_EQ(getTotalTravelTime({journey}, instance), 12);
+    EXPECT_TRUE(isJourneyValid(journey, instance));
+}
+
+TEST_F(LocalSearchTestFixture, twoOptJourney_bestImprovementFindsOptimum) {
+    ProblemInstance instance = createInstance(100);
+    Journey journey = {4, 2, 5, 1, 3};
+    EXPECT_TRUE(twoOptJourney(journey, instance, ImprovementStrategy::BestImprovement));
+    EXPECT_DOUBLE_EQ(getTotalTravelTime({journey}, instance), 12);
+}
+
+TEST_F(LocalSearchTestFixture, twoOptJourney_optimalJourneyIsUnchanged) {
+    ProblemInstance instance = createInstance(100);
+    Journey journey = {1, 2, 3, 4, 5};
+    EXPECT_FALSE(twoOptJourney(journey, instance));
+    EXPECT_EQ(journey, Journey({1, 2, 3, 4, 5}));
+}
+
+TEST_F(LocalSearchTestFixture, twoOptJourney_keepsTimeWindows) {
+    // the shorter tours all visit patient 4 too late, so a feasible journey has to stay feasible
+    ProblemInstance instance = createInstance(4);
+    Journey journey = {4, 3, 2, 1, 5};
+    ASSERT_TRUE(isJourneyValid(journey, instance));
+    for (ImprovementStrategy strategy : {ImprovementStrategy::FirstImprovement, ImprovementStrategy::BestImprovement}) {
+        Journey improved = journey;
+        twoOptJourney(improved, instance, strategy);
+        EXPECT_TRUE(isJourneyValid(improved, instance));
+        EXPECT_EQ(improved.front(), 4);
+        EXPECT_LE(getTotalTravelTime({improved}, instance), 16);
+    }
+}
+
+// Creates an instance with patients on random grid points, every time window is [startTime, startTime + windowLength]
+auto createRandomInstance(int numberOfPatients, int numberOfNurses, int windowLength, unsigned seed) -> ProblemInstance {
+    std::mt19937 engine(seed);
+    std::uniform_int_distribution<int> coordinate(0, 50);
+    std::uniform_int_distribution<int> start(0, 200);
+    std::vector<std::pair<int, int>> points = {{25, 25}};
+    std::unordered_map<int, Patient> patients;
+    for (int id = 1; id <= numberOfPatients; id++) {
+        points.push_back({coordinate(engine), coordinate(engine)});
+        int startTime = start(engine);
+        patients[id] = {id, 1 + id % 3, startTime, startTime + windowLength, 5, points.back().first, points.back().second};
+    }
+    std::vector<std::vector<double>> travelTime(points.size(), std::vector<double>(points.size()));
+    for (std::size_t from = 0; from < points.size(); from++) {
+        for (std::size_t to = 0; to < points.size(); to++) {
+            travelTime[from][to] = std::hypot(points[from].first - points[to].first, points[from].second - points[to].second);
+        }
+    }
+    return {"random", numberOfNurses, 12, 0.0, {25, 25, 1000}, patients, travelTime};
+}
+
+auto countValidJourneys(const Genome &genome, const ProblemInstance &instance) -> int {
+    return static_cast<int>(std::count_if(genome.begin(), genome.end(), [&instance](const Journey &journey) { return isJourneyValid(journey, instance); }));
+}
+
+TEST_F(LocalSearchTestFixture, interRouteSearch_relocateJoinsNeighbours) {
+    // patient 5 sits next to patient 4 but is driven to on its own
+    ProblemInstance instance = createInstance(100);
+    instance.numberOfNurses = 2;
+    Genome genome = {{1, 2, 3, 4}, {5}};
+    InterRouteNeighbourhoods relocateOnly = {true, false, false, false};
+    EXPECT_TRUE(interRouteSearch(genome, instance, relocateOnly));
+    EXPECT_EQ(genome, Genome({{1, 2, 3, 4, 5}, {}}));
+}
+
+TEST_F(LocalSearchTestFixture, interRouteSearch_rejectsMovesThatRaiseThePenalty) {
+    // the first journey is over capacity, taking patient 5 along would shorten the travel time but raise the excess
+    ProblemInstance instance = createInstance(100);
+    instance.numberOfNurses = 2;
+    for (int id = 1; id <= 5; id++) {
+        instance.patientTable[id].demand = 3;
+    }
+    const Genome genome = {{1, 2, 3, 4}, {5}};
+    Genome improved = genome;
+    EXPECT_FALSE(interRouteSearch(improved, instance));
+    EXPECT_EQ(improved, genome);
+    EXPECT_FALSE(orOptSearch(improved, instance, 3, false));
+    EXPECT_EQ(improved, genome);
+}
+
+TEST_F(LocalSearchTestFixture, interRouteSearch_neverLosesPatientsOrFeasibility) {
+    for (unsigned seed = 0; seed < 5; seed++) {
+        ProblemInstance instance = createRandomInstance(30, 5, 400, seed);
+        // deal the patients round robin, which makes long zig zag journeys
+        Genome genome(instance.numberOfNurses);
+        for (int id = 1; id <= 30; id++) {
+            genome[id % instance.numberOfNurses].push_back(id);
+        }
+        const double travelTimeBefore = getTotalTravelTime(genome, instance);
+        const int validJourneysBefore = countValidJourneys(genome, instance);
+        Genome improved = genome;
+        EXPECT_TRUE(interRouteSearch(improved, instance));
+        EXPECT_LT(getTotalTravelTime(improved, instance), travelTimeBefore);
+        EXPECT_GE(countValidJourneys(improved, instance), validJourneysBefore);
+        std::vector<int> patientsBefore = flattenGenome(genome);
+        std::vector<int> patientsAfter = flattenGenome(improved);
+        std::sort(patientsBefore.begin(), patientsBefore.end());
+        std::sort(patientsAfter.begin(), patientsAfter.end());
+        EXPECT_EQ(patientsBefore, patientsAfter);
+    }
+}
+
+TEST_F(LocalSearchTestFixture, interRouteSearch_keepsFeasibleGenomesFeasible) {
+    // tight time windows, the journeys are built in time window order so that all of them are feasible
+    ProblemInstance instance = createRandomInstance(20, 10, 120, 7);
+    std::vector<int> patientsByStartTime;
+    for (int id = 1; id <= 20; id++) {
+        patientsByStartTime.push_back(id);
+    }
+    std::sort(patientsByStartTime.begin(), patientsByStartTime.end(), [&instance](int a, int b) { return instance.patientTable[a].startTime < instance.patientTable[b].startTime; });
+    Genome genome(instance.numberOfNurses);
+    for (std::size_t i = 0; i < patientsByStartTime.size(); i++) {
+        genome[i % instance.numberOfNurses].push_back(patientsByStartTime[i]);
+    }
+    ASSERT_TRUE(isSolutionValid(genome, instance));
+    interRouteSearch(genome, instance);
+    EXPECT_TRUE(isSolutionValid(genome, instance));
+}
+
+TEST_F(LocalSearchTestFixture, buildNeighbourLists_nearestFirst) {
+    ProblemInstance instance = createInstance(100);
+    buildNeighbourLists(instance, 2, false);
+    ASSERT_EQ(instance.neighbours.size(), 6);
+    // ties are broken by the smaller id
+    EXPECT_EQ(instance.neighbours[0], std::vector<int>({1, 5}));
+    EXPECT_EQ(instance.neighbours[3], std::vector<int>({2, 4}));
+    EXPECT_EQ(instance.neighbours[5], std::vector<int>({4, 1}));
+}
+
+TEST_F(LocalSearchTestFixture, buildNeighbourLists_skipsIncompatibleTimeWindows) {
+    // patient 4 has to be done by time 1, every other location is at least 2 away
+    ProblemInstance instance = createInstance(1);
+    buildNeighbourLists(instance, 5, true);
+    EXPECT_EQ(instance.neighbours[3], std::vector<int>({2, 1, 5}));
+    EXPECT_EQ(instance.neighbours[0], std::vector<int>({1, 5, 2, 3}));
+}
+
+TEST_F(LocalSearchTestFixture, granularSearch_matchesQualityOfFullSearch) {
+    for (unsigned seed = 0; seed < 5; seed++) {
+        ProblemInstance instance = createRandomInstance(30, 5, 400, seed);
+        Genome genome(instance.numberOfNurses);
+        for (int id = 1; id <= 30; id++) {
+            genome[id % instance.numberOfNurses].push_back(id);
+        }
+        const double travelTimeBefore = getTotalTravelTime(genome, instance);
+        Genome full = genome;
+        interRouteSearch(full, instance);
+        buildNeighbourLists(instance, 8);
+        Genome granular = genome;
+        EXPECT_TRUE(interRouteSearch(granular, instance));
+        EXPECT_LT(getTotalTravelTime(granular, instance), travelTimeBefore);
+        EXPECT_GE(countValidJourneys(granular, instance), countValidJourneys(genome, instance));
+        // the restricted neighbourhood may end in a different local optimum, but not in a much worse one
+        EXPECT_LT(getTotalTravelTime(granular, instance), 1.25 * getTotalTravelTime(full, instance));
+        // granular 2-opt keeps every journey a permutation of its patients
+        for (Journey &journey : granular) {
+            std::vector<int> patientsBefore = journey;
+            twoOptJourney(journey, instance);
+            std::sort(patientsBefore.begin(), patientsBefore.end());
+            std::vector<int> patientsAfter = journey;
+            std::sort(patientsAfter.begin(), patientsAfter.end());
+            EXPECT_EQ(patientsBefore, patientsAfter);
+        }
+    }
+}
+
+TEST_F(LocalSearchTestFixture, orOptSearch_movesSegmentWithinJourney) {
+    ProblemInstance instance = createInstance(100);
+    // the segment 4, 5 belongs behind patient 3
+    Genome genome = {{1, 4, 5, 2, 3}};
+    EXPECT_TRUE(orOptSearch(genome, instance));
+    EXPECT_DOUBLE_EQ(getTotalTravelTime(genome, instance), 12);
+    EXPECT_TRUE(isSolutionValid(genome, instance));
+}
+
+TEST_F(LocalSearchTestFixture, orOptSearch_movesSegmentBetweenJourneys) {
+    ProblemInstance instance = createInstance(100);
+    instance.numberOfNurses = 2;
+    Genome genome = {{1, 2}, {3, 4, 5}};
+    EXPECT_TRUE(orOptSearch(genome, instance, 3, false));
+    EXPECT_DOUBLE_EQ(getTotalTravelTime(genome, instance), 12);
+}
+
+TEST_F(LocalSearchTestFixture, orOptSearch_neverLosesPatientsOrFeasibility) {
+    for (bool useNeighbourLists : {false, true}) {
+        for (unsigned seed = 0; seed < 5; seed++) {
+            ProblemInstance instance = createRandomInstance(30, 5, 400, seed);
+            buildNeighbourLists(instance, 8);
+            Genome genome(instance.numberOfNurses);
+            for (int id = 1; id <= 30; id++) {
+                genome[id % instance.numberOfNurses].push_back(id);
+            }
+            Genome improved = genome;
+            EXPECT_TRUE(orOptSearch(improved, instance, 3, useNeighbourLists));
+            EXPECT_LT(getTotalTravelTime(improved, instance), getTotalTravelTime(genome, instance));
+            EXPECT_GE(countValidJourneys(improved, instance), countValidJourneys(genome, instance));
+            std::vector<int> patientsBefore = flattenGenome(genome);
+            std::vector<int> patientsAfter = flattenGenome(improved);
+            std::sort(patientsBefore.begin(), patientsBefore.end());
+            std::sort(patientsAfter.begin(), patientsAfter.end());
+            EXPECT_EQ(patientsBefore, patientsAfter);
+        }
+    }
+}
+
+TEST_F(LocalSearchTestFixture, orOptSearch_keepsFeasibleGenomesFeasible) {
+    ProblemInstance instance = createRandomInstance(20, 10, 120, 7);
+    buildNeighbourLists(instance, 8);
+    std::vector<int> patientsByStartTime;
+    for (int id = 1; id <= 20; id++) {
+        patientsByStartTime.push_back(id);
+    }
+    std::sort(patientsByStartTime.begin(), patientsByStartTime.end(), [&instance](int a, int b) { return instance.patientTable[a].startTime < instance.patientTable[b].startTime; });
+    Genome genome(instance.numberOfNurses);
+    for (std::size_t i = 0; i < patientsByStartTime.size(); i++) {
+        genome[i % instance.numberOfNurses].push_back(patientsByStartTime[i]);
+    }
+    ASSERT_TRUE(isSolutionValid(genome, instance));
+    for (bool useNeighbourLists : {false, true}) {
+        Genome improved = genome;
+        orOptSearch(improved, instance, 3, useNeighbourLists);
+        EXPECT_TRUE(isSolutionValid(improved, instance));
+        EXPECT_LE(getTotalTravelTime(improved, instance), getTotalTravelTime(genome, instance));
+    }
+}
+
+TEST_F(LocalSearchTestFixture, parseImprovementStrategy_rejectsUnknownStrategy) {
+    EXPECT_EQ(parseImprovementStrategy("first"), ImprovementStrategy::FirstImprovement);
+    EXPECT_EQ(parseImprovementStrategy("best"), ImprovementStrategy::BestImprovement);
+    EXPECT_THROW(parseImprovementStrategy("random"), std::invalid_argument);
+}
+} // namespace
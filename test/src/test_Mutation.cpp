@@ -492,6 +492,35 @@ TEST_F(MutationTestFixture, twoOpt_oneOptStep) {
     EXPECT_EQ(result, expectedGenome);
 }
 
+TEST_F(MutationTestFixture, moveToNeighbour_standardCase) {
+    ProblemInstance instance = {
+        "test", 2, 10, 0.0, {0, 0, 100},
+        {{1, {1, 1, 0, 100, 0, 0, 0}},
+         {2, {2, 1, 0, 100, 0, 0, 0}},
+         {3, {3, 1, 0, 100, 0, 0, 0}},
+         {4, {4, 1, 0, 100, 0, 0, 0}}},
+        {{0, 1, 2, 3, 4},
+         {1, 0, 1, 2, 3},
+         {2, 1, 0, 1, 2},
+         {3, 2, 1, 0, 1},
+         {4, 3, 2, 1, 0}}
+    };
+    instance.neighbours = {{1}, {2}, {1, 3}, {4}, {3}};
+    Genome genome = {{1, 2},
+                     {3, 4}};
+
+    EXPECT_CALL(mockRng, generateRandomInt(testing::_, testing::_))
+        .WillOnce(testing::Return(0))  // source nurse
+        .WillOnce(testing::Return(1))  // patient index, patient 2
+        .WillOnce(testing::Return(1))  // neighbour index, patient 3
+        .WillOnce(testing::Return(0)); // insert in front of the neighbour
+
+    Genome expectedGenome = {{1},
+                             {2, 3, 4}};
+    Genome result = moveToNeighbour(genome, {{"problem_instance", instance}});
+    EXPECT_EQ(result, expectedGenome);
+}
+
 // Test inversion mutation
 TEST_F(MutationTestFixture, inverseJourney_completeJourney) {
     Genome genome = {{1, 2, 3, 4, 5},
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+#include <thread>
+#include "evaluation.h"
+#include "operatorSelection.h"
+#include "RandomGenerator.h"
+#include "SGA.h"
+#include "structures.h"
+
+namespace {
+// Mutations with a known effect: the first always returns the shortest genome, the second slowly changes nothing
+auto shortestGenome(Genome &, const FunctionParameters &) -> Genome {
+    return {{1, 2, 3, 4}, {}};
+}
+
+auto unchangedGenome(Genome &genome, const FunctionParameters &) -> Genome {
+    // slow enough that a share of an improvement is always worth less per second than the first operator earns
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    return genome;
+}
+
+class OperatorSelectionTestFixture : public ::testing::Test {
+protected:
+    void SetUp() override {
+        RandomGenerator::resetInstance();
+        RandomGenerator::getInstance().setSeed(4);
+    }
+
+    void TearDown() override {
+        RandomGenerator::resetInstance();
+    }
+
+    // four patients on a line to the right of the depot
+    static auto createInstance() -> ProblemInstance {
+        std::unordered_map<int, Patient> patients;
+        for (int id = 1; id <= 4; id++) {
+            patients[id] = {id, 1, 0, 1000, 0, id, 0};
+        }
+        std::vector<std::vector<double>> travelTime(5, std::vector<double>(5));
+        for (int from = 0; from < 5; from++) {
+            for (int to = 0; to < 5; to++) {
+                travelTime[from][to] = std::abs(from - to);
+            }
+        }
+        return {"line", 2, 10, 8.0, {0, 0, 1000}, patients, travelTime};
+    }
+
+    static auto sum(const std::vector<double> &values) -> double {
+        return std::accumulate(values.begin(), values.end(), 0.0);
+    }
+};
+
+TEST_F(OperatorSelectionTestFixture, constructor_startsFromRates) {
+    AdaptiveOperatorSelection selection({1.0, 3.0}, 0.1, 0.5);
+    EXPECT_DOUBLE_EQ(selection.getQualities()[0], 0.25);
+    EXPECT_DOUBLE_EQ(selection.getProbabilities()[0], 0.3);
+    EXPECT_DOUBLE_EQ(selection.getProbabilities()[1], 0.7);
+    EXPECT_EQ(selection.selectOperator(0.0), 0);
+    EXPECT_EQ(selection.selectOperator(0.29), 0);
+    EXPECT_EQ(selection.selectOperator(0.31), 1);
+    EXPECT_EQ(selection.selectOperator(0.999999), 1);
+
+    EXPECT_THROW(AdaptiveOperatorSelection({}, 0.1, 0.5), std::invalid_argument);
+    EXPECT_THROW(AdaptiveOperatorSelection({1.0, 1.0}, 0.5, 0.5), std::invalid_argument);
+    EXPECT_THROW(AdaptiveOperatorSelection({1.0, 1.0}, 0.1, 0.0), std::invalid_argument);
+    EXPECT_THROW(AdaptiveOperatorSelection({0.0, 0.0}, 0.1, 0.5), std::invalid_argument);
+    EXPECT_THROW(AdaptiveOperatorSelection({1.0, -1.0}, 0.1, 0.5), std::invalid_argument);
+}
+
+TEST_F(OperatorSelectionTestFixture, endGeneration_movesProbabilityToImprovingOperators) {
+    AdaptiveOperatorSelection selection({1.0, 1.0, 1.0}, 0.05, 0.5);
+    for (int generation = 0; generation < 30; generation++) {
+        // operator 0 improves by 10 per second, operator 1 by 1 per second and operator 2 is never applied
+        selection.recordApplication(0, 1.0);
+        selection.recordImprovement(0, 10.0);
+        selection.recordApplication(1, 2.0);
+        selection.recordImprovement(1, 2.0);
+        selection.endGeneration();
+        EXPECT_NEAR(sum(selection.getProbabilities()), 1.0, 1e-12);
+    }
+    const std::vector<double> &probabilities = selection.getProbabilities();
+    EXPECT_GT(probabilities[0], probabilities[1]);
+    EXPECT_GE(probabilities[1], 0.05);
+    // the unused operator keeps its quality
+    EXPECT_NEAR(selection.getQualities()[2], 1.0 / 3.0, 1e-12);
+    // the applied operators split their quality 10 : 1
+    EXPECT_NEAR(selection.getQualities()[0] / selection.getQualities()[1], 10.0, 1e-6);
+
+    // a generation without improvement changes nothing
+    const std::vector<double> before = selection.getProbabilities();
+    selection.recordApplication(0, 1.0);
+    selection.recordApplication(1, 1.0);
+    selection.endGeneration();
+    EXPECT_EQ(selection.getProbabilities(), before);
+
+    EXPECT_THROW(selection.setQualities({0.5, 0.5}), std::invalid_argument);
+    selection.setQualities({0.0, 0.0, 1.0});
+    EXPECT_NEAR(selection.getProbabilities()[2], 0.05 + 0.85, 1e-12);
+}
+
+TEST_F(OperatorSelectionTestFixture, applyMutation_creditsTheImprovingOperator) {
+    ProblemInstance instance = createInstance();
+    Population population(10, Individual{{{1, 3}, {2, 4}}});
+    evaluatePopulation(population, instance);
+    FunctionParameters parameters;
+    // an individual can be mutated by both operators, which then share its improvement
+    MuationConfiguration mutation = {{shortestGenome, parameters, 0.5}, {unchangedGenome, parameters, 0.5}};
+    AdaptiveOperatorSelection selection({0.5, 0.5}, 0.05, 0.5);
+
+    Population mutated = applyMutation(population, mutation, instance, &selection);
+    selection.endGeneration();
+    EXPECT_GT(selection.getProbabilities()[0], 0.5);
+    EXPECT_LT(selection.getProbabilities()[1], 0.5);
+    ASSERT_EQ(mutated.size(), 10);
+}
+} // namespace
@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include "crossover.h"
+#include "GridInstance.h"
+#include "mutation.h"
+#include "parentSelection.h"
+#include "populationExport.h"
+#include "RandomGenerator.h"
+#include "SGA.h"
+#include "structures.h"
+#include "survivorSelection.h"
+
+namespace {
+class PopulationExportTestFixture : public ::testing::Test {
+protected:
+    const std::string path = "test_population.export";
+
+    void SetUp() override {
+        RandomGenerator::resetInstance();
+    }
+
+    void TearDown() override {
+        std::remove(path.c_str());
+        RandomGenerator::resetInstance();
+    }
+
+    static auto makeIndividual(Genome genome, double fitness, bool valid) -> Individual {
+        Individual individual = {genome};
+        individual.fitness = fitness;
+        individual.travelTime = -fitness;
+        individual.valid = valid;
+        return individual;
+    }
+
+    // 20 patients on a grid with wide time windows
+    static auto createInstance() -> ProblemInstance {
+        return makeGridInstance("grid \"20\"", 5, 20, 4, 10, 600);
+    }
+};
+
+TEST_F(PopulationExportTestFixture, writeSnapshot_roundTripsInBothFormats) {
+    const Population first = {makeIndividual({{1, 2}, {}, {3}}, -1692.2137, true), makeIndividual({{3, 2, 1}}, -0.1, false)};
+    const Population second = {makeIndividual({{}, {2, 1, 3}}, -12.5, true)};
+    for (PopulationExportFormat format : {PopulationExportFormat::Binary, PopulationExportFormat::JsonLines}) {
+        {
+            PopulationWriter writer(path, format, "train \"9\"");
+            writer.writeSnapshot(5, first);
+            writer.writeSnapshot(10, second);
+        }
+        PopulationExport populationExport = readPopulationExport(path);
+        EXPECT_EQ(populationExport.instanceName, "train \"9\"");
+        ASSERT_EQ(populationExport.snapshots.size(), 2);
+        EXPECT_EQ(populationExport.snapshots[0].generation, 5);
+        EXPECT_EQ(populationExport.snapshots[1].generation, 10);
+        for (std::size_t snapshot = 0; snapshot < 2; snapshot++) {
+            const Population &expected = snapshot == 0 ? first : second;
+            const Population &read = populationExport.snapshots[snapshot].population;
+            ASSERT_EQ(read.size(), expected.size());
+            for (std::size_t index = 0; index < expected.size(); index++) {
+                EXPECT_EQ(read[index].genome, expected[index].genome);
+                EXPECT_EQ(read[index].fitness, expected[index].fitness);
+                EXPECT_EQ(read[index].travelTime, expected[index].travelTime);
+                EXPECT_EQ(read[index].valid, expected[index].valid);
+            }
+        }
+    }
+}
+
+TEST_F(PopulationExportTestFixture, binaryFormat_isCompactAndChecked) {
+    {
+        PopulationWriter writer(path, PopulationExportFormat::Binary, "grid");
+        writer.writeSnapshot(1, {makeIndividual({{1, 2, 3}}, -3.0, true)});
+        EXPECT_THROW(writer.writeSnapshot(2, {makeIndividual({{70000}}, -3.0, true)}), std::runtime_error);
+    }
+    std::string content;
+    {
+        PopulationWriter writer(path, PopulationExportFormat::Binary, "grid");
+        writer.writeSnapshot(1, {makeIndividual({{1, 2, 3}}, -3.0, true)});
+    }
+    {
+        std::ifstream input(path, std::ios::binary);
+        content.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+    }
+    // magic, version and name, then generation, count, fitness, travel time, valid, journeys, length and the three ids
+    EXPECT_EQ(content.size(), 8 + 4 + 4 + 4 + 4 + 4 + 8 + 8 + 1 + 2 + 2 + 3 * 2);
+
+    {
+        std::ofstream output(path, std::ios::binary | std::ios::trunc);
+        output.write(content.data(), static_cast<std::streamsize>(content.size() - 3));
+    }
+    EXPECT_THROW(readPopulationExport(path), std::runtime_error);
+    // the length of the instance name and the number of individuals claim far more than the file holds
+    for (std::size_t offset : {12, 24}) {
+        std::string corrupt = content;
+        const std::uint32_t count = 0xFFFFFFFF;
+        corrupt.replace(offset, sizeof(count), reinterpret_cast<const char *>(&count), sizeof(count));
+        {
+            std::ofstream output(path, std::ios::binary | std::ios::trunc);
+            output.write(corrupt.data(), static_cast<std::streamsize>(corrupt.size()));
+        }
+        EXPECT_THROW(readPopulationExport(path), std::runtime_error) << "count at offset " << offset;
+    }
+    {
+        std::ofstream output(path, std::ios::trunc);
+        output << "generation,fitness\n";
+    }
+    EXPECT_THROW(readPopulationExport(path), std::runtime_error);
+    EXPECT_THROW(readPopulationExport("missing_population.export"), std::runtime_error);
+}
+
+TEST_F(PopulationExportTestFixture, resumedWriter_keepsSnapshotsUpToTheCheckpoint) {
+    for (PopulationExportFormat format : {PopulationExportFormat::Binary, PopulationExportFormat::JsonLines}) {
+        Population first = {makeIndividual({{1, 2}, {3}}, -10.0, true)};
+        Population second = {makeIndividual({{3, 2, 1}, {}}, -8.0, false)};
+        {
+            PopulationWriter writer(path, format, "grid");
+            writer.writeSnapshot(2, first);
+            writer.writeSnapshot(4, first);
+            writer.writeSnapshot(6, first);
+        }
+        {
+            // the checkpoint was written after generation 4, generation 6 is bred again
+            PopulationWriter writer(path, format, "grid", 4);
+            writer.writeSnapshot(6, second);
+        }
+        PopulationExport populationExport = readPopulationExport(path);
+        ASSERT_EQ(populationExport.snapshots.size(), 3);
+        EXPECT_EQ(populationExport.snapshots[0].generation, 2);
+        EXPECT_EQ(populationExport.snapshots[1].generation, 4);
+        EXPECT_EQ(populationExport.snapshots[1].population[0].genome, first[0].genome);
+        EXPECT_EQ(populationExport.snapshots[2].generation, 6);
+        EXPECT_EQ(populationExport.snapshots[2].population[0].genome, second[0].genome);
+
+        EXPECT_THROW(PopulationWriter(path, format, "other", 4), std::runtime_error);
+        const PopulationExportFormat otherFormat = format == PopulationExportFormat::Binary ? PopulationExportFormat::JsonLines : PopulationExportFormat::Binary;
+        EXPECT_THROW(PopulationWriter(path, otherFormat, "grid", 4), std::runtime_error);
+        // the failed attempts leave the export alone
+        EXPECT_EQ(readPopulationExport(path).snapshots.size(), 3);
+
+        std::remove(path.c_str());
+        {
+            PopulationWriter writer(path, format, "grid", 4);
+            writer.writeSnapshot(6, second);
+        }
+        EXPECT_EQ(readPopulationExport(path).snapshots.size(), 1);
+        std::remove(path.c_str());
+    }
+}
+
+TEST_F(PopulationExportTestFixture, SGA_exportsEveryIntervalAndTheLastGeneration) {
+    ProblemInstance instance = createInstance();
+    FunctionParameters emptyParams;
+    FunctionParameters tournamentParams = {{"tournamentSize", 3}, {"tournamentProbability", 0.8}};
+    FunctionParameters elitismParams = {{"elitism_percentage", 0.2}, {"fillFunction", "rouletteWheel"}};
+    RandomGenerator::getInstance().setSeed(11);
+    Config config(20, 5, false, {tournamentSelection, tournamentParams},
+                  {{order1Crossover, 0.5}}, {{reassignOnePatient, emptyParams, 0.2}, {swapBetweenJourneys, emptyParams, 0.2}},
+                  {elitismWithFill, elitismParams});
+    config.printProgress = false;
+    config.populationExportInterval = 2;
+    config.populationExportPath = path;
+    config.populationExportFormat = PopulationExportFormat::JsonLines;
+    Individual best = SGA(instance, config);
+
+    PopulationExport populationExport = readPopulationExport(path);
+    EXPECT_EQ(populationExport.instanceName, instance.instanceName);
+    ASSERT_EQ(populationExport.snapshots.size(), 3);
+    EXPECT_EQ(populationExport.snapshots[0].generation, 2);
+    EXPECT_EQ(populationExport.snapshots[1].generation, 4);
+    EXPECT_EQ(populationExport.snapshots[2].generation, 5);
+    const Population &last = populationExport.snapshots[2].population;
+    ASSERT_EQ(last.size(), 20);
+    EXPECT_TRUE(std::any_of(last.begin(), last.end(), [&best](const Individual &individual) { return individual.genome == best.genome && individual.fitness == best.fitness; }));
+}
+} // namespace
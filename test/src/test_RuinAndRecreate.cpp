@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include "GridInstance.h"
+#include "RandomGenerator.h"
+#include "mutation.h"
+#include "ruinAndRecreate.h"
+#include "structures.h"
+#include "utils.h"
+
+namespace {
+class RuinAndRecreateTestFixture : public ::testing::Test {
+protected:
+    // 24 patients on a grid with wide time windows, dealt round robin to 4 nurses
+    ProblemInstance instance = createInstance();
+    Genome genome = createGenome();
+
+    static auto createInstance() -> ProblemInstance {
+        return makeGridInstance("test", 42, 24, 4, 8, 1000);
+    }
+
+    static auto createGenome() -> Genome {
+        Genome genome(4);
+        for (int id = 1; id <= 24; id++) {
+            genome[id % 4].push_back(id);
+        }
+        return genome;
+    }
+
+    static auto sortedPatients(const Genome &genome) -> std::vector<int> {
+        std::vector<int> patients = flattenGenome(genome);
+        std::sort(patients.begin(), patients.end());
+        return patients;
+    }
+};
+
+TEST_F(RuinAndRecreateTestFixture, removePatients_removesRequestedNumber) {
+    for (RemovalStrategy strategy : {RemovalStrategy::Random, RemovalStrategy::Related, RemovalStrategy::Worst}) {
+        Genome ruined = genome;
+        std::vector<int> removed = removePatients(ruined, instance, strategy, 5);
+        EXPECT_EQ(removed.size(), 5);
+        EXPECT_EQ(flattenGenome(ruined).size(), 19);
+        for (int patient : removed) {
+            for (const Journey &journey : ruined) {
+                EXPECT_EQ(std::count(journey.begin(), journey.end(), patient), 0);
+            }
+        }
+    }
+}
+
+TEST_F(RuinAndRecreateTestFixture, removePatients_routeRemovalEmptiesJourneys) {
+    Genome ruined = genome;
+    std::vector<int> removed = removePatients(ruined, instance, RemovalStrategy::Route, 7);
+    // every journey holds 6 patients, so two journeys are needed
+    EXPECT_EQ(removed.size(), 12);
+    EXPECT_EQ(std::count_if(ruined.begin(), ruined.end(), [](const Journey &journey) { return journey.empty(); }), 2);
+}
+
+TEST_F(RuinAndRecreateTestFixture, regretInsertion_cheapestPlace) {
+    ProblemInstance line = {
+        "line", 2, 10, 0.0, {0, 0, 100},
+        {{1, {1, 1, 0, 100, 0, 1, 0}},
+         {2, {2, 1, 0, 100, 0, 2, 0}},
+         {3, {3, 1, 0, 100, 0, 3, 0}}},
+        {{0, 1, 2, 3},
+         {1, 0, 1, 2},
+         {2, 1, 0, 1},
+         {3, 2, 1, 0}}
+    };
+    Genome partial = {{1, 3}, {}};
+    for (int regret : {1, 2}) {
+        Genome repaired = partial;
+        regretInsertion(repaired, {2}, line, regret);
+        EXPECT_EQ(repaired, Genome({{1, 2, 3}, {}}));
+    }
+}
+
+TEST_F(RuinAndRecreateTestFixture, regretInsertion_usesOnlyFeasiblePlaces) {
+    // the nurse capacity of 8 leaves room for two more patients per journey
+    Genome ruined = genome;
+    std::vector<int> removed = removePatients(ruined, instance, RemovalStrategy::Random, 8);
+    regretInsertion(ruined, removed, instance, 3);
+    EXPECT_EQ(sortedPatients(ruined), sortedPatients(genome));
+    EXPECT_TRUE(isSolutionValid(ruined, instance));
+}
+
+TEST_F(RuinAndRecreateTestFixture, regretInsertion_placesUnfitPatientsAnyway) {
+    ProblemInstance tight = instance;
+    tight.nurseCapacity = 5;
+    Genome ruined = {{1, 2, 3, 4, 5}, {6, 7, 8, 9, 10}, {11, 12, 13, 14, 15}, {16, 17, 18, 19, 20}};
+    regretInsertion(ruined, {21, 22, 23, 24}, tight, 2);
+    EXPECT_EQ(flattenGenome(ruined).size(), 24);
+}
+
+TEST_F(RuinAndRecreateTestFixture, ruinAndRecreate_keepsAllPatients) {
+    for (const std::string strategy : {"random", "related", "worst", "route", "mixed"}) {
+        Genome mutated = genome;
+        mutated = ruinAndRecreate(mutated, {{"problem_instance", instance}, {"removal_strategy", strategy}, {"removal_fraction", 0.25}});
+        EXPECT_EQ(sortedPatients(mutated), sortedPatients(genome)) << strategy;
+        EXPECT_EQ(mutated.size(), genome.size());
+    }
+}
+
+TEST_F(RuinAndRecreateTestFixture, parseRemovalStrategy_rejectsUnknownStrategy) {
+    EXPECT_EQ(parseRemovalStrategy("related"), RemovalStrategy::Related);
+    EXPECT_THROW(parseRemovalStrategy("shaw"), std::invalid_argument);
+}
+} // namespace
@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include "statistics.h"
+#include "structures.h"
+
+namespace {
+class StatisticsTestFixture : public ::testing::Test {
+protected:
+    auto makeIndividual(Genome genome, double fitness, double travelTime, bool valid) -> Individual {
+        Individual individual = {genome};
+        individual.fitness = fitness;
+        individual.travelTime = travelTime;
+        individual.valid = valid;
+        return individual;
+    }
+};
+
+TEST_F(StatisticsTestFixture, computeGenerationStatistics_standardCase) {
+    Population population = {
+        makeIndividual({{1, 2}, {}}, -4.0, 4.0, true),
+        makeIndividual({{1}, {2}}, -6.0, 6.0, true),
+        makeIndividual({{1, 2}, {}}, -4.0, 4.0, true),
+        makeIndividual({{1}}, -2.0, 2.0, false) // patient 2 is missing
+    };
+
+    GenerationStatistics statistics = computeGenerationStatistics(population);
+    EXPECT_EQ(statistics.validSolutions, 3);
+    EXPECT_DOUBLE_EQ(statistics.percentageValid, 75.0);
+    EXPECT_DOUBLE_EQ(statistics.bestFitness, -2.0);
+    EXPECT_DOUBLE_EQ(statistics.worstFitness, -6.0);
+    EXPECT_DOUBLE_EQ(statistics.averageFitness, -4.0);
+    EXPECT_NEAR(statistics.fitnessStandardDeviation, std::sqrt(2.0), 1e-12);
+    EXPECT_EQ(statistics.fittestIndex, 3);
+    EXPECT_DOUBLE_EQ(statistics.bestTravelTime, 2.0);
+    EXPECT_DOUBLE_EQ(statistics.worstTravelTime, 6.0);
+    EXPECT_EQ(statistics.fastestIndex, 3);
+    EXPECT_EQ(statistics.uniqueGenomes, 3);
+    // the population order is left untouched
+    EXPECT_EQ(population[1].genome, Genome({{1}, {2}}));
+}
+
+TEST_F(StatisticsTestFixture, computeGenerationStatistics_parallelMatchesSequential) {
+    Population population;
+    for (int i = 0; i < 37; i++) {
+        population.push_back(makeIndividual(i % 2 == 0 ? Genome{{1, 2}, {}} : Genome{{2}, {1}}, -i * 1.5, i * 0.5, i % 3 == 0));
+    }
+
+    GenerationStatistics sequential = computeGenerationStatistics(population, 1);
+    GenerationStatistics parallel = computeGenerationStatistics(population, 4);
+    EXPECT_EQ(parallel.validSolutions, sequential.validSolutions);
+    EXPECT_DOUBLE_EQ(parallel.averageFitness, sequential.averageFitness);
+    EXPECT_NEAR(parallel.fitnessStandardDeviation, sequential.fitnessStandardDeviation, 1e-9);
+    EXPECT_DOUBLE_EQ(parallel.averageTravelTime, sequential.averageTravelTime);
+    EXPECT_EQ(parallel.fittestIndex, sequential.fittestIndex);
+    EXPECT_EQ(parallel.fastestIndex, sequential.fastestIndex);
+    EXPECT_EQ(parallel.uniqueGenomes, 2);
+}
+} // namespace
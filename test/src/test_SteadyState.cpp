@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include "crossover.h"
+#include "evaluation.h"
+#include "GridInstance.h"
+#include "mutation.h"
+#include "parentSelection.h"
+#include "RandomGenerator.h"
+#include "SGA.h"
+#include "steadyState.h"
+#include "structures.h"
+#include "survivorSelection.h"
+
+namespace {
+auto shortestGenome(Genome &, const FunctionParameters &) -> Genome {
+    return {{1, 2, 3, 4}, {}};
+}
+
+class SteadyStateTestFixture : public ::testing::Test {
+protected:
+    FunctionParameters emptyParams;
+    FunctionParameters tournamentParams = {{"tournamentSize", 3}, {"tournamentProbability", 0.8}};
+    FunctionParameters elitismParams = {{"elitism_percentage", 0.2}, {"fillFunction", "rouletteWheel"}};
+
+    void SetUp() override {
+        RandomGenerator::resetInstance();
+        RandomGenerator::getInstance().setSeed(8);
+    }
+
+    void TearDown() override {
+        RandomGenerator::resetInstance();
+    }
+
+    static auto makeIndividual(Genome genome, double fitness) -> Individual {
+        Individual individual = {genome};
+        individual.fitness = fitness;
+        return individual;
+    }
+
+    // four patients on a line to the right of the depot
+    static auto createLineInstance() -> ProblemInstance {
+        std::unordered_map<int, Patient> patients;
+        for (int id = 1; id <= 4; id++) {
+            patients[id] = {id, 1, 0, 1000, 0, id, 0};
+        }
+        std::vector<std::vector<double>> travelTime(5, std::vector<double>(5));
+        for (int from = 0; from < 5; from++) {
+            for (int to = 0; to < 5; to++) {
+                travelTime[from][to] = std::abs(from - to);
+            }
+        }
+        return {"line", 2, 10, 8.0, {0, 0, 1000}, patients, travelTime};
+    }
+
+    // 20 patients on a grid with wide time windows
+    static auto createGridInstance() -> ProblemInstance {
+        return makeGridInstance("grid", 5, 20, 4, 10, 600);
+    }
+};
+
+TEST_F(SteadyStateTestFixture, insertOffspring_worstReplacesLeastFitIfFitter) {
+    Population population = {makeIndividual({{1}}, -10.0), makeIndividual({{2}}, -5.0), makeIndividual({{3}}, -20.0)};
+    Offspring offspring = {{makeIndividual({{4}}, -8.0)}, {0}};
+    EXPECT_EQ(insertOffspring(population, offspring, ReplacementStrategy::Worst), 1);
+    EXPECT_EQ(population[2].genome, (Genome{{4}}));
+
+    offspring.children[0] = makeIndividual({{5}}, -30.0);
+    EXPECT_EQ(insertOffspring(population, offspring, ReplacementStrategy::Worst), 0);
+    EXPECT_EQ(population.size(), 3);
+
+    // a copy of an individual with its journeys in another order is a duplicate
+    population = {makeIndividual({{1}, {2, 3}}, -5.0), makeIndividual({{3}}, -20.0)};
+    offspring.children[0] = makeIndividual({{2, 3}, {1}}, -5.0);
+    EXPECT_EQ(insertOffspring(population, offspring, ReplacementStrategy::Worst), 0);
+}
+
+TEST_F(SteadyStateTestFixture, insertOffspring_randomKeepsTheFittest) {
+    Population population = {makeIndividual({{1}}, -10.0), makeIndividual({{2}}, -5.0), makeIndividual({{3}}, -20.0)};
+    Offspring offspring = {{makeIndividual({{4}}, -100.0)}, {0}};
+    for (int step = 0; step < 20; step++) {
+        EXPECT_EQ(insertOffspring(population, offspring, ReplacementStrategy::Random), 1);
+        EXPECT_EQ(population[1].genome, (Genome{{2}}));
+    }
+}
+
+TEST_F(SteadyStateTestFixture, insertOffspring_crowdingReplacesTheCloserParent) {
+    Population population = {makeIndividual({{1, 2, 3, 4}}, -10.0), makeIndividual({{4, 3}, {2, 1}}, -10.0), makeIndividual({{1}, {2, 3, 4}}, -1.0)};
+    // the first child resembles the second parent and the other way round
+    Offspring offspring = {{makeIndividual({{3, 4}, {1, 2}}, -5.0), makeIndividual({{1, 2, 4, 3}}, -50.0)}, {0, 1}};
+    EXPECT_EQ(insertOffspring(population, offspring, ReplacementStrategy::Crowding), 1);
+    EXPECT_EQ(population[1].genome, (Genome{{3, 4}, {1, 2}}));
+    EXPECT_EQ(population[0].genome, (Genome{{1, 2, 3, 4}}));
+    EXPECT_EQ(population[2].fitness, -1.0);
+}
+
+TEST_F(SteadyStateTestFixture, breedOffspring_dropsCopiesAndEvaluatesChildren) {
+    ProblemInstance instance = createLineInstance();
+    Population population = {makeIndividual({{1, 3}, {2, 4}}, 0.0), makeIndividual({{4, 3, 2, 1}, {}}, 0.0)};
+    evaluatePopulation(population, instance);
+    Config unchanged(2, 1, false, {tournamentSelection, tournamentParams}, {}, {}, {elitismWithFill, elitismParams});
+    EXPECT_TRUE(breedOffspring(population, 0, 1, unchanged, instance).children.empty());
+
+    MuationConfiguration mutation = {{shortestGenome, emptyParams, 1.0}};
+    Config config(2, 1, false, {tournamentSelection, tournamentParams}, {}, mutation, {elitismWithFill, elitismParams});
+    Offspring offspring = breedOffspring(population, 0, 1, config, instance);
+    ASSERT_EQ(offspring.children.size(), 2);
+    EXPECT_EQ(offspring.parents, (std::vector<std::size_t>{0, 1}));
+    EXPECT_EQ(offspring.children[0].genome, (Genome{{1, 2, 3, 4}, {}}));
+    EXPECT_DOUBLE_EQ(offspring.children[0].travelTime, 8.0);
+    EXPECT_TRUE(offspring.children[0].valid);
+}
+
+TEST_F(SteadyStateTestFixture, SGA_steadyStateImprovesAndIsReproducible) {
+    ProblemInstance instance = createGridInstance();
+    auto run = [&](ReplacementStrategy strategy) {
+        RandomGenerator::resetInstance();
+        RandomGenerator::getInstance().setSeed(21);
+        Config config(20, 10, false, {tournamentSelection, tournamentParams}, {{order1Crossover, 0.5}},
+                      {{reassignOnePatient, emptyParams, 0.2}, {swapBetweenJourneys, emptyParams, 0.2}}, {elitismWithFill, elitismParams});
+        config.steadyState = true;
+        config.steadyStateReplacement = strategy;
+        config.printProgress = false;
+        return SGA(instance, config);
+    };
+    RandomGenerator::resetInstance();
+    RandomGenerator::getInstance().setSeed(21);
+    Config initialConfig(20, 0, false, {tournamentSelection, tournamentParams}, {}, {}, {elitismWithFill, elitismParams});
+    Population initial = initializeFeasiblePopulation(instance, initialConfig);
+    const double initialBest = std::max_element(initial.begin(), initial.end(), [](const Individual &a, const Individual &b) { return a.fitness < b.fitness; })->fitness;
+
+    for (ReplacementStrategy strategy : {ReplacementStrategy::Worst, ReplacementStrategy::Random, ReplacementStrategy::Crowding}) {
+        Individual first = run(strategy);
+        Individual second = run(strategy);
+        EXPECT_EQ(first.genome, second.genome);
+        EXPECT_GE(first.fitness, initialBest);
+    }
+}
+} // namespace
@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <future>
+#include <random>
+#include "configLoader.h"
+#include "tuner.h"
+
+using json = nlohmann::json;
+
+namespace {
+class TunerTestFixture : public ::testing::Test {
+protected:
+    json settingsJson = json::parse(R"({
+        "baseConfiguration": {
+            "instance": "train_0.json",
+            "populationSize": 20,
+            "generations": 2,
+            "parentSelection": {"name": "tournamentSelection", "tournamentSize": 3, "tournamentProbability": 0.8},
+            "mutations": [{"name": "reassignOnePatient", "probability": 0.2}],
+            "survivorSelection": {"name": "elitismWithFill", "elitism_percentage": 0.1, "fillFunction": "rouletteWheel"}
+        },
+        "instances": ["train_0.json", "train_1.json"],
+        "seeds": [1, 2, 3, 4, 5, 6],
+        "numberOfCandidates": 6,
+        "firstTest": 3,
+        "budget": 100,
+        "numberOfThreads": 3,
+        "parameters": [
+            {"path": "/populationSize", "type": "int", "min": 10, "max": 100},
+            {"path": "/mutations/0/probability", "type": "double", "min": 0.0, "max": 1.0}
+        ]
+    })");
+};
+
+TEST_F(TunerTestFixture, quantiles_matchTables) {
+    EXPECT_NEAR(normalQuantile(0.975), 1.95996, 1e-4);
+    EXPECT_NEAR(normalQuantile(0.5), 0.0, 1e-9);
+    // Wilson-Hilferty is within about 1% for few degrees of freedom
+    EXPECT_NEAR(chiSquareQuantile(0.95, 3), 7.815, 0.08);
+    EXPECT_NEAR(chiSquareQuantile(0.95, 15), 24.996, 0.05);
+    EXPECT_NEAR(studentTQuantile(0.975, 20), 2.086, 0.005);
+    EXPECT_NEAR(studentTQuantile(0.975, 100), 1.984, 0.005);
+    EXPECT_THROW(normalQuantile(1.0), std::invalid_argument);
+}
+
+TEST_F(TunerTestFixture, rankBlock_sharesRanksOfTies) {
+    std::vector<double> ranks = rankBlock({-10.0, -5.0, -10.0, -1.0});
+    EXPECT_EQ(ranks, (std::vector<double>{3.5, 2.0, 3.5, 1.0}));
+}
+
+TEST_F(TunerTestFixture, friedmanSurvivors_eliminatesDominatedCandidates) {
+    // candidate 0 is always best, 3 always worst, 1 and 2 swap
+    std::vector<std::vector<double>> ranks;
+    for (int block = 0; block < 8; block++) {
+        ranks.push_back(block % 2 == 0 ? std::vector<double>{1, 2, 3, 4} : std::vector<double>{1, 3, 2, 4});
+    }
+    std::vector<bool> survivors = friedmanSurvivors(ranks);
+    EXPECT_TRUE(survivors[0]);
+    EXPECT_FALSE(survivors[3]);
+
+    // no difference between the candidates
+    std::vector<std::vector<double>> ties(8, std::vector<double>{2, 2, 2});
+    EXPECT_EQ(friedmanSurvivors(ties), std::vector<bool>(3, true));
+    // too few blocks to decide
+    EXPECT_EQ(friedmanSurvivors({{1, 2, 3}}), std::vector<bool>(3, true));
+}
+
+TEST_F(TunerTestFixture, readTuningSettings_validates) {
+    TuningSettings settings = readTuningSettings(settingsJson);
+    EXPECT_EQ(settings.instances.size(), 2);
+    EXPECT_EQ(settings.seeds.size(), 6);
+    ASSERT_EQ(settings.parameters.size(), 2);
+    EXPECT_EQ(settings.parameters[0].type, ParameterType::Int);
+    EXPECT_EQ(settings.outputPath, "tuned_config.json");
+
+    auto expectRejected = [this](const json &patch) {
+        json invalid = settingsJson;
+        invalid.merge_patch(patch);
+        EXPECT_THROW(readTuningSettings(invalid), std::invalid_argument) << patch.dump();
+    };
+    expectRejected({{"unknownKey", 1}});
+    expectRejected({{"seeds", {-1}}});
+    expectRejected({{"instances", json::array()}});
+    expectRejected({{"budget", 0}});
+    expectRejected({{"parameters", {{{"path", "/notThere"}, {"type", "int"}, {"min", 1}, {"max", 2}}}}});
+    expectRejected({{"parameters", {{{"path", "/populationSize"}, {"type", "bool"}, {"min", 1}, {"max", 2}}}}});
+    expectRejected({{"parameters", {{{"path", "/populationSize"}, {"type", "int"}, {"min", 5}, {"max", 2}}}}});
+}
+
+TEST_F(TunerTestFixture, sampleCandidates_keepsBaseAndRanges) {
+    TuningSettings settings = readTuningSettings(settingsJson);
+    std::mt19937_64 engine(3);
+    std::vector<json> candidates = sampleCandidates(settings, engine);
+    ASSERT_EQ(candidates.size(), 6);
+    EXPECT_EQ(candidates[0], settings.baseConfiguration);
+    for (const json &candidate : candidates) {
+        EXPECT_TRUE(candidate.at("populationSize").is_number_integer());
+        EXPECT_GE(candidate.at("populationSize").get<int>(), 10);
+        EXPECT_LE(candidate.at("populationSize").get<int>(), 100);
+        EXPECT_GE(candidate.at("mutations").at(0).at("probability").get<double>(), 0.0);
+        EXPECT_LE(candidate.at("mutations").at(0).at("probability").get<double>(), 1.0);
+        EXPECT_EQ(candidate.at("generations"), 2);
+    }
+}
+
+TEST_F(TunerTestFixture, race_findsBestCandidateWithinBudget) {
+    TuningSettings settings = readTuningSettings(settingsJson);
+    std::mt19937_64 engine(3);
+    std::vector<json> candidates = sampleCandidates(settings, engine);
+    // a larger population is better, the seed adds noise that is smaller than most differences
+    RunEvaluator evaluate = [](const json &configuration, const std::string &, unsigned int seed) -> double {
+        return configuration.at("populationSize").get<double>() + std::sin(seed) * 5.0;
+    };
+    RaceResult result = race(settings, candidates, evaluate);
+    std::size_t largest = 0;
+    for (std::size_t candidate = 0; candidate < candidates.size(); candidate++) {
+        if (candidates[candidate].at("populationSize").get<int>() > candidates[largest].at("populationSize").get<int>()) {
+            largest = candidate;
+        }
+    }
+    EXPECT_EQ(result.bestCandidate, largest);
+    EXPECT_TRUE(result.alive[largest]);
+    EXPECT_LE(result.runs, settings.budget);
+    // the race stops once one candidate is left, before all 12 blocks are run
+    EXPECT_EQ(std::count(result.alive.begin(), result.alive.end(), true), 1);
+    EXPECT_LT(result.blocks, 12);
+
+    settings.budget = 10;
+    RaceResult limited = race(settings, candidates, evaluate);
+    EXPECT_EQ(limited.blocks, 1);
+    EXPECT_EQ(limited.runs, 6);
+}
+
+TEST_F(TunerTestFixture, race_rethrowsFailedRuns) {
+    TuningSettings settings = readTuningSettings(settingsJson);
+    std::mt19937_64 engine(3);
+    RunEvaluator failing = [](const json &, const std::string &, unsigned int) -> double {
+        throw std::runtime_error("run failed");
+    };
+    EXPECT_THROW(race(settings, sampleCandidates(settings, engine), failing), std::runtime_error);
+}
+
+TEST_F(TunerTestFixture, tune_rejectsOutOfRangeCandidatesBeforeRacing) {
+    settingsJson["parameters"].push_back({{"path", "/parentSelection/tournamentProbability"}, {"type", "double"}, {"min", 1.5}, {"max", 2.0}});
+    TuningSettings settings = readTuningSettings(settingsJson);
+    settings.outputPath = "tune_rejectsOutOfRangeCandidates.json";
+    EXPECT_THROW(tune(settings), std::invalid_argument);
+}
+
+TEST_F(TunerTestFixture, SGAEvaluator_isReproducibleOnParallelThreads) {
+    RunEvaluator evaluate = makeSGAEvaluator();
+    const json configuration = settingsJson.at("baseConfiguration");
+    auto first = std::async(std::launch::async, [&]() { return evaluate(configuration, "train_0.json", 9); });
+    auto second = std::async(std::launch::async, [&]() { return evaluate(configuration, "train_0.json", 9); });
+    const double fitness = first.get();
+    EXPECT_EQ(fitness, second.get());
+    EXPECT_LT(fitness, 0.0);
+}
+} // namespace
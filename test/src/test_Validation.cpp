@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include "utils.h"
+#include "structures.h"
+
+namespace {
+class ValidationTestFixture : public ::testing::Test {
+protected:
+    // patient 3 has to be cared for until time 10, the nurse has to be back at time 20
+    ProblemInstance instance = {
+        "test", // instanceName
+        2, // numberOfNurses
+        3, // nurseCapacity
+        0.0, // benchmark
+        {0, 0, 20}, // depot
+        {{1, {1, 1, 0, 100, 1, 1, 0}},
+         {2, {2, 1, 0, 100, 1, 2, 0}},
+         {3, {3, 2, 0, 10, 1, 3, 0}}},
+        {{0, 1, 2, 3},
+         {1, 0, 1, 2},
+         {2, 1, 0, 1},
+         {3, 2, 1, 0}}
+    };
+};
+
+TEST_F(ValidationTestFixture, validateSolution_validSolution) {
+    Genome genome = {{3, 1}, {2}};
+    SolutionValidation validation = validateSolution(genome, instance);
+    EXPECT_TRUE(validation.valid);
+    EXPECT_EQ(validation.invalidJourneys, 0);
+    EXPECT_TRUE(isSolutionValid(genome, instance));
+}
+
+TEST_F(ValidationTestFixture, validateSolution_duplicateAndMissingPatients) {
+    Genome genome = {{1, 2}, {1}};
+    SolutionValidation validation = validateSolution(genome, instance);
+    EXPECT_FALSE(validation.valid);
+    EXPECT_EQ(validation.duplicateVisits, 1);
+    EXPECT_EQ(validation.missingPatients, 1);
+    EXPECT_EQ(validation.unknownPatients, 0);
+}
+
+TEST_F(ValidationTestFixture, validateSolution_unknownPatient) {
+    Genome genome = {{1, 2}, {3, 7}};
+    SolutionValidation validation = validateSolution(genome, instance);
+    EXPECT_FALSE(validation.valid);
+    EXPECT_EQ(validation.unknownPatients, 1);
+    EXPECT_EQ(validation.missingPatients, 0);
+}
+
+TEST_F(ValidationTestFixture, validateSolution_capacityExceeded) {
+    // demand 1 + 1 + 2 > 3
+    Genome genome = {{3, 1, 2}, {}};
+    SolutionValidation validation = validateSolution(genome, instance);
+    EXPECT_FALSE(validation.valid);
+    EXPECT_EQ(validation.invalidJourneys, 1);
+    EXPECT_EQ(validation.firstInvalidJourney, 0);
+}
+
+TEST_F(ValidationTestFixture, isJourneyValid_timeWindowAndReturnTime) {
+    EXPECT_TRUE(isJourneyValid({3, 2}, instance));
+    // patient 3 is reached at time 4 and finished at 5, still within its time window
+    EXPECT_TRUE(isJourneyValid({1, 3}, instance));
+    // patient 3 is reached at time 11 and finished at 12, after its time window
+    EXPECT_FALSE(isJourneyValid({2, 1, 3}, ProblemInstance("late", 1, 10, 0.0, {0, 0, 100}, {{1, {1, 0, 8, 100, 1, 0, 0}}, {2, {2, 0, 0, 100, 1, 0, 0}}, {3, {3, 0, 0, 10, 1, 0, 0}}}, instance.travelTime)));
+    // the way back to the depot is part of the journey
+    ProblemInstance lateReturn = instance;
+    lateReturn.depot.returnTime = 6;
+    EXPECT_FALSE(isJourneyValid({1, 3}, lateReturn));
+    EXPECT_TRUE(isJourneyValid({}, lateReturn));
+}
+} // namespace